@@ -97,4 +97,21 @@ typedef void (^AMCompletionBlock)(BOOL finished);
  */
 - (void)cancelAnimation;
 
+/// -----------------------
+/// @name Seeking Animation
+/// -----------------------
+
+@optional
+
+/*!
+ Tells the receiver to set the animated values to their state at a specific time - without the animation running. Use this for scrubbing or gesture driven animations on animations that have been postponed.
+ 
+ @param time The time since the animation would begin - including its delay. Times before the delay applies the start value and times after the end applies the end value.
+ 
+ @discussion Implemented by all animations of Animeteor. Animation groups skip animations that do not implement it.
+ 
+ Direct animations seek through their setter block or typed setter without allocating - seeking through key value coding boxes the value. Layer animations attach their animations on the first seek and then only move the time offset of the layer.
+ */
+- (void)seekToTime:(NSTimeInterval)time;
+
 @end
@@ -0,0 +1,171 @@
+//
+//  AMAnimationBatch.h
+//  Animeteor
+//
+//  Copyright (c) 2013-2015, Kristian Trenskow
+//  All rights reserved.
+//  
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are met:
+//  
+//  1. Redistributions of source code must retain the above copyright notice,
+//  this list of conditions and the following disclaimer.
+//  
+//  2. Redistributions in binary form must reproduce the above copyright notice,
+//  this list of conditions and the following disclaimer in the documentation
+//  and/or other materials provided with the distribution.
+//  
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+//  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+//  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+//  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+//  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+//  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+//  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+//  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+//  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+//  POSSIBILITY OF SUCH DAMAGE.
+//
+
+@import Foundation;
+
+#import "AMAnimation.h"
+
+@class AMAnimationBatch;
+@class AMCurve;
+@class AMFrameTicker;
+
+/*!
+ A prototype of a block that applies the values of a batch to its targets.
+ 
+ @param batch  The batch being stepped.
+ @param values The values of all animations in the batch - `componentCount` consecutive values per animation.
+ @param range  The range of animations whose values were updated.
+ */
+typedef void (^AMAnimationBatchApplier)(AMAnimationBatch * _Nonnull batch, const double * _Nonnull values, NSRange range);
+
+/*!
+ A prototype of a block that gets called when animations in a batch complete.
+ 
+ @param batch     The batch being stepped.
+ @param completed A bitmask with a bit set for each animation that completed in this step - bit `i % 64` of word `i / 64` for animation `i`.
+ @param range     The range of animations covered by the bits set.
+ */
+typedef void (^AMAnimationBatchCompletionBlock)(AMAnimationBatch * _Nonnull batch, const uint64_t * _Nonnull completed, NSRange range);
+
+/*!
+ The `AMAnimationBatch` class animates a large number of values - like thousands of particles - as a single object. Start times, durations, values and curves are stored in contiguous arrays and advanced in one pass per frame, with animations sharing a curve evaluated together. Values are applied to their targets by a single applier block, and completion is reported as a bitmask.
+ 
+ Animations using the same curve should be added consecutively - consecutive animations with the same curve are evaluated as one run.
+ */
+@interface AMAnimationBatch : NSObject
+
+/// ----------------------
+/// @name Creating a Batch
+/// ----------------------
+
++ (instancetype _Nullable)new UNAVAILABLE_ATTRIBUTE;
+- (instancetype _Nullable)init UNAVAILABLE_ATTRIBUTE;
+
+/*!
+ Returns an initialized animation batch.
+ 
+ @param componentCount The number of values of each animation - like one for opacity or two for a position.
+ @param applier        The block that applies values to the targets.
+ 
+ @return An initialized animation batch.
+ */
+- (instancetype _Nonnull)initWithComponentCount:(NSUInteger)componentCount applier:(AMAnimationBatchApplier _Nonnull)applier;
+
+/// -----------------------
+/// @name Adding Animations
+/// -----------------------
+
+/*!
+ Adds an animation to the batch. Animations added after the batch has begun begin relative to the current time.
+ 
+ @param fromValues `componentCount` values to animate from.
+ @param toValues   `componentCount` values to animate to.
+ @param duration   The duration of the animation.
+ @param delay      The delay before the animation begins.
+ @param curve      The curve of the animation. Providing `nil` will default to a linear curve.
+ 
+ @return The index of the animation in the batch.
+ */
+- (NSUInteger)addAnimationFromValues:(const double * _Nonnull)fromValues
+                            toValues:(const double * _Nonnull)toValues
+                            duration:(NSTimeInterval)duration
+                               delay:(NSTimeInterval)delay
+                               curve:(AMCurve * _Nullable)curve;
+
+/// -------------------------------
+/// @name Getting Batch Information
+/// -------------------------------
+
+/*!
+ Returns the number of values of each animation.
+ */
+@property (nonatomic,readonly) NSUInteger componentCount;
+
+/*!
+ Returns the number of animations in the batch.
+ */
+@property (nonatomic,readonly) NSUInteger count;
+
+/*!
+ Returns the current values of all animations - `componentCount` consecutive values per animation.
+ */
+@property (nonatomic,readonly,nonnull) const double *values;
+
+/*!
+ Returns `YES` if the batch is currently in progress.
+ */
+@property (nonatomic,readonly,getter = isAnimating) BOOL animating;
+
+/*!
+ Returns `YES` if all animations in the batch have completed or the batch was cancelled.
+ */
+@property (nonatomic,readonly,getter = isComplete) BOOL complete;
+
+/*!
+ Returns `YES` if the animation at an index has completed.
+ 
+ @param index The index of the animation.
+ */
+- (BOOL)isAnimationCompleteAtIndex:(NSUInteger)index;
+
+/// -----------------------
+/// @name Configuring Batch
+/// -----------------------
+
+/*!
+ The ticker that steps the batch. Default is the shared ticker. Providing `nil` will reset it to the shared ticker.
+ */
+@property (nonatomic,null_resettable) AMFrameTicker *ticker;
+
+/*!
+ An optional block that gets called once per step in which animations completed.
+ */
+@property (nonatomic,copy,nullable) AMAnimationBatchCompletionBlock animationsCompletion;
+
+/*!
+ An optional block that gets called when all animations have completed or the batch is cancelled.
+ */
+@property (nonatomic,copy,nullable) AMCompletionBlock completion;
+
+/// --------------------
+/// @name Managing Batch
+/// --------------------
+
+/*!
+ Begins the batch.
+ */
+- (void)beginAnimation;
+
+/*!
+ Cancels the batch. The values stay at their current positions and the completion block is invoked.
+ */
+- (void)cancelAnimation;
+
+@end
@@ -0,0 +1,347 @@
+//
+//  AMAnimationBatch.m
+//  Animeteor
+//
+//  Copyright (c) 2013-2015, Kristian Trenskow
+//  All rights reserved.
+//  
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are met:
+//  
+//  1. Redistributions of source code must retain the above copyright notice,
+//  this list of conditions and the following disclaimer.
+//  
+//  2. Redistributions in binary form must reproduce the above copyright notice,
+//  this list of conditions and the following disclaimer in the documentation
+//  and/or other materials provided with the distribution.
+//  
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+//  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+//  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+//  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+//  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+//  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+//  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+//  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+//  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+//  POSSIBILITY OF SUCH DAMAGE.
+//
+
+#import "AMMacros.h"
+
+#import "AMCurve.h"
+#import "AMFrameTicker.h"
+
+#import "AMAnimationBatch.h"
+
+/* Consecutive animations sharing a curve. */
+typedef struct {
+    NSUInteger start;
+    NSUInteger length;
+    AMCurveFunction function;
+} AMAnimationBatchRun;
+
+@interface AMAnimationBatch () <AMFrameTickerClient> {
+    NSUInteger _capacity;
+    double *_beginTimes;
+    double *_inverseDurations;
+    double *_fromValues;
+    double *_deltaValues;
+    double *_progress;
+    double *_positions;
+    double *_values;
+    uint64_t *_completed;
+    uint64_t *_newlyCompleted;
+    AMAnimationBatchRun *_runs;
+    NSUInteger _runCount;
+    NSUInteger _runCapacity;
+    NSMutableArray *_runCurves;
+    /* Animations outside this range have all completed. */
+    NSUInteger _activeStart;
+    NSUInteger _activeEnd;
+    NSUInteger _remaining;
+}
+
+@property (nonatomic,copy) AMAnimationBatchApplier applier;
+@property (nonatomic,readwrite,getter = isAnimating) BOOL animating;
+@property (nonatomic,readwrite,getter = isComplete) BOOL complete;
+
+@end
+
+@implementation AMAnimationBatch
+
+#pragma mark - Setup / Teardown
+
+- (instancetype)initWithComponentCount:(NSUInteger)componentCount applier:(AMAnimationBatchApplier)applier {
+    
+    AMAssertMainThread();
+    NSParameterAssert(componentCount > 0);
+    
+    if ((self = [super init])) {
+        
+        _componentCount = componentCount;
+        _applier = [applier copy];
+        _runCurves = [[NSMutableArray alloc] init];
+        _ticker = [AMFrameTicker sharedTicker];
+        
+    }
+    
+    return self;
+    
+}
+
+- (void)dealloc {
+    
+    free(_beginTimes);
+    free(_inverseDurations);
+    free(_fromValues);
+    free(_deltaValues);
+    free(_progress);
+    free(_positions);
+    free(_values);
+    free(_completed);
+    free(_newlyCompleted);
+    free(_runs);
+    
+}
+
+#pragma mark - Internals
+
+- (void)ensureCapacity:(NSUInteger)capacity {
+    
+    if (capacity <= _capacity)
+        return;
+    
+    NSUInteger oldWords = (_capacity + 63) / 64;
+    
+    _capacity = MAX(capacity, MAX(_capacity * 2, (NSUInteger)64));
+    
+    NSUInteger words = (_capacity + 63) / 64;
+    
+    _beginTimes = realloc(_beginTimes, sizeof(double) * _capacity);
+    _inverseDurations = realloc(_inverseDurations, sizeof(double) * _capacity);
+    _fromValues = realloc(_fromValues, sizeof(double) * _capacity * _componentCount);
+    _deltaValues = realloc(_deltaValues, sizeof(double) * _capacity * _componentCount);
+    _progress = realloc(_progress, sizeof(double) * _capacity);
+    _positions = realloc(_positions, sizeof(double) * _capacity);
+    _values = realloc(_values, sizeof(double) * _capacity * _componentCount);
+    _completed = realloc(_completed, sizeof(uint64_t) * words);
+    _newlyCompleted = realloc(_newlyCompleted, sizeof(uint64_t) * words);
+    
+    memset(_completed + oldWords, 0, sizeof(uint64_t) * (words - oldWords));
+    memset(_newlyCompleted + oldWords, 0, sizeof(uint64_t) * (words - oldWords));
+    
+}
+
+- (void)stepToTime:(CFTimeInterval)time {
+    
+    NSUInteger start = _activeStart;
+    NSUInteger end = _activeEnd;
+    NSUInteger components = _componentCount;
+    
+    if (start >= end)
+        return;
+    
+    const double *beginTimes = _beginTimes;
+    const double *inverseDurations = _inverseDurations;
+    double *progress = _progress;
+    
+    /* Progress of all animations in one pass. */
+    for (NSUInteger idx = start ; idx < end ; idx++) {
+        double value = (time - beginTimes[idx]) * inverseDurations[idx];
+        progress[idx] = (value < 0.0 ? 0.0 : (value > 1.0 ? 1.0 : value));
+    }
+    
+    /* Curves are evaluated run by run. */
+    for (NSUInteger runIndex = 0 ; runIndex < _runCount ; runIndex++) {
+        
+        AMAnimationBatchRun run = _runs[runIndex];
+        NSUInteger runStart = MAX(run.start, start);
+        NSUInteger runEnd = MIN(run.start + run.length, end);
+        
+        if (runStart >= runEnd)
+            continue;
+        
+        if (run.function != AMCurveFunctionCustom)
+            AMCurveFunctionTransformBatch(run.function, progress + runStart, _positions + runStart, runEnd - runStart);
+        else
+            [_runCurves[runIndex] transformPositions:progress + runStart count:runEnd - runStart output:_positions + runStart];
+        
+    }
+    
+    const double *positions = _positions;
+    const double *fromValues = _fromValues;
+    const double *deltaValues = _deltaValues;
+    double *values = _values;
+    
+    if (components == 1)
+        for (NSUInteger idx = start ; idx < end ; idx++)
+            values[idx] = fromValues[idx] + deltaValues[idx] * positions[idx];
+    else
+        for (NSUInteger idx = start ; idx < end ; idx++)
+            for (NSUInteger component = 0 ; component < components ; component++) {
+                NSUInteger offset = idx * components + component;
+                values[offset] = fromValues[offset] + deltaValues[offset] * positions[idx];
+            }
+    
+    self.applier(self, _values, NSMakeRange(start, end - start));
+    
+    /* Mark completed animations. */
+    BOOL anyCompleted = NO;
+    
+    for (NSUInteger idx = start ; idx < end ; idx++) {
+        uint64_t bit = (uint64_t)1 << (idx % 64);
+        if (progress[idx] >= 1.0 && !(_completed[idx / 64] & bit)) {
+            _completed[idx / 64] |= bit;
+            _newlyCompleted[idx / 64] |= bit;
+            _remaining--;
+            anyCompleted = YES;
+        }
+    }
+    
+    if (anyCompleted) {
+        
+        if (self.animationsCompletion)
+            self.animationsCompletion(self, _newlyCompleted, NSMakeRange(start, end - start));
+        
+        memset(_newlyCompleted + start / 64, 0, sizeof(uint64_t) * ((end - 1) / 64 - start / 64 + 1));
+        
+        /* Shrink the active range past completed animations at both ends. */
+        while (_activeStart < _activeEnd && [self isAnimationCompleteAtIndex:_activeStart])
+            _activeStart++;
+        while (_activeEnd > _activeStart && [self isAnimationCompleteAtIndex:_activeEnd - 1])
+            _activeEnd--;
+        
+    }
+    
+    if (_remaining == 0)
+        [self endAnimation:YES];
+    
+}
+
+- (void)endAnimation:(BOOL)finished {
+    
+    [self.ticker removeClient:self];
+    
+    self.animating = NO;
+    self.complete = YES;
+    
+    if (self.completion)
+        self.completion(finished);
+    
+}
+
+#pragma mark - Frame Ticker Client
+
+- (void)ticker:(AMFrameTicker *)ticker didTickAtTime:(CFTimeInterval)time {
+    
+    [self stepToTime:time];
+    
+}
+
+#pragma mark - Adding Animations
+
+- (NSUInteger)addAnimationFromValues:(const double *)fromValues toValues:(const double *)toValues duration:(NSTimeInterval)duration delay:(NSTimeInterval)delay curve:(AMCurve *)curve {
+    
+    AMAssertMainThread();
+    NSAssert(!self.isComplete, @"Animations cannot be added to a completed batch.");
+    
+    NSUInteger index = _count;
+    
+    [self ensureCapacity:index + 1];
+    
+    curve = curve ?: [AMCurve linear];
+    
+    /* Animations added before the batch begins are offset when it does. */
+    _beginTimes[index] = (self.isAnimating ? self.ticker.currentTime : 0.0) + delay;
+    _inverseDurations[index] = 1.0 / MAX(duration, 1e-9);
+    
+    for (NSUInteger component = 0 ; component < _componentCount ; component++) {
+        _fromValues[index * _componentCount + component] = fromValues[component];
+        _deltaValues[index * _componentCount + component] = toValues[component] - fromValues[component];
+        _values[index * _componentCount + component] = fromValues[component];
+    }
+    
+    AMCurveFunction function = curve.function;
+    
+    /* Extend the last run if the curve is the same. */
+    if (_runCount > 0 && _runs[_runCount - 1].start + _runs[_runCount - 1].length == index && [_runCurves lastObject] == curve)
+        _runs[_runCount - 1].length++;
+    else {
+        if (_runCount == _runCapacity) {
+            _runCapacity = MAX(_runCapacity * 2, (NSUInteger)8);
+            _runs = realloc(_runs, sizeof(AMAnimationBatchRun) * _runCapacity);
+        }
+        _runs[_runCount++] = (AMAnimationBatchRun){ index, 1, function };
+        [_runCurves addObject:curve];
+    }
+    
+    _count++;
+    _remaining++;
+    _activeEnd = _count;
+    
+    return index;
+    
+}
+
+#pragma mark - Getting Batch Information
+
+- (const double *)values {
+    
+    return _values;
+    
+}
+
+- (BOOL)isAnimationCompleteAtIndex:(NSUInteger)index {
+    
+    NSParameterAssert(index < _count);
+    
+    return (_completed[index / 64] & ((uint64_t)1 << (index % 64))) != 0;
+    
+}
+
+#pragma mark - Properties
+
+- (void)setTicker:(AMFrameTicker *)ticker {
+    
+    AMAssertMainThread();
+    AMAssertMutableState();
+    
+    _ticker = ticker ?: [AMFrameTicker sharedTicker];
+    
+}
+
+#pragma mark - Managing Batch
+
+- (void)beginAnimation {
+    
+    AMAssertMainThread();
+    AMAssertMutableState();
+    
+    CFTimeInterval now = self.ticker.currentTime;
+    
+    for (NSUInteger idx = 0 ; idx < _count ; idx++)
+        _beginTimes[idx] += now;
+    
+    self.animating = YES;
+    
+    if (_remaining == 0) {
+        [self endAnimation:YES];
+        return;
+    }
+    
+    [self.ticker addClient:self];
+    
+}
+
+- (void)cancelAnimation {
+    
+    AMAssertMainThread();
+    
+    if (!self.isComplete)
+        [self endAnimation:NO];
+    
+}
+
+@end
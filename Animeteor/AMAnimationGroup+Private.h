@@ -0,0 +1,46 @@
+//
+//  AMAnimationGroup+Private.h
+//  Animeteor
+//
+//  Copyright (c) 2013-2015, Kristian Trenskow
+//  All rights reserved.
+//  
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are met:
+//  
+//  1. Redistributions of source code must retain the above copyright notice,
+//  this list of conditions and the following disclaimer.
+//  
+//  2. Redistributions in binary form must reproduce the above copyright notice,
+//  this list of conditions and the following disclaimer in the documentation
+//  and/or other materials provided with the distribution.
+//  
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+//  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+//  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+//  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+//  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+//  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+//  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+//  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+//  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+//  POSSIBILITY OF SUCH DAMAGE.
+//
+
+#import "AMAnimation.h"
+
+/*!
+ Reports the completion of an animation to the group it has been added to - if any. Animations of Animeteor call this when they complete, so groups never replace their completion handlers.
+ 
+ @param animation The animation that completed.
+ @param finished  A boolean indicating if the animation was finished.
+ */
+extern void AMAnimationGroupAnimationCompleted(id<AMAnimation> _Nonnull animation, BOOL finished);
+
+/*!
+ Tells the group an animation has been added to that the delay or duration of the animation changed - so the timeline of the group is updated before it is used next.
+ 
+ @param animation The animation that changed.
+ */
+extern void AMAnimationGroupAnimationRetimed(id<AMAnimation> _Nonnull animation);
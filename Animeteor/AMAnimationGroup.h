@@ -32,6 +32,8 @@
 
 /*!
  `AMAnimationGroup` is a class that provides the ability to group animations into a single entity. Animations can be added to the animation group - even other animation groups can be added. A completion handler can be provided on creation that gets invoked when all animations in the group has completed.
+ 
+ Animations are kept in a timeline ordered by their start time. The delay and duration of the group are computed once when the timeline changes, and completion is tracked by counting completed animations - so adding and completing animations is cheap even for large groups. Animations report changes to their delay and duration to the group, which updates its timeline before it is used next.
  */
 @interface AMAnimationGroup : NSObject <AMAnimation>
 
@@ -52,6 +54,37 @@
  */
 - (instancetype _Nonnull)initWithAnimations:(NSArray<id<AMAnimation>> * _Nullable)animations completion:(AMCompletionBlock _Nullable)completion;
 
+/*!
+ Returns an animation group where all animations run in parallel. This is the same as `initWithAnimations:completion:`.
+ 
+ @param animations An `NSArray` of id<AMAnimation> objects to group.
+ @param completion An optional completion block that gets called when the animation group completes.
+ 
+ @return An initialized animation group.
+ */
++ (instancetype _Nonnull)parallelGroupWithAnimations:(NSArray<id<AMAnimation>> * _Nullable)animations completion:(AMCompletionBlock _Nullable)completion;
+
+/*!
+ Returns an animation group where the animations run one after another in the order provided. The delay of each animation becomes the pause after the previous animation.
+ 
+ @param animations An `NSArray` of id<AMAnimation> objects to group.
+ @param completion An optional completion block that gets called when the animation group completes.
+ 
+ @return An initialized animation group.
+ */
++ (instancetype _Nonnull)sequenceGroupWithAnimations:(NSArray<id<AMAnimation>> * _Nullable)animations completion:(AMCompletionBlock _Nullable)completion;
+
+/*!
+ Returns an animation group where the animations begin at a fixed interval from each other in the order provided.
+ 
+ @param animations An `NSArray` of id<AMAnimation> objects to group.
+ @param interval   The time between the beginning of each animation.
+ @param completion An optional completion block that gets called when the animation group completes.
+ 
+ @return An initialized animation group.
+ */
++ (instancetype _Nonnull)staggeredGroupWithAnimations:(NSArray<id<AMAnimation>> * _Nullable)animations interval:(NSTimeInterval)interval completion:(AMCompletionBlock _Nullable)completion;
+
 /// -----------------------
 /// @name Adding Animations
 /// -----------------------
@@ -63,4 +96,9 @@
  */
 - (void)addAnimation:(id<AMAnimation> _Nonnull)animation;
 
+/*!
+ Returns the animations of the group ordered by their start time.
+ */
+@property (nonatomic,readonly,nonnull) NSArray<id<AMAnimation>> *animations;
+
 @end
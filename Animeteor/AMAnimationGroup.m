@@ -31,22 +31,71 @@
 @import ObjectiveC.runtime;
 
 #import "AMMacros.h"
+#import "AMInstrumentation.h"
+#import "AMTimelineKernels.h"
+
+#import "AMDirectAnimation.h"
+#import "AMLayerAnimation.h"
 
 #import "AMAnimationGroup.h"
+#import "AMAnimationGroup+Private.h"
 
 const char AMAnimationGroupKey;
+const char AMAnimationGroupParentKey;
 char AMAnimationGroupObserverContext;
 
-@interface AMAnimationGroup ()
-
-@property (nonatomic) NSMutableSet *animations;
+@interface AMAnimationGroup () {
+    /* The timeline - cached when animations are added or retimed. */
+    BOOL _timelineNeedsUpdate;
+    NSTimeInterval _timelineDelay;
+    NSTimeInterval _timelineEnd;
+    NSMutableArray *_timeline;
+    NSTimeInterval *_startTimes;
+    NSTimeInterval *_endTimes;
+    /* The delays and durations in the order animations were added - and the order by start time, followed by room to sort it. */
+    NSTimeInterval *_delays;
+    NSTimeInterval *_durations;
+    size_t *_order;
+    NSTimeInterval _maximumDuration;
+    NSTimeInterval _lastSeekTime;
+    NSUInteger _remainingAnimations;
+}
 
 @property (nonatomic,getter = isAnimating) BOOL animating;
 @property (nonatomic,getter = isComplete) BOOL complete;
 @property (nonatomic,getter = hasFinished) BOOL finished;
 
+- (void)animationCompleted:(BOOL)finished;
+- (void)animationRetimed;
+
 @end
 
+/* Animations of Animeteor report their completion - other animations are observed. */
+static inline BOOL AMAnimationGroupReportsCompletion(id<AMAnimation> animation) {
+    return ([(id)animation isKindOfClass:[AMDirectAnimation class]] ||
+            [(id)animation isKindOfClass:[AMLayerAnimation class]] ||
+            [(id)animation isKindOfClass:[AMAnimationGroup class]]);
+}
+
+void AMAnimationGroupAnimationCompleted(id<AMAnimation> animation, BOOL finished) {
+    
+    /* The reference is cleared by the group when it completes - so it is never left dangling. */
+    AMAnimationGroup *group = (__bridge AMAnimationGroup *)objc_getAssociatedObject(animation, &AMAnimationGroupParentKey);
+    
+    objc_setAssociatedObject(animation, &AMAnimationGroupParentKey, nil, OBJC_ASSOCIATION_ASSIGN);
+    
+    [group animationCompleted:finished];
+    
+}
+
+void AMAnimationGroupAnimationRetimed(id<AMAnimation> animation) {
+    
+    AMAnimationGroup *group = (__bridge AMAnimationGroup *)objc_getAssociatedObject(animation, &AMAnimationGroupParentKey);
+    
+    [group animationRetimed];
+    
+}
+
 @implementation AMAnimationGroup
 
 #pragma mark - Setup / Teardown
@@ -57,14 +106,20 @@ char AMAnimationGroupObserverContext;
     
     if ((self = [super init])) {
         
-        _animations = [[NSMutableSet alloc] init];
+        _timeline = [[NSMutableArray alloc] initWithCapacity:[animations count]];
         _completion = [completion copy];
         
         _finished = YES;
+        _lastSeekTime = NAN;
+        
+        AM_INSTRUMENT_CREATED(AMInstrumentationObjectAnimationGroup);
         
         for (id<AMAnimation> animation in animations)
             [self addAnimation:animation];
         
+        /* Retain self until the group completes - animations only reference the group weakly. */
+        objc_setAssociatedObject(self, &AMAnimationGroupKey, self, OBJC_ASSOCIATION_RETAIN_NONATOMIC);
+        
         /* Schedule animation begin on next run loop tick. */
         [self performSelector:@selector(beginAnimation) withObject:nil afterDelay:0.0];
         
@@ -74,31 +129,142 @@ char AMAnimationGroupObserverContext;
     
 }
 
++ (instancetype)parallelGroupWithAnimations:(NSArray *)animations completion:(AMCompletionBlock)completion {
+    
+    return [[self alloc] initWithAnimations:animations completion:completion];
+    
+}
+
++ (instancetype)sequenceGroupWithAnimations:(NSArray *)animations completion:(AMCompletionBlock)completion {
+    
+    AMAssertMainThread();
+    
+    NSTimeInterval time = .0;
+    
+    for (id<AMAnimation> animation in animations) {
+        animation.delay += time;
+        time = animation.delay + animation.duration;
+    }
+    
+    return [[self alloc] initWithAnimations:animations completion:completion];
+    
+}
+
++ (instancetype)staggeredGroupWithAnimations:(NSArray *)animations interval:(NSTimeInterval)interval completion:(AMCompletionBlock)completion {
+    
+    AMAssertMainThread();
+    
+    NSTimeInterval time = .0;
+    
+    for (id<AMAnimation> animation in animations) {
+        animation.delay += time;
+        time += interval;
+    }
+    
+    return [[self alloc] initWithAnimations:animations completion:completion];
+    
+}
+
+- (void)dealloc {
+    
+    free(_startTimes);
+    free(_endTimes);
+    free(_delays);
+    free(_durations);
+    free(_order);
+    
+    AM_INSTRUMENT_DESTROYED(AMInstrumentationObjectAnimationGroup);
+    
+}
+
 #pragma mark - Internals
 
-- (void)animationCompleted:(id<AMAnimation>)animation {
+- (void)updateTimelineIfNeeded {
     
-    self.finished = self.isFinished && animation.isFinished;
+    if (!_timelineNeedsUpdate)
+        return;
     
-    /* Remove the observer */
-    [(id)animation removeObserver:self forKeyPath:@"complete" context:&AMAnimationGroupObserverContext];
+    _timelineNeedsUpdate = NO;
     
-    /* Remove self association so we can get released when done. */
-    objc_setAssociatedObject(animation, &AMAnimationGroupKey, nil, OBJC_ASSOCIATION_RETAIN_NONATOMIC);
+    NSUInteger count = [_timeline count];
     
-    [self.animations removeObject:animation];
+    _startTimes = realloc(_startTimes, sizeof(NSTimeInterval) * MAX(count, (NSUInteger)1));
+    _endTimes = realloc(_endTimes, sizeof(NSTimeInterval) * MAX(count, (NSUInteger)1));
+    _delays = realloc(_delays, sizeof(NSTimeInterval) * MAX(count, (NSUInteger)1));
+    _durations = realloc(_durations, sizeof(NSTimeInterval) * MAX(count, (NSUInteger)1));
+    _order = realloc(_order, sizeof(size_t) * 2 * MAX(count, (NSUInteger)1));
+    
+    for (NSUInteger idx = 0 ; idx < count ; idx++) {
+        id<AMAnimation> animation = _timeline[idx];
+        _delays[idx] = animation.delay;
+        _durations[idx] = animation.duration;
+    }
+    
+    /* Order animations by start time. The sort is stable, so animations starting together keep the order they were added in. */
+    AMTimelineExtent extent = AMTimelineBuild(_delays, _durations, count, _order, _order + count, _startTimes, _endTimes);
+    
+    NSMutableArray *timeline = [[NSMutableArray alloc] initWithCapacity:count];
+    for (NSUInteger idx = 0 ; idx < count ; idx++)
+        [timeline addObject:_timeline[_order[idx]]];
+    
+    _timeline = timeline;
+    _timelineDelay = extent.delay;
+    _timelineEnd = extent.end;
+    _maximumDuration = extent.maximumDuration;
+    _lastSeekTime = NAN;
+    
+}
+
+- (void)animationRetimed {
+    
+    _timelineNeedsUpdate = YES;
+    
+    /* The timeline of an enclosing group includes this one. */
+    AMAnimationGroupAnimationRetimed(self);
+    
+}
+
+- (void)animationCompleted:(BOOL)finished {
+    
+    if (self.isComplete)
+        return;
+    
+    self.finished = self.isFinished && finished;
+    
+    if (_remainingAnimations > 0)
+        _remainingAnimations--;
     
     /* When all animations has completed, we complete the group. */
-    if ([self.animations count] == 0) {
-        
-        if (self.completion)
-            self.completion(self.isFinished);
-        
-        self.complete = YES;
-        self.animating = NO;
-        
+    if (_remainingAnimations == 0)
+        [self completeAnimation];
+    
+}
+
+- (void)completeAnimation {
+    
+    self.complete = YES;
+    self.animating = NO;
+    
+    /* Animations completing after the group no longer report to it. */
+    for (id<AMAnimation> animation in _timeline) {
+        if (AMAnimationGroupReportsCompletion(animation))
+            objc_setAssociatedObject(animation, &AMAnimationGroupParentKey, nil, OBJC_ASSOCIATION_ASSIGN);
+        else {
+            if (!animation.isComplete)
+                [(id)animation removeObserver:self forKeyPath:@"complete" context:&AMAnimationGroupObserverContext];
+            [(id)animation removeObserver:self forKeyPath:@"delay" context:&AMAnimationGroupObserverContext];
+            [(id)animation removeObserver:self forKeyPath:@"duration" context:&AMAnimationGroupObserverContext];
+        }
     }
     
+    if (self.completion)
+        self.completion(self.isFinished);
+    
+    AMAnimationGroupAnimationCompleted(self, self.isFinished);
+    
+    /* Remove self association so we can get released when done. */
+    objc_setAssociatedObject(self, &AMAnimationGroupKey, nil, OBJC_ASSOCIATION_RETAIN_NONATOMIC);
+    
 }
 
 #pragma mark - Managing Animations
@@ -111,13 +277,18 @@ char AMAnimationGroupObserverContext;
     /* Tell animation to postpone it's animation so we can manage this in the group */
     [animation postponeAnimation];
     
-    [self.animations addObject:animation];
-    
-    /* Add observer for when animation completes */
-    [(id)animation addObserver:self forKeyPath:@"complete" options:0 context:&AMAnimationGroupObserverContext];
-    
-    /* Associate group with animation so it will retain it as long as animation lives */
-    objc_setAssociatedObject(animation, &AMAnimationGroupKey, self, OBJC_ASSOCIATION_RETAIN_NONATOMIC);
+    [_timeline addObject:animation];
+    _remainingAnimations++;
+    _timelineNeedsUpdate = YES;
+    
+    /* Completion is reported through a reference to the group - leaving the completion handler of the animation to its owner. */
+    if (AMAnimationGroupReportsCompletion(animation))
+        objc_setAssociatedObject(animation, &AMAnimationGroupParentKey, self, OBJC_ASSOCIATION_ASSIGN);
+    else {
+        [(id)animation addObserver:self forKeyPath:@"complete" options:0 context:&AMAnimationGroupObserverContext];
+        [(id)animation addObserver:self forKeyPath:@"delay" options:0 context:&AMAnimationGroupObserverContext];
+        [(id)animation addObserver:self forKeyPath:@"duration" options:0 context:&AMAnimationGroupObserverContext];
+    }
     
 }
 
@@ -129,10 +300,17 @@ char AMAnimationGroupObserverContext;
     /* Start by cancelling any scheduled calls */
     [NSObject cancelPreviousPerformRequestsWithTarget:self selector:@selector(beginAnimation) object:nil];
     
+    [self updateTimelineIfNeeded];
+    
     if (!self.isAnimating)
         self.animating = YES;
     
-    [self.animations makeObjectsPerformSelector:@selector(beginAnimation)];
+    if ([_timeline count] == 0) {
+        [self completeAnimation];
+        return;
+    }
+    
+    [_timeline makeObjectsPerformSelector:@selector(beginAnimation)];
     
 }
 
@@ -149,13 +327,44 @@ char AMAnimationGroupObserverContext;
     
     AMAssertMainThread();
     
-    [self.animations makeObjectsPerformSelector:@selector(cancelAnimation)];
+    if (self.isComplete)
+        return;
+    
+    [NSObject cancelPreviousPerformRequestsWithTarget:self selector:@selector(beginAnimation) object:nil];
     
+    /* Cancelled animations report back through their completion handlers - completing the group with the last one. */
     self.finished = NO;
-    self.complete = YES;
     
-    if (self.completion)
-        self.completion(NO);
+    for (id<AMAnimation> animation in [_timeline copy])
+        if (!animation.isComplete)
+            [animation cancelAnimation];
+    
+    if (!self.isComplete)
+        [self completeAnimation];
+    
+}
+
+- (void)seekToTime:(NSTimeInterval)time {
+    
+    AMAssertMainThread();
+    
+    [self updateTimelineIfNeeded];
+    
+    NSUInteger count = [_timeline count];
+    
+    /* Only animations active somewhere between the last and the new time can change. The first seek updates all. */
+    AMTimelineSeek seek = AMTimelineSeekMake(_startTimes, count, _maximumDuration, _lastSeekTime, time);
+    
+    _lastSeekTime = time;
+    
+    /* Animations not yet started are reset in reverse order and started ones applied in order - so the latest started animation wins shared properties. */
+    for (NSUInteger idx = seek.last ; idx > seek.started ; idx--)
+        if (_endTimes[idx - 1] >= seek.low && [_timeline[idx - 1] respondsToSelector:@selector(seekToTime:)])
+            [_timeline[idx - 1] seekToTime:time];
+    
+    for (NSUInteger idx = seek.first ; idx < seek.started ; idx++)
+        if (_endTimes[idx] >= seek.low && [_timeline[idx] respondsToSelector:@selector(seekToTime:)])
+            [_timeline[idx] seekToTime:time];
     
 }
 
@@ -164,17 +373,21 @@ char AMAnimationGroupObserverContext;
 @synthesize duration=_duration;
 @synthesize completion=_completion;
 
+- (NSArray *)animations {
+    
+    [self updateTimelineIfNeeded];
+    
+    return [_timeline copy];
+    
+}
+
 - (NSTimeInterval)duration {
     
     AMAssertMainThread();
     
-    NSTimeInterval duration = .0;
-    
-    /* Iterate animations and find the longest running */
-    for (id<AMAnimation> animation in self.animations)
-        duration = MAX(duration, animation.delay + animation.duration);
+    [self updateTimelineIfNeeded];
     
-    return duration - self.delay;
+    return _timelineEnd - _timelineDelay;
     
 }
 
@@ -185,22 +398,20 @@ char AMAnimationGroupObserverContext;
     
     NSTimeInterval delta = duration - self.duration;
     
-    for (id<AMAnimation> animation in self.animations)
+    for (id<AMAnimation> animation in _timeline)
         animation.duration += delta;
     
+    [self animationRetimed];
+    
 }
 
 - (NSTimeInterval)delay {
     
     AMAssertMainThread();
     
-    /* Finds the lowest delay of all animations */
-    NSTimeInterval delay = DBL_MAX;
-    
-    for (id<AMAnimation> animation in self.animations)
-        delay = MIN(delay, animation.delay);
+    [self updateTimelineIfNeeded];
     
-    return (delay < DBL_MAX ? delay : .0);
+    return _timelineDelay;
     
 }
 
@@ -211,9 +422,11 @@ char AMAnimationGroupObserverContext;
     
     NSTimeInterval delta = delay - self.delay;
     
-    for (id<AMAnimation> animation in self.animations)
+    for (id<AMAnimation> animation in _timeline)
         animation.delay += delta;
     
+    [self animationRetimed];
+    
 }
 
 - (void)setCompletion:(AMCompletionBlock)completion {
@@ -231,8 +444,11 @@ char AMAnimationGroupObserverContext;
     
     if (context == &AMAnimationGroupObserverContext) {
         
-        if ([keyPath isEqualToString:@"complete"] && [object isComplete])
-            [self animationCompleted:object];
+        if ([keyPath isEqualToString:@"complete"] && [object isComplete]) {
+            [object removeObserver:self forKeyPath:@"complete" context:&AMAnimationGroupObserverContext];
+            [self animationCompleted:[object isFinished]];
+        } else if ([keyPath isEqualToString:@"delay"] || [keyPath isEqualToString:@"duration"])
+            [self animationRetimed];
         
     } else
         [super observeValueForKeyPath:keyPath ofObject:object change:change context:context];
@@ -0,0 +1,188 @@
+//
+//  AMAnimationPool.h
+//  Animeteor
+//
+//  Copyright (c) 2013-2015, Kristian Trenskow
+//  All rights reserved.
+//  
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are met:
+//  
+//  1. Redistributions of source code must retain the above copyright notice,
+//  this list of conditions and the following disclaimer.
+//  
+//  2. Redistributions in binary form must reproduce the above copyright notice,
+//  this list of conditions and the following disclaimer in the documentation
+//  and/or other materials provided with the distribution.
+//  
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+//  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+//  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+//  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+//  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+//  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+//  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+//  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+//  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+//  POSSIBILITY OF SUCH DAMAGE.
+//
+
+@import Foundation;
+
+@class AMAnimationPool;
+@class AMCurve;
+@class AMFrameTicker;
+
+/*!
+ A handle to an animation of a pool. Handles are plain values - the lower 32 bits index the record of the animation, and the upper 32 bits hold the generation of the record. A handle goes stale when its animation completes, so a recycled record is never mistaken for the animation it used to hold.
+ */
+typedef uint64_t AMAnimationHandle;
+
+/*!
+ A handle that never refers to an animation.
+ */
+#define AMAnimationHandleInvalid ((AMAnimationHandle)0)
+
+/*!
+ A prototype of a block that gets called when animations of a pool complete.
+ 
+ @param pool     The pool of the animation.
+ @param handle   The handle of the animation. The handle is already stale.
+ @param finished `YES` if the animation finished - `NO` if it was cancelled or its object went away.
+ */
+typedef void (^AMAnimationPoolCompletionBlock)(AMAnimationPool * _Nonnull pool, AMAnimationHandle handle, BOOL finished);
+
+/*!
+ Statistics of a pool.
+ */
+typedef struct {
+    /*! The number of records in the arena. */
+    NSUInteger capacity;
+    /*! The size in bytes of the arena. */
+    size_t arenaSize;
+    /*! The number of animations in progress - including animations in their delay. */
+    NSUInteger activeCount;
+    /*! The highest number of animations that were in progress at once. */
+    NSUInteger peakActiveCount;
+    /*! The number of animations started. */
+    NSUInteger startedCount;
+    /*! The number of animations started in a recycled record. */
+    NSUInteger recycledCount;
+    /*! The number of animations that finished. */
+    NSUInteger finishedCount;
+    /*! The number of animations that were cancelled - or whose object went away. */
+    NSUInteger cancelledCount;
+} AMAnimationPoolStatistics;
+
+/*!
+ The `AMAnimationPool` class runs lightweight animations of object properties - for places that start and throw away a lot of short animations, like cells of a fast scrolling list.
+ 
+ Animations are stored in fixed-size records in an arena, and records are recycled as animations complete - so starting an animation allocates nothing once the arena has grown to the number of animations running at once. Animations are identified by handles instead of objects, begin without a run loop perform, and hold their objects weakly. The pool is a single client of its ticker and steps all its animations in one pass per frame. Completion is reported by a single block for the pool.
+ 
+ Values are set by calling a setter of the object directly. The setter must take a `double`, `float`, `CGPoint`, `CGSize`, `CGVector` or `CGRect`. Pools must only be used from the main thread.
+ */
+@interface AMAnimationPool : NSObject
+
+/// ---------------------
+/// @name Creating a Pool
+/// ---------------------
+
++ (instancetype _Nullable)new UNAVAILABLE_ATTRIBUTE;
+- (instancetype _Nullable)init UNAVAILABLE_ATTRIBUTE;
+
+/*!
+ Returns the shared pool.
+ 
+ @return The shared pool.
+ */
++ (AMAnimationPool * _Nonnull)sharedPool;
+
+/*!
+ Returns an initialized pool.
+ 
+ @param capacity The number of records to allocate up front. The arena grows as needed.
+ 
+ @return An initialized pool.
+ */
+- (instancetype _Nonnull)initWithCapacity:(NSUInteger)capacity;
+
+/// -------------------------
+/// @name Starting Animations
+/// -------------------------
+
+/*!
+ Starts an animation of a property of an object.
+ 
+ @param object         The object to animate. The object is not retained.
+ @param setter         The setter of the property - like `@selector(setAlpha:)`.
+ @param fromValues     `componentCount` values to animate from.
+ @param toValues       `componentCount` values to animate to.
+ @param componentCount The number of values - one for `double` and `float`, two for `CGPoint`, `CGSize` and `CGVector`, or four for `CGRect`.
+ @param duration       The duration of the animation.
+ @param delay          The delay before the animation begins.
+ @param curve          The curve of the animation. Providing `nil` will default to a linear curve.
+ 
+ @return The handle of the animation - or `AMAnimationHandleInvalid` if the object does not have a setter taking `componentCount` values.
+ */
+- (AMAnimationHandle)animateObject:(id _Nonnull)object
+                            setter:(SEL _Nonnull)setter
+                        fromValues:(const double * _Nonnull)fromValues
+                          toValues:(const double * _Nonnull)toValues
+                    componentCount:(NSUInteger)componentCount
+                          duration:(NSTimeInterval)duration
+                             delay:(NSTimeInterval)delay
+                             curve:(AMCurve * _Nullable)curve;
+
+/// -------------------------
+/// @name Managing Animations
+/// -------------------------
+
+/*!
+ Returns `YES` if the animation of a handle is in progress - including its delay.
+ 
+ @param handle The handle of the animation.
+ */
+- (BOOL)isAnimating:(AMAnimationHandle)handle;
+
+/*!
+ Cancels an animation. The value stays at its current position and the completion block is invoked. Does nothing if the handle is stale.
+ 
+ @param handle The handle of the animation.
+ */
+- (void)cancelAnimation:(AMAnimationHandle)handle;
+
+/*!
+ Cancels all animations of the pool.
+ */
+- (void)cancelAllAnimations;
+
+/// ----------------------
+/// @name Configuring Pool
+/// ----------------------
+
+/*!
+ The ticker that steps the pool. Default is the shared ticker. Providing `nil` will reset it to the shared ticker. Can only be changed while no animations are in progress.
+ */
+@property (nonatomic,null_resettable) AMFrameTicker *ticker;
+
+/*!
+ An optional block that gets called as animations complete.
+ */
+@property (nonatomic,copy,nullable) AMAnimationPoolCompletionBlock completion;
+
+/// ------------------------------
+/// @name Getting Pool Information
+/// ------------------------------
+
+/*!
+ Returns the statistics of the pool.
+ */
+@property (nonatomic,readonly) AMAnimationPoolStatistics statistics;
+
+/*!
+ Resets the counters of the statistics. The capacity, arena size and active count are not counters and are kept.
+ */
+- (void)resetStatistics;
+
+@end
@@ -0,0 +1,453 @@
+//
+//  AMAnimationPool.m
+//  Animeteor
+//
+//  Copyright (c) 2013-2015, Kristian Trenskow
+//  All rights reserved.
+//  
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are met:
+//  
+//  1. Redistributions of source code must retain the above copyright notice,
+//  this list of conditions and the following disclaimer.
+//  
+//  2. Redistributions in binary form must reproduce the above copyright notice,
+//  this list of conditions and the following disclaimer in the documentation
+//  and/or other materials provided with the distribution.
+//  
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+//  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+//  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+//  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+//  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+//  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+//  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+//  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+//  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+//  POSSIBILITY OF SUCH DAMAGE.
+//
+
+@import ObjectiveC.runtime;
+@import UIKit;
+
+#import "AMMacros.h"
+
+#import "AMCurve.h"
+#import "AMFrameTicker.h"
+
+#import "AMAnimationPool.h"
+
+// Number of records in each chunk of the arena. Chunks never move - so records keep their address as the arena grows.
+#define RECORDS_PER_CHUNK 64
+
+// Terminates the list of free records.
+#define NO_RECORD UINT32_MAX
+
+typedef NS_ENUM(uint8_t, AMAnimationPoolSetterKind) {
+    AMAnimationPoolSetterKindDouble = 0,
+    AMAnimationPoolSetterKindFloat,
+    AMAnimationPoolSetterKindPair,
+    AMAnimationPoolSetterKindRect
+};
+
+/* A fixed-size animation record. Objects and custom curves are kept in side tables indexed like the records. */
+typedef struct {
+    uint32_t generation;
+    uint32_t nextFree;
+    uint32_t activeIndex;
+    BOOL active;
+    AMAnimationPoolSetterKind kind;
+    AMCurveFunction function;
+    CFTimeInterval beginTime;
+    double inverseDuration;
+    double fromValues[4];
+    double deltaValues[4];
+    SEL setter;
+    IMP setterIMP;
+} AMAnimationPoolRecord;
+
+static inline AMAnimationPoolRecord *AMAnimationPoolRecordAtIndex(AMAnimationPoolRecord **chunks, uint32_t index) {
+    return &chunks[index / RECORDS_PER_CHUNK][index % RECORDS_PER_CHUNK];
+}
+
+static inline AMAnimationHandle AMAnimationPoolHandleMake(uint32_t index, uint32_t generation) {
+    return ((AMAnimationHandle)generation << 32) | index;
+}
+
+static BOOL AMAnimationPoolResolveSetter(id object, SEL setter, NSUInteger componentCount, AMAnimationPoolSetterKind *kind, IMP *setterIMP) {
+    
+    /* Resolved through the runtime directly - method signatures would be allocated. */
+    Method method = class_getInstanceMethod(object_getClass(object), setter);
+    if (!method || method_getNumberOfArguments(method) != 3)
+        return NO;
+    
+    char type[64];
+    method_getArgumentType(method, 2, type, sizeof(type));
+    
+    switch (componentCount) {
+        case 1:
+            if (0 == strcmp(type, @encode(double))) *kind = AMAnimationPoolSetterKindDouble;
+            else if (0 == strcmp(type, @encode(float))) *kind = AMAnimationPoolSetterKindFloat;
+            else return NO;
+            break;
+        case 2:
+            if (0 == strcmp(type, @encode(CGPoint)) || 0 == strcmp(type, @encode(CGSize)) || 0 == strcmp(type, @encode(CGVector))) *kind = AMAnimationPoolSetterKindPair;
+            else return NO;
+            break;
+        case 4:
+            if (0 == strcmp(type, @encode(CGRect))) *kind = AMAnimationPoolSetterKindRect;
+            else return NO;
+            break;
+        default:
+            return NO;
+    }
+    
+    *setterIMP = method_getImplementation(method);
+    
+    return YES;
+    
+}
+
+static inline void AMAnimationPoolApply(const AMAnimationPoolRecord *record, id object, double position) {
+    
+    const double *from = record->fromValues;
+    const double *delta = record->deltaValues;
+    
+    /* CGPoint, CGSize and CGVector are all pairs of CGFloats - and share calling convention. */
+    switch (record->kind) {
+        case AMAnimationPoolSetterKindDouble:
+            ((void (*)(id, SEL, double))record->setterIMP)(object, record->setter, from[0] + delta[0] * position);
+            break;
+        case AMAnimationPoolSetterKindFloat:
+            ((void (*)(id, SEL, float))record->setterIMP)(object, record->setter, (float)(from[0] + delta[0] * position));
+            break;
+        case AMAnimationPoolSetterKindPair:
+            ((void (*)(id, SEL, CGPoint))record->setterIMP)(object, record->setter, CGPointMake(from[0] + delta[0] * position,
+                                                                                               from[1] + delta[1] * position));
+            break;
+        case AMAnimationPoolSetterKindRect:
+            ((void (*)(id, SEL, CGRect))record->setterIMP)(object, record->setter, CGRectMake(from[0] + delta[0] * position,
+                                                                                             from[1] + delta[1] * position,
+                                                                                             from[2] + delta[2] * position,
+                                                                                             from[3] + delta[3] * position));
+            break;
+    }
+    
+}
+
+@interface AMAnimationPool () <AMFrameTickerClient> {
+    AMAnimationPoolRecord **_chunks;
+    NSUInteger _chunkCount;
+    NSUInteger _capacity;
+    uint32_t _freeHead;
+    /* Indices of the records in progress - records know their own position in the list. */
+    uint32_t *_active;
+    NSUInteger _activeCount;
+    AMAnimationPoolStatistics _statistics;
+}
+
+@property (nonatomic) NSPointerArray *objects;
+@property (nonatomic) NSPointerArray *curves;
+
+@end
+
+@implementation AMAnimationPool
+
+#pragma mark - Creating a Pool
+
++ (AMAnimationPool *)sharedPool {
+    
+    static AMAnimationPool *pool;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        pool = [[AMAnimationPool alloc] initWithCapacity:RECORDS_PER_CHUNK];
+    });
+    
+    return pool;
+    
+}
+
+#pragma mark - Setup / Teardown
+
+- (instancetype)initWithCapacity:(NSUInteger)capacity {
+    
+    AMAssertMainThread();
+    
+    if ((self = [super init])) {
+        
+        _objects = [NSPointerArray weakObjectsPointerArray];
+        _curves = [NSPointerArray strongObjectsPointerArray];
+        _freeHead = NO_RECORD;
+        _ticker = [AMFrameTicker sharedTicker];
+        
+        [self growToCapacity:MAX(capacity, (NSUInteger)1)];
+        
+    }
+    
+    return self;
+    
+}
+
+- (void)dealloc {
+    
+    for (NSUInteger idx = 0 ; idx < _chunkCount ; idx++)
+        free(_chunks[idx]);
+    
+    free(_chunks);
+    free(_active);
+    
+}
+
+#pragma mark - Internals
+
+- (void)growToCapacity:(NSUInteger)capacity {
+    
+    if (capacity <= _capacity)
+        return;
+    
+    NSUInteger chunkCount = (capacity + RECORDS_PER_CHUNK - 1) / RECORDS_PER_CHUNK;
+    
+    _chunks = realloc(_chunks, sizeof(AMAnimationPoolRecord *) * chunkCount);
+    
+    for (NSUInteger chunk = _chunkCount ; chunk < chunkCount ; chunk++) {
+        
+        _chunks[chunk] = calloc(RECORDS_PER_CHUNK, sizeof(AMAnimationPoolRecord));
+        
+        /* Records are pushed in reverse - so the lowest index is handed out first. */
+        for (NSInteger offset = RECORDS_PER_CHUNK - 1 ; offset >= 0 ; offset--) {
+            AMAnimationPoolRecord *record = &_chunks[chunk][offset];
+            record->generation = 1;
+            record->nextFree = _freeHead;
+            _freeHead = (uint32_t)(chunk * RECORDS_PER_CHUNK + offset);
+        }
+        
+    }
+    
+    _chunkCount = chunkCount;
+    _capacity = chunkCount * RECORDS_PER_CHUNK;
+    
+    _active = realloc(_active, sizeof(uint32_t) * _capacity);
+    
+    self.objects.count = _capacity;
+    self.curves.count = _capacity;
+    
+}
+
+- (AMAnimationPoolRecord *)activeRecordForHandle:(AMAnimationHandle)handle {
+    
+    uint32_t index = (uint32_t)(handle & UINT32_MAX);
+    uint32_t generation = (uint32_t)(handle >> 32);
+    
+    if (generation == 0 || index >= _capacity)
+        return NULL;
+    
+    AMAnimationPoolRecord *record = AMAnimationPoolRecordAtIndex(_chunks, index);
+    
+    return (record->active && record->generation == generation ? record : NULL);
+    
+}
+
+- (void)releaseRecordAtIndex:(uint32_t)index finished:(BOOL)finished {
+    
+    AMAnimationPoolRecord *record = AMAnimationPoolRecordAtIndex(_chunks, index);
+    AMAnimationHandle handle = AMAnimationPoolHandleMake(index, record->generation);
+    
+    /* A new generation makes outstanding handles stale. Zero is skipped, as it is the invalid handle. */
+    record->active = NO;
+    record->generation = MAX(record->generation + 1, (uint32_t)1);
+    
+    uint32_t last = _active[--_activeCount];
+    _active[record->activeIndex] = last;
+    AMAnimationPoolRecordAtIndex(_chunks, last)->activeIndex = record->activeIndex;
+    
+    [self.objects replacePointerAtIndex:index withPointer:NULL];
+    [self.curves replacePointerAtIndex:index withPointer:NULL];
+    
+    record->nextFree = _freeHead;
+    _freeHead = index;
+    
+    if (finished)
+        _statistics.finishedCount++;
+    else
+        _statistics.cancelledCount++;
+    
+    if (_activeCount == 0)
+        [self.ticker removeClient:self];
+    
+    if (self.completion)
+        self.completion(self, handle, finished);
+    
+}
+
+#pragma mark - Frame Ticker Client
+
+- (void)ticker:(AMFrameTicker *)ticker didTickAtTime:(CFTimeInterval)time {
+    
+    /* Released records are replaced by the last active record - so the index only advances past records still in progress. */
+    for (NSUInteger idx = 0 ; idx < _activeCount ; ) {
+        
+        uint32_t index = _active[idx];
+        AMAnimationPoolRecord *record = AMAnimationPoolRecordAtIndex(_chunks, index);
+        
+        double progress = (time - record->beginTime) * record->inverseDuration;
+        
+        if (progress < 0.0) {
+            idx++;
+            continue;
+        }
+        
+        progress = MIN(progress, 1.0);
+        
+        id object = (__bridge id)[_objects pointerAtIndex:index];
+        
+        if (!object) {
+            [self releaseRecordAtIndex:index finished:NO];
+            continue;
+        }
+        
+        /* Records keep the function of built-in curves - only custom curves are looked up and messaged. */
+        double position = (record->function != AMCurveFunctionCustom ? AMCurveFunctionTransform(record->function, progress) : [(__bridge AMCurve *)[_curves pointerAtIndex:index] transform:progress]);
+        
+        AMAnimationPoolApply(record, object, position);
+        
+        if (progress >= 1.0) {
+            [self releaseRecordAtIndex:index finished:YES];
+            continue;
+        }
+        
+        idx++;
+        
+    }
+    
+}
+
+#pragma mark - Starting Animations
+
+- (AMAnimationHandle)animateObject:(id)object setter:(SEL)setter fromValues:(const double *)fromValues toValues:(const double *)toValues componentCount:(NSUInteger)componentCount duration:(NSTimeInterval)duration delay:(NSTimeInterval)delay curve:(AMCurve *)curve {
+    
+    AMAssertMainThread();
+    NSParameterAssert(object);
+    NSParameterAssert(setter);
+    
+    AMAnimationPoolSetterKind kind;
+    IMP setterIMP;
+    
+    if (!AMAnimationPoolResolveSetter(object, setter, componentCount, &kind, &setterIMP))
+        return AMAnimationHandleInvalid;
+    
+    if (_freeHead == NO_RECORD)
+        [self growToCapacity:_capacity + RECORDS_PER_CHUNK];
+    
+    uint32_t index = _freeHead;
+    AMAnimationPoolRecord *record = AMAnimationPoolRecordAtIndex(_chunks, index);
+    _freeHead = record->nextFree;
+    
+    if (record->generation > 1)
+        _statistics.recycledCount++;
+    
+    curve = curve ?: [AMCurve linear];
+    
+    record->active = YES;
+    record->kind = kind;
+    record->function = curve.function;
+    record->beginTime = self.ticker.currentTime + delay;
+    record->inverseDuration = 1.0 / MAX(duration, 1e-9);
+    record->setter = setter;
+    record->setterIMP = setterIMP;
+    
+    for (NSUInteger component = 0 ; component < componentCount ; component++) {
+        record->fromValues[component] = fromValues[component];
+        record->deltaValues[component] = toValues[component] - fromValues[component];
+    }
+    
+    [self.objects replacePointerAtIndex:index withPointer:(__bridge void *)object];
+    
+    /* Only custom curves need to be kept. */
+    if (record->function == AMCurveFunctionCustom)
+        [self.curves replacePointerAtIndex:index withPointer:(__bridge void *)curve];
+    
+    record->activeIndex = (uint32_t)_activeCount;
+    _active[_activeCount++] = index;
+    
+    _statistics.startedCount++;
+    _statistics.peakActiveCount = MAX(_statistics.peakActiveCount, _activeCount);
+    
+    if (_activeCount == 1)
+        [self.ticker addClient:self];
+    
+    return AMAnimationPoolHandleMake(index, record->generation);
+    
+}
+
+#pragma mark - Managing Animations
+
+- (BOOL)isAnimating:(AMAnimationHandle)handle {
+    
+    AMAssertMainThread();
+    
+    return ([self activeRecordForHandle:handle] != NULL);
+    
+}
+
+- (void)cancelAnimation:(AMAnimationHandle)handle {
+    
+    AMAssertMainThread();
+    
+    if ([self activeRecordForHandle:handle])
+        [self releaseRecordAtIndex:(uint32_t)(handle & UINT32_MAX) finished:NO];
+    
+}
+
+- (void)cancelAllAnimations {
+    
+    AMAssertMainThread();
+    
+    while (_activeCount > 0)
+        [self releaseRecordAtIndex:_active[_activeCount - 1] finished:NO];
+    
+}
+
+#pragma mark - Properties
+
+- (void)setTicker:(AMFrameTicker *)ticker {
+    
+    AMAssertMainThread();
+    NSAssert(_activeCount == 0, @"Ticker cannot be changed while animations are in progress.");
+    
+    _ticker = ticker ?: [AMFrameTicker sharedTicker];
+    
+}
+
+- (void)setCompletion:(AMAnimationPoolCompletionBlock)completion {
+    
+    AMAssertMainThread();
+    
+    _completion = [completion copy];
+    
+}
+
+#pragma mark - Getting Pool Information
+
+- (AMAnimationPoolStatistics)statistics {
+    
+    AMAnimationPoolStatistics statistics = _statistics;
+    
+    statistics.capacity = _capacity;
+    statistics.arenaSize = _capacity * sizeof(AMAnimationPoolRecord);
+    statistics.activeCount = _activeCount;
+    
+    return statistics;
+    
+}
+
+- (void)resetStatistics {
+    
+    AMAssertMainThread();
+    
+    memset(&_statistics, 0, sizeof(_statistics));
+    _statistics.peakActiveCount = _activeCount;
+    
+}
+
+@end
@@ -0,0 +1,142 @@
+//
+//  AMAnimationRegistry.h
+//  Animeteor
+//
+//  Copyright (c) 2013-2015, Kristian Trenskow
+//  All rights reserved.
+//  
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are met:
+//  
+//  1. Redistributions of source code must retain the above copyright notice,
+//  this list of conditions and the following disclaimer.
+//  
+//  2. Redistributions in binary form must reproduce the above copyright notice,
+//  this list of conditions and the following disclaimer in the documentation
+//  and/or other materials provided with the distribution.
+//  
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+//  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+//  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+//  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+//  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+//  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+//  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+//  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+//  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+//  POSSIBILITY OF SUCH DAMAGE.
+//
+
+@import Foundation;
+
+#import "AMAnimation.h"
+
+/*!
+ Policies for resolving conflicts when an animation starts on a key path that is already being animated.
+ */
+typedef NS_ENUM(NSUInteger, AMAnimationConflictPolicy) {
+    /*! The existing animation is cancelled and the new animation animates from its own from value. */
+    AMAnimationConflictPolicyReplace = 0,
+    /*! The existing animation is cancelled and the new animation continues from the current value - ignoring its own from value. */
+    AMAnimationConflictPolicyMerge,
+    /*! The existing animation is cancelled and the new animation continues from its presented value and velocity - ignoring its own from value. Values without a velocity (generic values and transforms) are merged. */
+    AMAnimationConflictPolicyRetarget
+};
+
+@protocol AMInterpolatable;
+
+/*!
+ The `AMRetargetableAnimation` protocol is adopted by animations that can hand their presented value and velocity over to an animation replacing them. The values are evaluated from the curve of the animation - not read back from the animated object.
+ */
+@protocol AMRetargetableAnimation <AMAnimation>
+
+@required
+
+/*!
+ Returns the value currently presented by the animation - or `nil` if the animation is not in progress.
+ */
+@property (nonatomic,readonly,nullable) id<AMInterpolatable> presentationValue;
+
+/*!
+ Returns the velocity of the value currently presented by the animation - in units of the value per second. Returns `nil` if the animation is not in progress, or if its values have no velocity.
+ */
+@property (nonatomic,readonly,nullable) id<AMInterpolatable> presentationVelocity;
+
+@end
+
+/*!
+ The `AMAnimationRegistry` class keeps track of the animations in effect - keyed by the animated object and key path. Layer animations and direct animations register as they take effect (after their delay), and the animation already registered on the same key path is cancelled - so redundant animations do not keep running or keep their resources alive. Animations are unregistered as they complete.
+ 
+ Registrations are stored on the animated objects themselves, and go away with them. The registry must only be used from the main thread.
+ */
+@interface AMAnimationRegistry : NSObject
+
++ (instancetype _Nullable)new UNAVAILABLE_ATTRIBUTE;
+- (instancetype _Nullable)init UNAVAILABLE_ATTRIBUTE;
+
+/// ---------------------------
+/// @name Looking Up Animations
+/// ---------------------------
+
+/*!
+ Returns the animation in effect on a key path of an object.
+ 
+ @param target  The animated object.
+ @param keyPath The animated key path.
+ 
+ @return The animation - or `nil` if the key path is not being animated.
+ */
++ (id<AMAnimation> _Nullable)animationForTarget:(id _Nonnull)target keyPath:(NSString * _Nonnull)keyPath;
+
+/*!
+ Returns all animations in effect on an object.
+ 
+ @param target The animated object.
+ 
+ @return The animations.
+ */
++ (NSArray<id<AMAnimation>> * _Nonnull)animationsForTarget:(id _Nonnull)target;
+
+/*!
+ Returns `YES` if a key path of an object is being animated.
+ 
+ @param target  The animated object.
+ @param keyPath The key path - or `nil` for any key path.
+ 
+ @return `YES` if an animation is in effect.
+ */
++ (BOOL)isAnimatingTarget:(id _Nonnull)target keyPath:(NSString * _Nullable)keyPath;
+
+/*!
+ Cancels all animations in effect on an object.
+ 
+ @param target The animated object.
+ */
++ (void)cancelAnimationsForTarget:(id _Nonnull)target;
+
+/// ----------------------------
+/// @name Registering Animations
+/// ----------------------------
+
+/*!
+ Registers an animation as in effect on a key path of an object - cancelling the animation already registered.
+ 
+ @param animation The animation.
+ @param target    The animated object.
+ @param keyPath   The animated key path.
+ 
+ @return The animation that was cancelled - or `nil` if the key path was not being animated. Does nothing if `target` is `nil`.
+ */
++ (id<AMAnimation> _Nullable)registerAnimation:(id<AMAnimation> _Nonnull)animation forTarget:(id _Nullable)target keyPath:(NSString * _Nonnull)keyPath;
+
+/*!
+ Unregisters an animation. Does nothing if another animation has since been registered on the key path.
+ 
+ @param animation The animation.
+ @param target    The animated object.
+ @param keyPath   The animated key path.
+ */
++ (void)unregisterAnimation:(id<AMAnimation> _Nonnull)animation forTarget:(id _Nullable)target keyPath:(NSString * _Nonnull)keyPath;
+
+@end
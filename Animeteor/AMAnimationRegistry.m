@@ -0,0 +1,133 @@
+//
+//  AMAnimationRegistry.m
+//  Animeteor
+//
+//  Copyright (c) 2013-2015, Kristian Trenskow
+//  All rights reserved.
+//  
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are met:
+//  
+//  1. Redistributions of source code must retain the above copyright notice,
+//  this list of conditions and the following disclaimer.
+//  
+//  2. Redistributions in binary form must reproduce the above copyright notice,
+//  this list of conditions and the following disclaimer in the documentation
+//  and/or other materials provided with the distribution.
+//  
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+//  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+//  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+//  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+//  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+//  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+//  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+//  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+//  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+//  POSSIBILITY OF SUCH DAMAGE.
+//
+
+@import ObjectiveC.runtime;
+
+#import "AMMacros.h"
+
+#import "AMAnimationRegistry.h"
+
+const void *AMAnimationRegistryKey;
+
+@implementation AMAnimationRegistry
+
+#pragma mark - Internals
+
++ (NSMutableDictionary *)animationsOfTarget:(id)target creating:(BOOL)creating {
+    
+    NSMutableDictionary *animations = objc_getAssociatedObject(target, &AMAnimationRegistryKey);
+    
+    if (!animations && creating) {
+        animations = [[NSMutableDictionary alloc] init];
+        objc_setAssociatedObject(target, &AMAnimationRegistryKey, animations, OBJC_ASSOCIATION_RETAIN_NONATOMIC);
+    }
+    
+    return animations;
+    
+}
+
+#pragma mark - Looking Up Animations
+
++ (id<AMAnimation>)animationForTarget:(id)target keyPath:(NSString *)keyPath {
+    
+    AMAssertMainThread();
+    
+    return [self animationsOfTarget:target creating:NO][keyPath];
+    
+}
+
++ (NSArray<id<AMAnimation>> *)animationsForTarget:(id)target {
+    
+    AMAssertMainThread();
+    
+    return [[self animationsOfTarget:target creating:NO] allValues] ?: @[];
+    
+}
+
++ (BOOL)isAnimatingTarget:(id)target keyPath:(NSString *)keyPath {
+    
+    AMAssertMainThread();
+    
+    NSDictionary *animations = [self animationsOfTarget:target creating:NO];
+    
+    return (keyPath ? animations[keyPath] != nil : [animations count] > 0);
+    
+}
+
++ (void)cancelAnimationsForTarget:(id)target {
+    
+    AMAssertMainThread();
+    
+    /* Cancelling unregisters - so iterate a copy. */
+    for (id<AMAnimation> animation in [self animationsForTarget:target])
+        [animation cancelAnimation];
+    
+}
+
+#pragma mark - Registering Animations
+
++ (id<AMAnimation>)registerAnimation:(id<AMAnimation>)animation forTarget:(id)target keyPath:(NSString *)keyPath {
+    
+    AMAssertMainThread();
+    
+    if (!target)
+        return nil;
+    
+    NSMutableDictionary *animations = [self animationsOfTarget:target creating:YES];
+    
+    id<AMAnimation> previous = animations[keyPath];
+    
+    if (previous == animation)
+        return nil;
+    
+    /* Registered before cancelling, so the cancelled animation does not unregister the new one. */
+    animations[keyPath] = animation;
+    
+    [previous cancelAnimation];
+    
+    return previous;
+    
+}
+
++ (void)unregisterAnimation:(id<AMAnimation>)animation forTarget:(id)target keyPath:(NSString *)keyPath {
+    
+    AMAssertMainThread();
+    
+    if (!target)
+        return;
+    
+    NSMutableDictionary *animations = [self animationsOfTarget:target creating:NO];
+    
+    if (animations[keyPath] == animation)
+        [animations removeObjectForKey:keyPath];
+    
+}
+
+@end
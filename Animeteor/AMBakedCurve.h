@@ -0,0 +1,93 @@
+//
+//  AMBakedCurve.h
+//  Animeteor
+//
+//  Copyright (c) 2013-2015, Kristian Trenskow
+//  All rights reserved.
+//  
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are met:
+//  
+//  1. Redistributions of source code must retain the above copyright notice,
+//  this list of conditions and the following disclaimer.
+//  
+//  2. Redistributions in binary form must reproduce the above copyright notice,
+//  this list of conditions and the following disclaimer in the documentation
+//  and/or other materials provided with the distribution.
+//  
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+//  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+//  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+//  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+//  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+//  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+//  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+//  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+//  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+//  POSSIBILITY OF SUCH DAMAGE.
+//
+
+#import "AMCurve.h"
+
+/*!
+ Interpolation methods used when looking up values in a baked curve.
+ */
+typedef NS_ENUM(NSInteger, AMBakedCurveInterpolation) {
+    /*! Looks up values using linear interpolation between neighbouring samples. */
+    AMBakedCurveInterpolationLinear = 0,
+    /*! Looks up values using cubic (Catmull-Rom) interpolation between neighbouring samples. */
+    AMBakedCurveInterpolationCubic
+};
+
+/*!
+ The `AMBakedCurve` class samples another curve into a precomputed table at creation, and looks up positions in the table afterwards. This makes the cost of transforming positions constant and cheap - no matter how expensive the original curve is to evaluate.
+ */
+@interface AMBakedCurve : AMCurve
+
+/// ----------------------------
+/// @name Creating a Baked Curve
+/// ----------------------------
+
+- (instancetype _Nonnull)initWithBlock:(AMCurveBlock _Nonnull)block UNAVAILABLE_ATTRIBUTE;
+
+/*!
+ Returns an initialized baked curve.
+ 
+ @param curve         The curve to bake.
+ @param resolution    The number of intervals in the table. The curve is sampled `resolution + 1` times. Values lower than two are raised to two.
+ @param interpolation The interpolation used when looking up positions between samples.
+ 
+ @return An initialized baked curve.
+ */
+- (instancetype _Nonnull)initWithCurve:(AMCurve * _Nonnull)curve
+                            resolution:(NSUInteger)resolution
+                         interpolation:(AMBakedCurveInterpolation)interpolation;
+
+/// -------------------------------------
+/// @name Getting Baked Curve Information
+/// -------------------------------------
+
+/*!
+ Returns the curve that was baked.
+ */
+@property (nonatomic,readonly,nonnull) AMCurve *sourceCurve;
+
+/*!
+ Returns the number of intervals in the table.
+ */
+@property (nonatomic,readonly) NSUInteger resolution;
+
+/*!
+ Returns the interpolation used when looking up positions between samples.
+ */
+@property (nonatomic,readonly) AMBakedCurveInterpolation interpolation;
+
+/*!
+ Returns the maximum absolute error of the table compared to the source curve.
+ 
+ @discussion The error is measured at several positions between every pair of samples the first time it is requested.
+ */
+@property (nonatomic,readonly) double maximumError;
+
+@end
@@ -0,0 +1,170 @@
+//
+//  AMBakedCurve.m
+//  Animeteor
+//
+//  Copyright (c) 2013-2015, Kristian Trenskow
+//  All rights reserved.
+//  
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are met:
+//  
+//  1. Redistributions of source code must retain the above copyright notice,
+//  this list of conditions and the following disclaimer.
+//  
+//  2. Redistributions in binary form must reproduce the above copyright notice,
+//  this list of conditions and the following disclaimer in the documentation
+//  and/or other materials provided with the distribution.
+//  
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+//  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+//  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+//  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+//  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+//  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+//  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+//  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+//  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+//  POSSIBILITY OF SUCH DAMAGE.
+//
+
+#import "AMBakedCurve.h"
+
+// Number of positions measured between every pair of samples when determining the maximum error.
+#define MEASUREMENTS_PER_INTERVAL 8
+
+@interface AMBakedCurve () {
+    double *_samples;
+    double _maximumError;
+    BOOL _hasMeasuredError;
+}
+
+@end
+
+static inline double AMBakedCurveLookup(const double *samples, NSUInteger resolution, AMBakedCurveInterpolation interpolation, double t) {
+    
+    double x = t * resolution;
+    NSUInteger idx = MIN((NSUInteger)x, resolution - 1);
+    double f = x - idx;
+    
+    double p1 = samples[idx];
+    double p2 = samples[idx + 1];
+    
+    if (interpolation == AMBakedCurveInterpolationLinear)
+        return p1 + (p2 - p1) * f;
+    
+    /* Catmull-Rom - end points are extrapolated linearly. */
+    double p0 = (idx > 0 ? samples[idx - 1] : 2.0 * p1 - p2);
+    double p3 = (idx + 2 <= resolution ? samples[idx + 2] : 2.0 * p2 - p1);
+    
+    return p1 + .5 * f * (p2 - p0 + f * (2.0 * p0 - 5.0 * p1 + 4.0 * p2 - p3 + f * (3.0 * (p1 - p2) + p3 - p0)));
+    
+}
+
+static inline double AMBakedCurveLookupDerivative(const double *samples, NSUInteger resolution, AMBakedCurveInterpolation interpolation, double t) {
+    
+    double x = t * resolution;
+    NSUInteger idx = MIN((NSUInteger)x, resolution - 1);
+    double f = x - idx;
+    
+    double p1 = samples[idx];
+    double p2 = samples[idx + 1];
+    
+    if (interpolation == AMBakedCurveInterpolationLinear)
+        return (p2 - p1) * resolution;
+    
+    double p0 = (idx > 0 ? samples[idx - 1] : 2.0 * p1 - p2);
+    double p3 = (idx + 2 <= resolution ? samples[idx + 2] : 2.0 * p2 - p1);
+    
+    return .5 * (p2 - p0 + f * (2.0 * (2.0 * p0 - 5.0 * p1 + 4.0 * p2 - p3) + 3.0 * f * (3.0 * (p1 - p2) + p3 - p0))) * resolution;
+    
+}
+
+@implementation AMBakedCurve
+
+#pragma mark - Setup / Tear down
+
+- (instancetype)initWithCurve:(AMCurve *)curve resolution:(NSUInteger)resolution interpolation:(AMBakedCurveInterpolation)interpolation {
+    
+    /* The block of a baked curve evaluates the original curve - only the table is used when transforming. */
+    if ((self = [super initWithBlock:^(double t) { return [curve transform:t]; }])) {
+        
+        _sourceCurve = curve;
+        _resolution = MAX(resolution, 2);
+        _interpolation = interpolation;
+        
+        _samples = malloc(sizeof(double) * (_resolution + 1));
+        
+        /* Without memory for the table the curve evaluates the original curve through its block. */
+        if (_samples)
+            for (NSUInteger idx = 0 ; idx <= _resolution ; idx++)
+                _samples[idx] = [curve transform:(double)idx / (double)_resolution];
+        
+    }
+    
+    return self;
+    
+}
+
+- (void)dealloc {
+    
+    free(_samples);
+    
+}
+
+#pragma mark - Properties
+
+- (double)maximumError {
+    
+    if (!_hasMeasuredError) {
+        
+        double maximumError = .0;
+        NSUInteger count = _resolution * MEASUREMENTS_PER_INTERVAL;
+        
+        for (NSUInteger idx = 0 ; idx <= count ; idx++) {
+            double t = (double)idx / (double)count;
+            maximumError = MAX(maximumError, fabs([self transform:t] - [_sourceCurve transform:t]));
+        }
+        
+        _maximumError = maximumError;
+        _hasMeasuredError = YES;
+        
+    }
+    
+    return _maximumError;
+    
+}
+
+#pragma mark - Calculating Curve
+
+- (double)transform:(double)positionInTime {
+    
+    if (!_samples)
+        return [super transform:positionInTime];
+    
+    return AMBakedCurveLookup(_samples, _resolution, _interpolation, MIN(1.0, MAX(.0, positionInTime)));
+    
+}
+
+- (void)transformPositions:(const double *)positions count:(NSUInteger)count output:(double *)output {
+    
+    if (!_samples) {
+        [super transformPositions:positions count:count output:output];
+        return;
+    }
+    
+    for (NSUInteger idx = 0 ; idx < count ; idx++)
+        output[idx] = AMBakedCurveLookup(_samples, _resolution, _interpolation, MIN(1.0, MAX(.0, positions[idx])));
+    
+}
+
+- (double)derivative:(double)positionInTime {
+    
+    if (!_samples)
+        return [super derivative:positionInTime];
+    
+    return AMBakedCurveLookupDerivative(_samples, _resolution, _interpolation, MIN(1.0, MAX(.0, positionInTime)));
+    
+}
+
+@end
@@ -0,0 +1,86 @@
+//
+//  AMBezierCurve.h
+//  Animeteor
+//
+//  Copyright (c) 2013-2015, Kristian Trenskow
+//  All rights reserved.
+//  
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are met:
+//  
+//  1. Redistributions of source code must retain the above copyright notice,
+//  this list of conditions and the following disclaimer.
+//  
+//  2. Redistributions in binary form must reproduce the above copyright notice,
+//  this list of conditions and the following disclaimer in the documentation
+//  and/or other materials provided with the distribution.
+//  
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+//  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+//  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+//  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+//  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+//  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+//  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+//  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+//  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+//  POSSIBILITY OF SUCH DAMAGE.
+//
+
+@import QuartzCore;
+
+#import "AMCurve.h"
+
+/*!
+ The `AMBezierCurve` class provides curves defined by a cubic Bezier with end points at (0, 0) and (1, 1) and two control points - just like `CAMediaTimingFunction` and CSS `cubic-bezier()`. Positions are found using a precomputed sample table and a Newton-Raphson solver that falls back to bisection.
+ */
+@interface AMBezierCurve : AMCurve
+
+/// -----------------------------
+/// @name Creating a Bezier Curve
+/// -----------------------------
+
+- (instancetype _Nonnull)initWithBlock:(AMCurveBlock _Nonnull)block UNAVAILABLE_ATTRIBUTE;
+
+/*!
+ Returns an initialized Bezier curve.
+ 
+ @param c1x The x coordinate of the first control point. Clamped to between zero and one.
+ @param c1y The y coordinate of the first control point.
+ @param c2x The x coordinate of the second control point. Clamped to between zero and one.
+ @param c2y The y coordinate of the second control point.
+ 
+ @return An initialized Bezier curve.
+ */
+- (instancetype _Nonnull)initWithControlPoints:(double)c1x :(double)c1y :(double)c2x :(double)c2y;
+
+/*!
+ Returns an initialized Bezier curve with the same control points as a Core Animation timing function.
+ 
+ @param timingFunction The timing function to copy the control points from.
+ 
+ @return An initialized Bezier curve.
+ */
+- (instancetype _Nonnull)initWithTimingFunction:(CAMediaTimingFunction * _Nonnull)timingFunction;
+
+/// --------------------------------------
+/// @name Getting Bezier Curve Information
+/// --------------------------------------
+
+/*!
+ Returns the first control point.
+ */
+@property (nonatomic,readonly) CGPoint controlPoint1;
+
+/*!
+ Returns the second control point.
+ */
+@property (nonatomic,readonly) CGPoint controlPoint2;
+
+/*!
+ Returns a Core Animation timing function with the same control points as the curve.
+ */
+@property (nonatomic,readonly,nonnull) CAMediaTimingFunction *timingFunction;
+
+@end
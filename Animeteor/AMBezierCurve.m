@@ -0,0 +1,103 @@
+//
+//  AMBezierCurve.m
+//  Animeteor
+//
+//  Copyright (c) 2013-2015, Kristian Trenskow
+//  All rights reserved.
+//  
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are met:
+//  
+//  1. Redistributions of source code must retain the above copyright notice,
+//  this list of conditions and the following disclaimer.
+//  
+//  2. Redistributions in binary form must reproduce the above copyright notice,
+//  this list of conditions and the following disclaimer in the documentation
+//  and/or other materials provided with the distribution.
+//  
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+//  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+//  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+//  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+//  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+//  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+//  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+//  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+//  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+//  POSSIBILITY OF SUCH DAMAGE.
+//
+
+#import "AMBezierCurve.h"
+
+@interface AMBezierCurve () {
+    AMCubicBezier _bezier;
+}
+
+@end
+
+@implementation AMBezierCurve
+
+#pragma mark - Setup / Tear down
+
+- (instancetype)initWithControlPoints:(double)c1x :(double)c1y :(double)c2x :(double)c2y {
+    
+    AMCubicBezier bezier = AMCubicBezierMake(c1x, c1y, c2x, c2y);
+    
+    if ((self = [super initWithBlock:^(double t) { return AMCubicBezierTransform(&bezier, t); }])) {
+        
+        _bezier = bezier;
+        _controlPoint1 = CGPointMake(MIN(1.0, MAX(.0, c1x)), c1y);
+        _controlPoint2 = CGPointMake(MIN(1.0, MAX(.0, c2x)), c2y);
+        
+    }
+    
+    return self;
+    
+}
+
+- (instancetype)initWithTimingFunction:(CAMediaTimingFunction *)timingFunction {
+    
+    float c1[2];
+    float c2[2];
+    
+    [timingFunction getControlPointAtIndex:1 values:c1];
+    [timingFunction getControlPointAtIndex:2 values:c2];
+    
+    return [self initWithControlPoints:c1[0] :c1[1] :c2[0] :c2[1]];
+    
+}
+
+#pragma mark - Properties
+
+- (CAMediaTimingFunction *)timingFunction {
+    
+    return [CAMediaTimingFunction functionWithControlPoints:self.controlPoint1.x
+                                                           :self.controlPoint1.y
+                                                           :self.controlPoint2.x
+                                                           :self.controlPoint2.y];
+    
+}
+
+#pragma mark - Calculating Curve
+
+- (double)transform:(double)positionInTime {
+    
+    return AMCubicBezierTransform(&_bezier, positionInTime);
+    
+}
+
+- (void)transformPositions:(const double *)positions count:(NSUInteger)count output:(double *)output {
+    
+    for (NSUInteger idx = 0 ; idx < count ; idx++)
+        output[idx] = AMCubicBezierTransform(&_bezier, positions[idx]);
+    
+}
+
+- (double)derivative:(double)positionInTime {
+    
+    return AMCubicBezierDerivative(&_bezier, positionInTime);
+    
+}
+
+@end
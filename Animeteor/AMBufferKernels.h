@@ -0,0 +1,133 @@
+//
+//  AMBufferKernels.h
+//  Animeteor
+//
+//  Copyright (c) 2013-2015, Kristian Trenskow
+//  All rights reserved.
+//  
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are met:
+//  
+//  1. Redistributions of source code must retain the above copyright notice,
+//  this list of conditions and the following disclaimer.
+//  
+//  2. Redistributions in binary form must reproduce the above copyright notice,
+//  this list of conditions and the following disclaimer in the documentation
+//  and/or other materials provided with the distribution.
+//  
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+//  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+//  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+//  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+//  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+//  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+//  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+//  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+//  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+//  POSSIBILITY OF SUCH DAMAGE.
+//
+
+/*
+ Element wise math of packed buffers of floats or doubles as plain C functions - used to interpolate large numeric buffers in place. Buffers are processed in SIMD lanes, which are loaded and stored by `memcpy` - so buffers need no particular alignment. This header does not depend on the Objective-C runtime - it only requires the C standard library and a compiler that supports the GCC/Clang vector extensions.
+ */
+
+#ifndef AMBufferKernels_h
+#define AMBufferKernels_h
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+    
+// MARK: - Lanes
+    
+// Four floats or two doubles processed at once - maps to SIMD registers on both ARM and Intel.
+typedef float AMBufferFloatLanes __attribute__((vector_size(4 * sizeof(float))));
+typedef int AMBufferFloatMask __attribute__((vector_size(4 * sizeof(int))));
+typedef double AMBufferDoubleLanes __attribute__((vector_size(2 * sizeof(double))));
+typedef long long AMBufferDoubleMask __attribute__((vector_size(2 * sizeof(long long))));
+    
+// MARK: - Kernels
+    
+// Full lanes are loaded and stored with a constant size - the last elements of a buffer are processed in a partial lane, padded with zeros.
+#define AM_BUFFER_FOR_LANES(type, lanes, count, ...) \
+    { \
+        const size_t width = sizeof(lanes) / sizeof(type); \
+        size_t idx = 0; \
+        for ( ; idx + width <= count ; idx += width) { \
+            const size_t size = sizeof(lanes); \
+            __VA_ARGS__ \
+        } \
+        if (idx < count) { \
+            const size_t size = sizeof(type) * (count - idx); \
+            __VA_ARGS__ \
+        } \
+    }
+    
+#define AM_BUFFER_KERNELS(name, type, lanes, mask) \
+static inline void AMBufferSubtract##name(const type *a, const type *b, type *output, size_t count) { \
+    AM_BUFFER_FOR_LANES(type, lanes, count, \
+        lanes x = { 0 }, y = { 0 }; \
+        memcpy(&x, a + idx, size); \
+        memcpy(&y, b + idx, size); \
+        x = y - x; \
+        memcpy(output + idx, &x, size); \
+    ) \
+} \
+static inline void AMBufferLerp##name(const type *from, const type *delta, double position, type *output, size_t count) { \
+    lanes t = { 0 }; \
+    t += (type)position; \
+    AM_BUFFER_FOR_LANES(type, lanes, count, \
+        lanes x = { 0 }, d = { 0 }; \
+        memcpy(&x, from + idx, size); \
+        memcpy(&d, delta + idx, size); \
+        x = d * t + x; \
+        memcpy(output + idx, &x, size); \
+    ) \
+} \
+static inline void AMBufferMix##name(const type *a, const type *b, double position, type *output, size_t count) { \
+    lanes t = { 0 }; \
+    t += (type)position; \
+    AM_BUFFER_FOR_LANES(type, lanes, count, \
+        lanes x = { 0 }, y = { 0 }; \
+        memcpy(&x, a + idx, size); \
+        memcpy(&y, b + idx, size); \
+        x = (y - x) * t + x; \
+        memcpy(output + idx, &x, size); \
+    ) \
+} \
+static inline bool AMBufferDiffers##name(const type *a, const type *b, double threshold, size_t count) { \
+    lanes limit = { 0 }; \
+    limit += (type)threshold; \
+    mask differs = { 0 }; \
+    AM_BUFFER_FOR_LANES(type, lanes, count, \
+        lanes x = { 0 }, y = { 0 }; \
+        memcpy(&x, a + idx, size); \
+        memcpy(&y, b + idx, size); \
+        x -= y; \
+        differs |= (mask)(x >= limit) | (mask)(-x >= limit); \
+    ) \
+    for (size_t idx = 0 ; idx < sizeof(lanes) / sizeof(type) ; idx++) \
+        if (differs[idx]) \
+            return true; \
+    return false; \
+}
+    
+/*
+ AMBufferSubtractFloats / AMBufferSubtractDoubles - writes `b - a` to `output`.
+ AMBufferLerpFloats / AMBufferLerpDoubles - writes `delta * position + from` to `output`, which may be `from`.
+ AMBufferMixFloats / AMBufferMixDoubles - writes `(b - a) * position + a` to `output`, which may be `a` or `b`.
+ AMBufferDiffersFloats / AMBufferDiffersDoubles - returns whether any element of `a` differs from the element of `b` by `threshold` or more.
+ */
+AM_BUFFER_KERNELS(Floats, float, AMBufferFloatLanes, AMBufferFloatMask)
+AM_BUFFER_KERNELS(Doubles, double, AMBufferDoubleLanes, AMBufferDoubleMask)
+    
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* AMBufferKernels_h */
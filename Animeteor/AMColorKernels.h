@@ -0,0 +1,168 @@
+//
+//  AMColorKernels.h
+//  Animeteor
+//
+//  Copyright (c) 2013-2015, Kristian Trenskow
+//  All rights reserved.
+//  
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are met:
+//  
+//  1. Redistributions of source code must retain the above copyright notice,
+//  this list of conditions and the following disclaimer.
+//  
+//  2. Redistributions in binary form must reproduce the above copyright notice,
+//  this list of conditions and the following disclaimer in the documentation
+//  and/or other materials provided with the distribution.
+//  
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+//  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+//  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+//  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+//  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+//  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+//  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+//  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+//  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+//  POSSIBILITY OF SUCH DAMAGE.
+//
+
+/*
+ Conversion of colors between sRGB, linear RGB and OKLab as plain C functions. Colors are four components - the color and a straight (not premultiplied) alpha, which is passed through unchanged. sRGB components outside zero and one (extended sRGB) are converted by mirroring the transfer function. This header does not depend on the Objective-C runtime.
+ */
+
+#ifndef AMColorKernels_h
+#define AMColorKernels_h
+
+#include <math.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+    
+/*!
+ Identifies the color space in which colors are interpolated.
+ */
+typedef enum {
+    /*! Gamma encoded sRGB - like Core Animation interpolates colors. */
+    AMColorSpaceSRGB = 0,
+    /*! Linear light sRGB - blends like light mixes. */
+    AMColorSpaceLinearRGB,
+    /*! The perceptual OKLab space - lightness and hue change evenly. */
+    AMColorSpaceOKLab
+} AMColorSpace;
+    
+// MARK: - Transfer Functions
+    
+static inline double AMColorSRGBDecode(double value) {
+    double magnitude = fabs(value);
+    double decoded = (magnitude <= 0.04045 ? magnitude / 12.92 : pow((magnitude + 0.055) / 1.055, 2.4));
+    return copysign(decoded, value);
+}
+    
+static inline double AMColorSRGBEncode(double value) {
+    double magnitude = fabs(value);
+    double encoded = (magnitude <= 0.0031308 ? magnitude * 12.92 : 1.055 * pow(magnitude, 1.0 / 2.4) - 0.055);
+    return copysign(encoded, value);
+}
+    
+// MARK: - OKLab
+    
+static inline void AMColorLinearRGBToOKLab(const double *rgb, double *lab) {
+        
+    double l = cbrt(0.4122214708 * rgb[0] + 0.5363325363 * rgb[1] + 0.0514459929 * rgb[2]);
+    double m = cbrt(0.2119034982 * rgb[0] + 0.6806995451 * rgb[1] + 0.1073969566 * rgb[2]);
+    double s = cbrt(0.0883024619 * rgb[0] + 0.2817188376 * rgb[1] + 0.6299787005 * rgb[2]);
+        
+    lab[0] = 0.2104542553 * l + 0.7936177850 * m - 0.0040720468 * s;
+    lab[1] = 1.9779984951 * l - 2.4285922050 * m + 0.4505937099 * s;
+    lab[2] = 0.0259040371 * l + 0.7827717662 * m - 0.8086757660 * s;
+        
+}
+    
+static inline void AMColorOKLabToLinearRGB(const double *lab, double *rgb) {
+        
+    double l = lab[0] + 0.3963377774 * lab[1] + 0.2158037573 * lab[2];
+    double m = lab[0] - 0.1055613458 * lab[1] - 0.0638541728 * lab[2];
+    double s = lab[0] - 0.0894841775 * lab[1] - 1.2914855480 * lab[2];
+        
+    l = l * l * l;
+    m = m * m * m;
+    s = s * s * s;
+        
+    rgb[0] = 4.0767416621 * l - 3.3077115913 * m + 0.2309699292 * s;
+    rgb[1] = -1.2684380046 * l + 2.6097574011 * m - 0.3413193965 * s;
+    rgb[2] = -0.0041960863 * l - 0.7034186147 * m + 1.7076147010 * s;
+        
+}
+    
+// MARK: - Color Spaces
+    
+/*!
+ Converts an sRGB color into a color space.
+ */
+static inline void AMColorFromSRGB(AMColorSpace space, const double *rgba, double *color) {
+        
+    if (space == AMColorSpaceSRGB) {
+        for (int i = 0 ; i < 4 ; i++)
+            color[i] = rgba[i];
+        return;
+    }
+        
+    double linear[3] = { AMColorSRGBDecode(rgba[0]), AMColorSRGBDecode(rgba[1]), AMColorSRGBDecode(rgba[2]) };
+        
+    if (space == AMColorSpaceOKLab)
+        AMColorLinearRGBToOKLab(linear, color);
+    else
+        for (int i = 0 ; i < 3 ; i++)
+            color[i] = linear[i];
+        
+    color[3] = rgba[3];
+        
+}
+    
+/*!
+ Converts a color of a color space into sRGB.
+ */
+static inline void AMColorToSRGB(AMColorSpace space, const double *color, double *rgba) {
+        
+    if (space == AMColorSpaceSRGB) {
+        for (int i = 0 ; i < 4 ; i++)
+            rgba[i] = color[i];
+        return;
+    }
+        
+    double linear[3];
+        
+    if (space == AMColorSpaceOKLab)
+        AMColorOKLabToLinearRGB(color, linear);
+    else
+        for (int i = 0 ; i < 3 ; i++)
+            linear[i] = color[i];
+        
+    for (int i = 0 ; i < 3 ; i++)
+        rgba[i] = AMColorSRGBEncode(linear[i]);
+        
+    rgba[3] = color[3];
+        
+}
+    
+/*!
+ Interpolates a color prepared by `AMColorFromSRGB` - `delta` being the difference to the other color - and converts the result into sRGB.
+ */
+static inline void AMColorInterpolate(AMColorSpace space, const double *from, const double *delta, double position, double *rgba) {
+        
+    double color[4];
+    for (int i = 0 ; i < 4 ; i++)
+        color[i] = delta[i] * position + from[i];
+        
+    AMColorToSRGB(space, color, rgba);
+        
+}
+    
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* AMColorKernels_h */
@@ -30,6 +30,8 @@
 
 @import Foundation;
 
+#import "AMCurveKernels.h"
+
 /*!
  A prototype that defines an animation block.
  
@@ -281,6 +283,15 @@ typedef double (^AMCurveBlock)(double t);
  */
 - (instancetype _Nonnull)initWithBlock:(AMCurveBlock _Nonnull)block;
 
+/// -------------------------------
+/// @name Getting Curve Information
+/// -------------------------------
+
+/*!
+ Returns the function of the curve. Build-in curves returns the function they evaluate - which can be used with the functions of `AMCurveKernels.h` directly. Curves created using a block or by subclassing returns `AMCurveFunctionCustom`.
+ */
+@property (nonatomic,readonly) AMCurveFunction function;
+
 /// ------------------------
 /// @name Calculating Curves
 /// ------------------------
@@ -296,4 +307,26 @@ typedef double (^AMCurveBlock)(double t);
  */
 - (double)transform:(double)positionInTime;
 
+/*!
+ Transforms a buffer of values in time into curved positions.
+ 
+ @param positions Positions in time between one and zero.
+ @param count     The number of positions in the buffer.
+ @param output    A buffer of at least `count` elements that receives the positions on the curve. This can be the same buffer as `positions`.
+ 
+ @discussion The build-in curves transforms several positions at once using vector instructions - except the sine, expo and elastic curves, which are transformed one position at a time. Curves created using a block or by subclassing transforms one position at a time using `transform:` - override this if your subclass can do better.
+ */
+- (void)transformPositions:(const double * _Nonnull)positions count:(NSUInteger)count output:(double * _Nonnull)output;
+
+/*!
+ Returns the slope of the curve at a value in time - the rate of change in position per unit of time.
+ 
+ @param positionInTime Position in time between one and zero.
+ 
+ @discussion The build-in curves compute the derivative analytically. Curves created using a block or by subclassing are differentiated numerically from a table of `transform:` samples, which is built the first time the derivative is requested - override this if your subclass can do better.
+ 
+ @return The derivative of the curve at `positionInTime`. Curves with a vertical tangent returns infinity.
+ */
+- (double)derivative:(double)positionInTime;
+
 @end
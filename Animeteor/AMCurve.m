@@ -30,19 +30,26 @@
 
 #import "AMCurve.h"
 
+// Number of intervals in the table used to differentiate custom curves.
+#define DERIVATIVE_RESOLUTION 256
+
 // Convinience macro for returning a singleton in build-in the curve class methods.
-#define RETURN_SINGLETON(b) \
+#define RETURN_SINGLETON(f) \
 static AMCurve *curve; \
 static dispatch_once_t onceToken; \
 dispatch_once(&onceToken, ^{ \
-curve = [[AMCurve alloc] initWithBlock:b]; \
+curve = [[AMCurve alloc] initWithFunction:f]; \
 }); \
 return curve
 
-@interface AMCurve ()
+@interface AMCurve () {
+    double *_derivatives;
+}
 
 @property (nonatomic,copy) AMCurveBlock block;
 
+- (instancetype)initWithFunction:(AMCurveFunction)function;
+
 @end
 
 @implementation AMCurve
@@ -50,328 +57,234 @@ return curve
 #pragma mark - Build-in Curves
 
 + (AMCurve *)linear {
-    RETURN_SINGLETON(^(double t) {
-        return t;
-    });
+    RETURN_SINGLETON(AMCurveFunctionLinear);
 }
 
 + (AMCurve *)easeInQuad {
-    RETURN_SINGLETON(^(double t) {
-        return pow(t, 2.0);
-    });
+    RETURN_SINGLETON(AMCurveFunctionEaseInQuad);
 }
 
 + (AMCurve *)easeOutQuad {
-    RETURN_SINGLETON(^(double t) {
-        return -1.0 * t * (t - 2.0);
-    });
+    RETURN_SINGLETON(AMCurveFunctionEaseOutQuad);
 }
 
 + (AMCurve *)easeInOutQuad {
-    RETURN_SINGLETON(^(double t) {
-        t /= .5;
-        if (t < 1.0) return .5 * pow(t, 2.0);
-        t -= 1.0;
-        return -.5 * (t*(t - 2.0) - 1.0);
-    });
+    RETURN_SINGLETON(AMCurveFunctionEaseInOutQuad);
 }
 
 + (AMCurve *)easeInCubic {
-    RETURN_SINGLETON(^(double t) {
-        return pow(t, 3.0);
-    });
+    RETURN_SINGLETON(AMCurveFunctionEaseInCubic);
 }
 
 + (AMCurve *)easeOutCubic {
-    RETURN_SINGLETON(^(double t) {
-        t = t - 1.0;
-        return pow(t, 3.0) + 1;
-    });
+    RETURN_SINGLETON(AMCurveFunctionEaseOutCubic);
 }
 
 + (AMCurve *)easeInOutCubic {
-    
-    AMCurve *easeInCubic = [self easeInCubic];
-    AMCurve *easeOutCubic = [self easeOutCubic];
-    
-    RETURN_SINGLETON(^(double t) {
-        if (t < .5) return [easeInCubic transform:t * 2.0] / 2.0;
-        return [easeOutCubic transform:(t - .5) * 2.0] / 2.0 + .5;
-    });
-    
+    RETURN_SINGLETON(AMCurveFunctionEaseInOutCubic);
 }
 
 + (AMCurve *)easeInQuart {
-    RETURN_SINGLETON(^(double t) {
-        return pow(t, 4.0);
-    });
+    RETURN_SINGLETON(AMCurveFunctionEaseInQuart);
 }
 
 + (AMCurve *)easeOutQuart {
-    RETURN_SINGLETON(^(double t) {
-        t -= 1.0;
-        return -1.0 * (pow(t, 4.0) - 1);
-    });
+    RETURN_SINGLETON(AMCurveFunctionEaseOutQuart);
 }
 
 + (AMCurve *)easeInOutQuart {
-    RETURN_SINGLETON(^(double t) {
-        t /= .5;
-        if (t < 1.0) return .5 * pow(t, 4.0);
-        t -= 2.0;
-        return -.5 * (pow(t, 4.0) - 2.0);
-    });
+    RETURN_SINGLETON(AMCurveFunctionEaseInOutQuart);
 }
 
 + (AMCurve *)easeInQuint {
-    RETURN_SINGLETON(^(double t) {
-        return pow(t, 5.0);
-    });
+    RETURN_SINGLETON(AMCurveFunctionEaseInQuint);
 }
 
 + (AMCurve *)easeOutQuint {
-    RETURN_SINGLETON(^(double t) {
-        t -= 1.0;
-        return 1.0 * (pow(t, 5.0) + 1.0);
-    });
+    RETURN_SINGLETON(AMCurveFunctionEaseOutQuint);
 }
 
 + (AMCurve *)easeInOutQuint {
-    RETURN_SINGLETON(^(double t) {
-        t /= .5;
-        if (t < 1) return .5*pow(t, 5.0);
-        t -= 2.0;
-        return .5 * (pow(t, 5.0) + 2.0);
-    });
+    RETURN_SINGLETON(AMCurveFunctionEaseInOutQuint);
 }
 
 + (AMCurve *)easeInSine {
-    RETURN_SINGLETON(^(double t) {
-        return (-1.0 * cos(t * M_PI_2) + 1.0);
-    });
+    RETURN_SINGLETON(AMCurveFunctionEaseInSine);
 }
 
 + (AMCurve *)easeOutSine {
-    RETURN_SINGLETON(^(double t) {
-        return sin(t * M_PI_2);
-    });
+    RETURN_SINGLETON(AMCurveFunctionEaseOutSine);
 }
 
 + (AMCurve *)easeInOutSine {
-    RETURN_SINGLETON(^(double t) {
-        return (-.5 * cos(M_PI*t) + .5);
-    });
+    RETURN_SINGLETON(AMCurveFunctionEaseInOutSine);
 }
 
 + (AMCurve *)easeInExpo {
-    RETURN_SINGLETON(^(double t) {
-        return (t == 0 ? .0 : pow(2.0, 10.0 * (t - 1.0)));
-    });
+    RETURN_SINGLETON(AMCurveFunctionEaseInExpo);
 }
 
 + (AMCurve *)easeOutExpo {
-    RETURN_SINGLETON(^(double t) {
-        return -pow(2.0, -10.0 * t) + 1.0;
-    });
+    RETURN_SINGLETON(AMCurveFunctionEaseOutExpo);
 }
 
 + (AMCurve *)easeInOutExpo {
-    RETURN_SINGLETON(^(double t) {
-        if (t == .0) return .0;
-        if (t == 1.0) return 1.0;
-        t /= .5;
-        if (t < 1) return .5 * pow(2, 10 * (t - 1));
-        return .5 * (-pow(2, -10 * --t) + 2);
-    });
+    RETURN_SINGLETON(AMCurveFunctionEaseInOutExpo);
 }
 
 + (AMCurve *)easeInCirc {
-    RETURN_SINGLETON(^(double t) {
-        return -1.0 * (sqrt(1.0 - pow(t, 2.0)) - 1.0);
-    });
+    RETURN_SINGLETON(AMCurveFunctionEaseInCirc);
 }
 
 + (AMCurve *)easeOutCirc {
-    RETURN_SINGLETON(^(double t) {
-        return sqrt(1.0 - pow(t-1.0, 2));
-    });
+    RETURN_SINGLETON(AMCurveFunctionEaseOutCirc);
 }
 
 + (AMCurve *)easeInOutCirc {
-    RETURN_SINGLETON(^(double t) {
-        t /= .5;
-        if (t < 1.0) return -.5 * (sqrt(1.0 - pow(t, 2.0)) - 1.0);
-        return .5 * (sqrt(1.0 - pow(t - 2.0, 2.0)) + 1.0);
-    });
+    RETURN_SINGLETON(AMCurveFunctionEaseInOutCirc);
 }
 
 + (AMCurve *)easeInElastic {
-    RETURN_SINGLETON(^(double t) {
-        
-        double s = 1.70158;
-        double p = .0;
-        double a = 1.0;
-        
-        if (t == 0.0)
-            return .0;
-        if (t == 1.0)
-            return 1.0;
-        if (!p)
-            p = .3;
-        if (a < 1.0) {
-            a = 1.0;
-            s=p / 4.0;
-        } else
-            s = p / (2.0 * M_PI) * asin(1.0/a);
-        
-        t -= 1.0;
-        
-        return -(a * pow(2.0, 10.0 * t) * sin((t - s) * (2.0 * M_PI) / p));
-        
-    });
+    RETURN_SINGLETON(AMCurveFunctionEaseInElastic);
 }
 
 + (AMCurve *)easeOutElastic {
-    RETURN_SINGLETON(^(double t) {
-        
-        double s = 1.70158;
-        double p = .0;
-        double a = 1.0;
-        if (t==0)
-            return .0;
-        if (t==1)
-            return 1.0;
-        if (!p)
-            p=.3;
-        if (a < 1.0) {
-            a=1.0;
-            s=p/4;
-        } else
-            s = p / (2.0 * M_PI) * asin(1.0 / a);
-        return a * pow(2.0, -10.0 * t) * sin((t - s) * (2 * M_PI) / p) + 1.0;
-        
-    });
+    RETURN_SINGLETON(AMCurveFunctionEaseOutElastic);
 }
 
 + (AMCurve *)easeInOutElastic {
-    RETURN_SINGLETON(^(double t) {
-        double s = 1.70158;
-        double p = 0;
-        double a = 1.0;
-        if (t == 0.0)
-            return .0;
-        t /= .5;
-        if (t == 2.0)
-            return 1.0;
-        if (!p)
-            p = (.3 * 1.5);
-        
-        if (a < 1.0) {
-            a = 1.0;
-            s = p / 4.0;
-        }
-        else
-            s = p / (2.0 * M_PI) * asin (1.0 / a);
-        if (t < 1) {
-            t -= 1.0;
-            return -.5 * (a * pow(2.0,10.0 * t) * sin((t - s) * (2.0 * M_PI) / p));
-        }
-        t -= 1.0;
-        return a * pow(2.0, -10.0 * t) * sin((t - s) * (2.0 * M_PI) / p) *.5 + 1.0;
-    });
+    RETURN_SINGLETON(AMCurveFunctionEaseInOutElastic);
 }
 
 + (AMCurve *)easeInBack {
-    RETURN_SINGLETON(^(double t) {
-        return t*t*(2.70158*t - 1.70158);
-    });
+    RETURN_SINGLETON(AMCurveFunctionEaseInBack);
 }
 
 + (AMCurve *)easeOutBack {
-    RETURN_SINGLETON(^(double t) {
-        t -= 1.0;
-        return t*t*((1.70158f+1)*t + 1.70158f) + 1;
-        
-    });
+    RETURN_SINGLETON(AMCurveFunctionEaseOutBack);
 }
 
 + (AMCurve *)easeInOutBack {
-    RETURN_SINGLETON(^(double t) {
-        
-        double s = 1.70158f * 1.525f;
-        t /= .5;
-        
-        if (t < 1.0)
-            return (.5*(t*t*(((s)+1)*t - s)));
-        
-        t -= 2;
-        return .5* ((t * t * ((s+1) * t + s) + 2));
-        
-    });
+    RETURN_SINGLETON(AMCurveFunctionEaseInOutBack);
 }
 
 + (AMCurve *)easeInBounce {
-    
-    AMCurve *easeOutBounceCurve = [self easeOutBounce];
-    
-    RETURN_SINGLETON(^(double t) {
-        return 1.0 - [easeOutBounceCurve transform:1.0 - t];
-    });
-    
+    RETURN_SINGLETON(AMCurveFunctionEaseInBounce);
 }
 
 + (AMCurve *)easeOutBounce {
-    RETURN_SINGLETON(^(double t) {
-        
-        double r = 0.0;
-        
-        if (t < (1/2.75)) {
-            r = 7.5625*t*t;
-        } else if (t < (2/2.75)) {
-            t -= 1.5 / 2.75;
-            r = 7.5625*t*t + .75;
-        } else if (t < (2.5/2.75)) {
-            t -= 2.25 / 2.75;
-            r = 7.5625*t*t + .9375;
-        } else {
-            t -= 2.625 / 2.75;
-            r = 7.5625*t*t + .984375;
-        }
-        
-        return r;
-        
-    });
+    RETURN_SINGLETON(AMCurveFunctionEaseOutBounce);
 }
 
 + (AMCurve *)easeInOutBounce {
+    RETURN_SINGLETON(AMCurveFunctionEaseInOutBounce);
+}
+
+#pragma mark - Setup / Tear down
+
+- (instancetype)initWithFunction:(AMCurveFunction)function {
     
-    AMCurve *easeInBounceCurve = [self easeInBounce];
-    AMCurve *easeOutBounceCurve = [self easeOutBounce];
+    if ((self = [super init]))
+        _function = function;
     
-    RETURN_SINGLETON(^(double t) {
-        if (t < .5) return [easeInBounceCurve transform:t * 2.0] * .5;
-        return [easeOutBounceCurve transform:t * 2.0 - 1.0] * .5 + .5;
-    });
+    return self;
     
 }
 
-#pragma mark - Setup / Tear down
-
 - (instancetype)initWithBlock:(AMCurveBlock)block {
     
-    if ((self = [super init]))
+    if ((self = [super init])) {
+        _function = AMCurveFunctionCustom;
         _block = [block copy];
+    }
     
     return self;
     
 }
 
+- (void)dealloc {
+    
+    free(_derivatives);
+    
+}
+
 #pragma mark - Calculating Curve
 
 - (double)transform:(double)positionInTime {
     
+    if (_function != AMCurveFunctionCustom)
+        return AMCurveFunctionTransform(_function, positionInTime);
+    
     return self.block(MIN(1.0, MAX(.0, positionInTime)));
     
 }
 
+- (void)transformPositions:(const double *)positions count:(NSUInteger)count output:(double *)output {
+    
+    if (_function != AMCurveFunctionCustom) {
+        AMCurveFunctionTransformBatch(_function, positions, output, count);
+        return;
+    }
+    
+    /* Curves without a build-in kernel are transformed one position at a time. */
+    double (*transform)(id, SEL, double) = (double (*)(id, SEL, double))[self methodForSelector:@selector(transform:)];
+    
+    for (NSUInteger idx = 0 ; idx < count ; idx++)
+        output[idx] = transform(self, @selector(transform:), positions[idx]);
+    
+}
+
+- (double)derivative:(double)positionInTime {
+    
+    double t = MIN(1.0, MAX(.0, positionInTime));
+    
+    if (_function != AMCurveFunctionCustom)
+        return AMCurveFunctionDerivative(_function, t);
+    
+    /* The table is published once with a compare and swap - so reads take no lock. Threads racing to build it discard their copy. */
+    double *derivatives = __atomic_load_n(&_derivatives, __ATOMIC_ACQUIRE);
+    
+    if (!derivatives) {
+        
+        /* Central differences of the sampled curve - one-sided at the end points. */
+        double *positions = malloc(sizeof(double) * (DERIVATIVE_RESOLUTION + 1));
+        derivatives = malloc(sizeof(double) * (DERIVATIVE_RESOLUTION + 1));
+        
+        /* Without memory for the table the difference is taken around the position alone. */
+        if (!positions || !derivatives) {
+            free(positions);
+            free(derivatives);
+            double lower = MAX(t - 1.0 / DERIVATIVE_RESOLUTION, .0);
+            double upper = MIN(t + 1.0 / DERIVATIVE_RESOLUTION, 1.0);
+            return ([self transform:upper] - [self transform:lower]) / (upper - lower);
+        }
+        
+        for (NSUInteger idx = 0 ; idx <= DERIVATIVE_RESOLUTION ; idx++)
+            positions[idx] = (double)idx / (double)DERIVATIVE_RESOLUTION;
+        
+        [self transformPositions:positions count:DERIVATIVE_RESOLUTION + 1 output:positions];
+        
+        for (NSUInteger idx = 0 ; idx <= DERIVATIVE_RESOLUTION ; idx++) {
+            NSUInteger lower = (idx > 0 ? idx - 1 : 0);
+            NSUInteger upper = MIN(idx + 1, DERIVATIVE_RESOLUTION);
+            derivatives[idx] = (positions[upper] - positions[lower]) * DERIVATIVE_RESOLUTION / (double)(upper - lower);
+        }
+        
+        free(positions);
+        
+        if (!__sync_bool_compare_and_swap(&_derivatives, NULL, derivatives)) {
+            free(derivatives);
+            derivatives = __atomic_load_n(&_derivatives, __ATOMIC_ACQUIRE);
+        }
+        
+    }
+    
+    double x = t * DERIVATIVE_RESOLUTION;
+    NSUInteger idx = MIN((NSUInteger)x, DERIVATIVE_RESOLUTION - 1);
+    double f = x - idx;
+    
+    return derivatives[idx] + (derivatives[idx + 1] - derivatives[idx]) * f;
+    
+}
+
 @end
@@ -0,0 +1,1165 @@
+//
+//  AMCurveKernels.h
+//  Animeteor
+//
+//  Copyright (c) 2013-2015, Kristian Trenskow
+//  All rights reserved.
+//  
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are met:
+//  
+//  1. Redistributions of source code must retain the above copyright notice,
+//  this list of conditions and the following disclaimer.
+//  
+//  2. Redistributions in binary form must reproduce the above copyright notice,
+//  this list of conditions and the following disclaimer in the documentation
+//  and/or other materials provided with the distribution.
+//  
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+//  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+//  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+//  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+//  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+//  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+//  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+//  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+//  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+//  POSSIBILITY OF SUCH DAMAGE.
+//
+
+/*
+ The math of the build-in curves as plain C functions. This header does not depend on the Objective-C runtime - it only requires the C standard library and a compiler that supports the GCC/Clang vector extensions.
+ */
+
+#ifndef AMCurveKernels_h
+#define AMCurveKernels_h
+
+#include <math.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+    
+/*!
+ Identifies the function of a curve. Curves created using a block or by subclassing are of the custom function.
+ */
+typedef enum {
+    AMCurveFunctionCustom = 0,
+    AMCurveFunctionLinear,
+    AMCurveFunctionEaseInQuad,
+    AMCurveFunctionEaseOutQuad,
+    AMCurveFunctionEaseInOutQuad,
+    AMCurveFunctionEaseInCubic,
+    AMCurveFunctionEaseOutCubic,
+    AMCurveFunctionEaseInOutCubic,
+    AMCurveFunctionEaseInQuart,
+    AMCurveFunctionEaseOutQuart,
+    AMCurveFunctionEaseInOutQuart,
+    AMCurveFunctionEaseInQuint,
+    AMCurveFunctionEaseOutQuint,
+    AMCurveFunctionEaseInOutQuint,
+    AMCurveFunctionEaseInSine,
+    AMCurveFunctionEaseOutSine,
+    AMCurveFunctionEaseInOutSine,
+    AMCurveFunctionEaseInExpo,
+    AMCurveFunctionEaseOutExpo,
+    AMCurveFunctionEaseInOutExpo,
+    AMCurveFunctionEaseInCirc,
+    AMCurveFunctionEaseOutCirc,
+    AMCurveFunctionEaseInOutCirc,
+    AMCurveFunctionEaseInElastic,
+    AMCurveFunctionEaseOutElastic,
+    AMCurveFunctionEaseInOutElastic,
+    AMCurveFunctionEaseInBack,
+    AMCurveFunctionEaseOutBack,
+    AMCurveFunctionEaseInOutBack,
+    AMCurveFunctionEaseInBounce,
+    AMCurveFunctionEaseOutBounce,
+    AMCurveFunctionEaseInOutBounce,
+    AMCurveFunctionCount
+} AMCurveFunction;
+    
+// MARK: - Constants
+    
+#define AM_CURVE_PI 3.14159265358979323846264338327950288
+#define AM_CURVE_PI_2 1.57079632679489661923132169163975144
+#define AM_CURVE_LN2 0.693147180559945309417232121458176568
+    
+// The elastic curves have an amplitude of one, so the shift (p / (2 * PI) * asin(1 / a)) is a quarter of the period.
+#define AM_CURVE_ELASTIC_PERIOD .3
+#define AM_CURVE_ELASTIC_SHIFT (AM_CURVE_ELASTIC_PERIOD / 4.0)
+#define AM_CURVE_ELASTIC_IN_OUT_PERIOD (.3 * 1.5)
+#define AM_CURVE_ELASTIC_IN_OUT_SHIFT (AM_CURVE_ELASTIC_IN_OUT_PERIOD / 4.0)
+    
+// The back curves overshoot by 10 percent.
+#define AM_CURVE_BACK_OVERSHOOT 1.70158f
+#define AM_CURVE_BACK_IN_OUT_OVERSHOOT (1.70158f * 1.525f)
+    
+// MARK: - Scalar Kernels
+    
+static inline double AMLinear(double t) {
+    return t;
+}
+    
+static inline double AMEaseInQuad(double t) {
+    return t * t;
+}
+    
+static inline double AMEaseOutQuad(double t) {
+    return -1.0 * t * (t - 2.0);
+}
+    
+static inline double AMEaseInOutQuad(double t) {
+    t *= 2.0;
+    if (t < 1.0) return .5 * t * t;
+    t -= 1.0;
+    return -.5 * (t * (t - 2.0) - 1.0);
+}
+    
+static inline double AMEaseInCubic(double t) {
+    return t * t * t;
+}
+    
+static inline double AMEaseOutCubic(double t) {
+    t -= 1.0;
+    return t * t * t + 1.0;
+}
+    
+static inline double AMEaseInOutCubic(double t) {
+    if (t < .5) return AMEaseInCubic(t * 2.0) / 2.0;
+    return AMEaseOutCubic((t - .5) * 2.0) / 2.0 + .5;
+}
+    
+static inline double AMEaseInQuart(double t) {
+    t *= t;
+    return t * t;
+}
+    
+static inline double AMEaseOutQuart(double t) {
+    t -= 1.0;
+    t *= t;
+    return -1.0 * (t * t - 1.0);
+}
+    
+static inline double AMEaseInOutQuart(double t) {
+    t *= 2.0;
+    if (t < 1.0) return .5 * AMEaseInQuart(t);
+    t -= 2.0;
+    return -.5 * (AMEaseInQuart(t) - 2.0);
+}
+    
+static inline double AMEaseInQuint(double t) {
+    return t * t * t * t * t;
+}
+    
+static inline double AMEaseOutQuint(double t) {
+    t -= 1.0;
+    return t * t * t * t * t + 1.0;
+}
+    
+static inline double AMEaseInOutQuint(double t) {
+    t *= 2.0;
+    if (t < 1.0) return .5 * AMEaseInQuint(t);
+    t -= 2.0;
+    return .5 * (AMEaseInQuint(t) + 2.0);
+}
+    
+static inline double AMEaseInSine(double t) {
+    return -1.0 * cos(t * AM_CURVE_PI_2) + 1.0;
+}
+    
+static inline double AMEaseOutSine(double t) {
+    return sin(t * AM_CURVE_PI_2);
+}
+    
+static inline double AMEaseInOutSine(double t) {
+    return -.5 * cos(AM_CURVE_PI * t) + .5;
+}
+    
+static inline double AMEaseInExpo(double t) {
+    return (t == .0 ? .0 : exp2(10.0 * (t - 1.0)));
+}
+    
+static inline double AMEaseOutExpo(double t) {
+    return -exp2(-10.0 * t) + 1.0;
+}
+    
+static inline double AMEaseInOutExpo(double t) {
+    if (t == .0) return .0;
+    if (t == 1.0) return 1.0;
+    t = t * 2.0 - 1.0;
+    if (t < .0) return .5 * exp2(10.0 * t);
+    return .5 * (-exp2(-10.0 * t) + 2.0);
+}
+    
+static inline double AMEaseInCirc(double t) {
+    return -1.0 * (sqrt(1.0 - t * t) - 1.0);
+}
+    
+static inline double AMEaseOutCirc(double t) {
+    t -= 1.0;
+    return sqrt(1.0 - t * t);
+}
+    
+static inline double AMEaseInOutCirc(double t) {
+    t *= 2.0;
+    if (t < 1.0) return -.5 * (sqrt(1.0 - t * t) - 1.0);
+    t -= 2.0;
+    return .5 * (sqrt(1.0 - t * t) + 1.0);
+}
+    
+static inline double AMEaseInElastic(double t) {
+    if (t == .0) return .0;
+    if (t == 1.0) return 1.0;
+    t -= 1.0;
+    return -(exp2(10.0 * t) * sin((t - AM_CURVE_ELASTIC_SHIFT) * (2.0 * AM_CURVE_PI) / AM_CURVE_ELASTIC_PERIOD));
+}
+    
+static inline double AMEaseOutElastic(double t) {
+    if (t == .0) return .0;
+    if (t == 1.0) return 1.0;
+    return exp2(-10.0 * t) * sin((t - AM_CURVE_ELASTIC_SHIFT) * (2.0 * AM_CURVE_PI) / AM_CURVE_ELASTIC_PERIOD) + 1.0;
+}
+    
+static inline double AMEaseInOutElastic(double t) {
+    if (t == .0) return .0;
+    if (t == 1.0) return 1.0;
+    t = t * 2.0 - 1.0;
+    double s = sin((t - AM_CURVE_ELASTIC_IN_OUT_SHIFT) * (2.0 * AM_CURVE_PI) / AM_CURVE_ELASTIC_IN_OUT_PERIOD);
+    if (t < .0) return -.5 * (exp2(10.0 * t) * s);
+    return exp2(-10.0 * t) * s * .5 + 1.0;
+}
+    
+static inline double AMEaseInBack(double t) {
+    return t * t * (2.70158 * t - 1.70158);
+}
+    
+static inline double AMEaseOutBack(double t) {
+    t -= 1.0;
+    return t * t * ((AM_CURVE_BACK_OVERSHOOT + 1.0) * t + AM_CURVE_BACK_OVERSHOOT) + 1.0;
+}
+    
+static inline double AMEaseInOutBack(double t) {
+    const double s = AM_CURVE_BACK_IN_OUT_OVERSHOOT;
+    t *= 2.0;
+    if (t < 1.0) return .5 * (t * t * ((s + 1.0) * t - s));
+    t -= 2.0;
+    return .5 * (t * t * ((s + 1.0) * t + s) + 2.0);
+}
+    
+static inline double AMEaseOutBounce(double t) {
+    if (t < (1.0 / 2.75)) return 7.5625 * t * t;
+    if (t < (2.0 / 2.75)) {
+        t -= 1.5 / 2.75;
+        return 7.5625 * t * t + .75;
+    }
+    if (t < (2.5 / 2.75)) {
+        t -= 2.25 / 2.75;
+        return 7.5625 * t * t + .9375;
+    }
+    t -= 2.625 / 2.75;
+    return 7.5625 * t * t + .984375;
+}
+    
+static inline double AMEaseInBounce(double t) {
+    return 1.0 - AMEaseOutBounce(1.0 - t);
+}
+    
+static inline double AMEaseInOutBounce(double t) {
+    if (t < .5) return AMEaseInBounce(t * 2.0) * .5;
+    return AMEaseOutBounce(t * 2.0 - 1.0) * .5 + .5;
+}
+    
+// MARK: - Derivative Kernels
+    
+// The slope of each scalar kernel - the rate of change in position per unit of time. Curves with a vertical tangent (the circular curves at their end points) return infinity.
+    
+static inline double AMLinearDerivative(double t) {
+    (void)t;
+    return 1.0;
+}
+    
+static inline double AMEaseInQuadDerivative(double t) {
+    return 2.0 * t;
+}
+    
+static inline double AMEaseOutQuadDerivative(double t) {
+    return 2.0 * (1.0 - t);
+}
+    
+static inline double AMEaseInOutQuadDerivative(double t) {
+    if (t < .5) return 4.0 * t;
+    return 4.0 * (1.0 - t);
+}
+    
+static inline double AMEaseInCubicDerivative(double t) {
+    return 3.0 * t * t;
+}
+    
+static inline double AMEaseOutCubicDerivative(double t) {
+    t -= 1.0;
+    return 3.0 * t * t;
+}
+    
+static inline double AMEaseInOutCubicDerivative(double t) {
+    if (t < .5) return 12.0 * t * t;
+    t -= 1.0;
+    return 12.0 * t * t;
+}
+    
+static inline double AMEaseInQuartDerivative(double t) {
+    return 4.0 * t * t * t;
+}
+    
+static inline double AMEaseOutQuartDerivative(double t) {
+    t -= 1.0;
+    return -4.0 * t * t * t;
+}
+    
+static inline double AMEaseInOutQuartDerivative(double t) {
+    if (t < .5) return 32.0 * t * t * t;
+    t -= 1.0;
+    return -32.0 * t * t * t;
+}
+    
+static inline double AMEaseInQuintDerivative(double t) {
+    t *= t;
+    return 5.0 * t * t;
+}
+    
+static inline double AMEaseOutQuintDerivative(double t) {
+    t -= 1.0;
+    t *= t;
+    return 5.0 * t * t;
+}
+    
+static inline double AMEaseInOutQuintDerivative(double t) {
+    if (t >= .5) t -= 1.0;
+    t *= t;
+    return 80.0 * t * t;
+}
+    
+static inline double AMEaseInSineDerivative(double t) {
+    return AM_CURVE_PI_2 * sin(t * AM_CURVE_PI_2);
+}
+    
+static inline double AMEaseOutSineDerivative(double t) {
+    return AM_CURVE_PI_2 * cos(t * AM_CURVE_PI_2);
+}
+    
+static inline double AMEaseInOutSineDerivative(double t) {
+    return AM_CURVE_PI_2 * sin(AM_CURVE_PI * t);
+}
+    
+static inline double AMEaseInExpoDerivative(double t) {
+    return 10.0 * AM_CURVE_LN2 * exp2(10.0 * (t - 1.0));
+}
+    
+static inline double AMEaseOutExpoDerivative(double t) {
+    return 10.0 * AM_CURVE_LN2 * exp2(-10.0 * t);
+}
+    
+static inline double AMEaseInOutExpoDerivative(double t) {
+    t = t * 2.0 - 1.0;
+    return 10.0 * AM_CURVE_LN2 * exp2(-10.0 * fabs(t));
+}
+    
+static inline double AMEaseInCircDerivative(double t) {
+    return t / sqrt(1.0 - t * t);
+}
+    
+static inline double AMEaseOutCircDerivative(double t) {
+    t -= 1.0;
+    return -t / sqrt(1.0 - t * t);
+}
+    
+static inline double AMEaseInOutCircDerivative(double t) {
+    t *= 2.0;
+    if (t < 1.0) return t / sqrt(1.0 - t * t);
+    t -= 2.0;
+    return -t / sqrt(1.0 - t * t);
+}
+    
+static inline double AMEaseInElasticDerivative(double t) {
+    t -= 1.0;
+    const double w = (2.0 * AM_CURVE_PI) / AM_CURVE_ELASTIC_PERIOD;
+    const double a = (t - AM_CURVE_ELASTIC_SHIFT) * w;
+    return -exp2(10.0 * t) * (10.0 * AM_CURVE_LN2 * sin(a) + w * cos(a));
+}
+    
+static inline double AMEaseOutElasticDerivative(double t) {
+    const double w = (2.0 * AM_CURVE_PI) / AM_CURVE_ELASTIC_PERIOD;
+    const double a = (t - AM_CURVE_ELASTIC_SHIFT) * w;
+    return exp2(-10.0 * t) * (w * cos(a) - 10.0 * AM_CURVE_LN2 * sin(a));
+}
+    
+static inline double AMEaseInOutElasticDerivative(double t) {
+    t = t * 2.0 - 1.0;
+    const double w = (2.0 * AM_CURVE_PI) / AM_CURVE_ELASTIC_IN_OUT_PERIOD;
+    const double a = (t - AM_CURVE_ELASTIC_IN_OUT_SHIFT) * w;
+    if (t < .0) return -exp2(10.0 * t) * (10.0 * AM_CURVE_LN2 * sin(a) + w * cos(a));
+    return exp2(-10.0 * t) * (w * cos(a) - 10.0 * AM_CURVE_LN2 * sin(a));
+}
+    
+static inline double AMEaseInBackDerivative(double t) {
+    return t * (3.0 * 2.70158 * t - 2.0 * 1.70158);
+}
+    
+static inline double AMEaseOutBackDerivative(double t) {
+    t -= 1.0;
+    return t * (3.0 * (AM_CURVE_BACK_OVERSHOOT + 1.0) * t + 2.0 * AM_CURVE_BACK_OVERSHOOT);
+}
+    
+static inline double AMEaseInOutBackDerivative(double t) {
+    const double s = AM_CURVE_BACK_IN_OUT_OVERSHOOT;
+    t *= 2.0;
+    if (t < 1.0) return t * (3.0 * (s + 1.0) * t - 2.0 * s);
+    t -= 2.0;
+    return t * (3.0 * (s + 1.0) * t + 2.0 * s);
+}
+    
+static inline double AMEaseOutBounceDerivative(double t) {
+    if (t < (1.0 / 2.75)) return 15.125 * t;
+    if (t < (2.0 / 2.75)) return 15.125 * (t - 1.5 / 2.75);
+    if (t < (2.5 / 2.75)) return 15.125 * (t - 2.25 / 2.75);
+    return 15.125 * (t - 2.625 / 2.75);
+}
+    
+static inline double AMEaseInBounceDerivative(double t) {
+    return AMEaseOutBounceDerivative(1.0 - t);
+}
+    
+static inline double AMEaseInOutBounceDerivative(double t) {
+    if (t < .5) return AMEaseInBounceDerivative(t * 2.0);
+    return AMEaseOutBounceDerivative(t * 2.0 - 1.0);
+}
+    
+// MARK: - Vector Kernels
+    
+// Two lanes of doubles evaluated at once - 128 bits, which maps to a single SIMD register on both ARM and Intel.
+typedef double AMCurveLanes __attribute__((vector_size(2 * sizeof(double))));
+typedef long long AMCurveMask __attribute__((vector_size(2 * sizeof(long long))));
+    
+static inline AMCurveLanes AMCurveLanesSplat(double x) {
+    AMCurveLanes v = { x, x };
+    return v;
+}
+    
+static inline AMCurveLanes AMCurveLanesSelect(AMCurveMask mask, AMCurveLanes a, AMCurveLanes b) {
+    return (AMCurveLanes)(((AMCurveMask)a & mask) | ((AMCurveMask)b & ~mask));
+}
+    
+static inline AMCurveLanes AMCurveLanesClamp(AMCurveLanes t) {
+    t = AMCurveLanesSelect((AMCurveMask)(t < .0), AMCurveLanesSplat(.0), t);
+    return AMCurveLanesSelect((AMCurveMask)(t > 1.0), AMCurveLanesSplat(1.0), t);
+}
+    
+// The square root is applied lane by lane. It is a single instruction per lane - so the circular curves stay vectorized otherwise.
+static inline AMCurveLanes AMCurveLanesSqrt(AMCurveLanes v) {
+    AMCurveLanes r = { sqrt(v[0]), sqrt(v[1]) };
+    return r;
+}
+    
+static inline AMCurveLanes AMLinearLanes(AMCurveLanes t) {
+    return t;
+}
+    
+static inline AMCurveLanes AMEaseInQuadLanes(AMCurveLanes t) {
+    return t * t;
+}
+    
+static inline AMCurveLanes AMEaseOutQuadLanes(AMCurveLanes t) {
+    return -1.0 * t * (t - 2.0);
+}
+    
+static inline AMCurveLanes AMEaseInOutQuadLanes(AMCurveLanes t) {
+    t *= 2.0;
+    AMCurveLanes u = t - 1.0;
+    return AMCurveLanesSelect((AMCurveMask)(t < 1.0), .5 * t * t, -.5 * (u * (u - 2.0) - 1.0));
+}
+    
+static inline AMCurveLanes AMEaseInCubicLanes(AMCurveLanes t) {
+    return t * t * t;
+}
+    
+static inline AMCurveLanes AMEaseOutCubicLanes(AMCurveLanes t) {
+    t -= 1.0;
+    return t * t * t + 1.0;
+}
+    
+static inline AMCurveLanes AMEaseInOutCubicLanes(AMCurveLanes t) {
+    AMCurveLanes i = t * 2.0;
+    AMCurveLanes o = (t - .5) * 2.0 - 1.0;
+    return AMCurveLanesSelect((AMCurveMask)(t < .5), i * i * i / 2.0, (o * o * o + 1.0) / 2.0 + .5);
+}
+    
+static inline AMCurveLanes AMEaseInQuartLanes(AMCurveLanes t) {
+    t *= t;
+    return t * t;
+}
+    
+static inline AMCurveLanes AMEaseOutQuartLanes(AMCurveLanes t) {
+    t -= 1.0;
+    t *= t;
+    return -1.0 * (t * t - 1.0);
+}
+    
+static inline AMCurveLanes AMEaseInOutQuartLanes(AMCurveLanes t) {
+    t *= 2.0;
+    AMCurveLanes i = t * t;
+    AMCurveLanes o = (t - 2.0) * (t - 2.0);
+    return AMCurveLanesSelect((AMCurveMask)(t < 1.0), .5 * i * i, -.5 * (o * o - 2.0));
+}
+    
+static inline AMCurveLanes AMEaseInQuintLanes(AMCurveLanes t) {
+    AMCurveLanes t2 = t * t;
+    return t2 * t2 * t;
+}
+    
+static inline AMCurveLanes AMEaseOutQuintLanes(AMCurveLanes t) {
+    t -= 1.0;
+    AMCurveLanes t2 = t * t;
+    return 1.0 * (t2 * t2 * t + 1.0);
+}
+    
+static inline AMCurveLanes AMEaseInOutQuintLanes(AMCurveLanes t) {
+    t *= 2.0;
+    AMCurveLanes u = t - 2.0;
+    AMCurveLanes t2 = t * t;
+    AMCurveLanes u2 = u * u;
+    return AMCurveLanesSelect((AMCurveMask)(t < 1.0), .5 * t2 * t2 * t, .5 * (u2 * u2 * u + 2.0));
+}
+    
+static inline AMCurveLanes AMEaseInCircLanes(AMCurveLanes t) {
+    return -1.0 * (AMCurveLanesSqrt(1.0 - t * t) - 1.0);
+}
+    
+static inline AMCurveLanes AMEaseOutCircLanes(AMCurveLanes t) {
+    t -= 1.0;
+    return AMCurveLanesSqrt(1.0 - t * t);
+}
+    
+static inline AMCurveLanes AMEaseInOutCircLanes(AMCurveLanes t) {
+    t *= 2.0;
+    AMCurveLanes u = t - 2.0;
+    AMCurveMask first = (AMCurveMask)(t < 1.0);
+    AMCurveLanes r = AMCurveLanesSqrt(1.0 - AMCurveLanesSelect(first, t * t, u * u));
+    return AMCurveLanesSelect(first, -.5 * (r - 1.0), .5 * (r + 1.0));
+}
+    
+static inline AMCurveLanes AMEaseInBackLanes(AMCurveLanes t) {
+    return t * t * (2.70158 * t - 1.70158);
+}
+    
+static inline AMCurveLanes AMEaseOutBackLanes(AMCurveLanes t) {
+    t -= 1.0;
+    return t * t * ((AM_CURVE_BACK_OVERSHOOT + 1.0) * t + AM_CURVE_BACK_OVERSHOOT) + 1.0;
+}
+    
+static inline AMCurveLanes AMEaseInOutBackLanes(AMCurveLanes t) {
+    const double s = AM_CURVE_BACK_IN_OUT_OVERSHOOT;
+    t *= 2.0;
+    AMCurveLanes u = t - 2.0;
+    return AMCurveLanesSelect((AMCurveMask)(t < 1.0), .5 * (t * t * ((s + 1.0) * t - s)), .5 * (u * u * ((s + 1.0) * u + s) + 2.0));
+}
+    
+static inline AMCurveLanes AMEaseOutBounceLanes(AMCurveLanes t) {
+    AMCurveLanes offset = AMCurveLanesSelect((AMCurveMask)(t < (2.5 / 2.75)), AMCurveLanesSplat(2.25 / 2.75), AMCurveLanesSplat(2.625 / 2.75));
+    AMCurveLanes constant = AMCurveLanesSelect((AMCurveMask)(t < (2.5 / 2.75)), AMCurveLanesSplat(.9375), AMCurveLanesSplat(.984375));
+    offset = AMCurveLanesSelect((AMCurveMask)(t < (2.0 / 2.75)), AMCurveLanesSplat(1.5 / 2.75), offset);
+    constant = AMCurveLanesSelect((AMCurveMask)(t < (2.0 / 2.75)), AMCurveLanesSplat(.75), constant);
+    offset = AMCurveLanesSelect((AMCurveMask)(t < (1.0 / 2.75)), AMCurveLanesSplat(.0), offset);
+    constant = AMCurveLanesSelect((AMCurveMask)(t < (1.0 / 2.75)), AMCurveLanesSplat(.0), constant);
+    t -= offset;
+    return 7.5625 * t * t + constant;
+}
+    
+static inline AMCurveLanes AMEaseInBounceLanes(AMCurveLanes t) {
+    return 1.0 - AMEaseOutBounceLanes(1.0 - t);
+}
+    
+static inline AMCurveLanes AMEaseInOutBounceLanes(AMCurveLanes t) {
+    AMCurveMask first = (AMCurveMask)(t < .5);
+    AMCurveLanes r = AMEaseOutBounceLanes(AMCurveLanesSelect(first, 1.0 - t * 2.0, t * 2.0 - 1.0));
+    return AMCurveLanesSelect(first, (1.0 - r) * .5, r * .5 + .5);
+}
+    
+// MARK: - Batch Kernels
+    
+// Defines a function that transforms a buffer of positions two at a time.
+#define AM_CURVE_BATCH_FUNCTION(name) \
+static inline void name##Batch(const double *positions, double *output, size_t count) { \
+    size_t idx = 0; \
+    for ( ; idx + 2 <= count ; idx += 2) { \
+        AMCurveLanes t; \
+        memcpy(&t, positions + idx, sizeof(t)); \
+        t = name##Lanes(AMCurveLanesClamp(t)); \
+        memcpy(output + idx, &t, sizeof(t)); \
+    } \
+    if (idx < count) { \
+        AMCurveLanes t = AMCurveLanesSplat(.0); \
+        memcpy(&t, positions + idx, sizeof(double) * (count - idx)); \
+        t = name##Lanes(AMCurveLanesClamp(t)); \
+        memcpy(output + idx, &t, sizeof(double) * (count - idx)); \
+    } \
+}
+    
+// Defines a function that transforms a buffer of positions one at a time. Used by the sine, expo and elastic curves - their sin, cos and exp2 have no vector instructions, and evaluating them lane by lane is slower than the scalar loop.
+#define AM_CURVE_SCALAR_BATCH_FUNCTION(name) \
+static inline void name##Batch(const double *positions, double *output, size_t count) { \
+    for (size_t idx = 0 ; idx < count ; idx++) { \
+        double t = positions[idx]; \
+        output[idx] = name(t < .0 ? .0 : (t > 1.0 ? 1.0 : t)); \
+    } \
+}
+    
+AM_CURVE_BATCH_FUNCTION(AMLinear)
+AM_CURVE_BATCH_FUNCTION(AMEaseInQuad)
+AM_CURVE_BATCH_FUNCTION(AMEaseOutQuad)
+AM_CURVE_BATCH_FUNCTION(AMEaseInOutQuad)
+AM_CURVE_BATCH_FUNCTION(AMEaseInCubic)
+AM_CURVE_BATCH_FUNCTION(AMEaseOutCubic)
+AM_CURVE_BATCH_FUNCTION(AMEaseInOutCubic)
+AM_CURVE_BATCH_FUNCTION(AMEaseInQuart)
+AM_CURVE_BATCH_FUNCTION(AMEaseOutQuart)
+AM_CURVE_BATCH_FUNCTION(AMEaseInOutQuart)
+AM_CURVE_BATCH_FUNCTION(AMEaseInQuint)
+AM_CURVE_BATCH_FUNCTION(AMEaseOutQuint)
+AM_CURVE_BATCH_FUNCTION(AMEaseInOutQuint)
+AM_CURVE_SCALAR_BATCH_FUNCTION(AMEaseInSine)
+AM_CURVE_SCALAR_BATCH_FUNCTION(AMEaseOutSine)
+AM_CURVE_SCALAR_BATCH_FUNCTION(AMEaseInOutSine)
+AM_CURVE_SCALAR_BATCH_FUNCTION(AMEaseInExpo)
+AM_CURVE_SCALAR_BATCH_FUNCTION(AMEaseOutExpo)
+AM_CURVE_SCALAR_BATCH_FUNCTION(AMEaseInOutExpo)
+AM_CURVE_BATCH_FUNCTION(AMEaseInCirc)
+AM_CURVE_BATCH_FUNCTION(AMEaseOutCirc)
+AM_CURVE_BATCH_FUNCTION(AMEaseInOutCirc)
+AM_CURVE_SCALAR_BATCH_FUNCTION(AMEaseInElastic)
+AM_CURVE_SCALAR_BATCH_FUNCTION(AMEaseOutElastic)
+AM_CURVE_SCALAR_BATCH_FUNCTION(AMEaseInOutElastic)
+AM_CURVE_BATCH_FUNCTION(AMEaseInBack)
+AM_CURVE_BATCH_FUNCTION(AMEaseOutBack)
+AM_CURVE_BATCH_FUNCTION(AMEaseInOutBack)
+AM_CURVE_BATCH_FUNCTION(AMEaseInBounce)
+AM_CURVE_BATCH_FUNCTION(AMEaseOutBounce)
+AM_CURVE_BATCH_FUNCTION(AMEaseInOutBounce)
+    
+// MARK: - Dispatching
+    
+/*!
+ Transforms a value in time using a build-in curve function.
+ 
+ @param function       The function of the curve. Must not be `AMCurveFunctionCustom`.
+ @param positionInTime Position in time - values outside one and zero are clamped.
+ 
+ @return The position on the curve relative to `positionInTime`.
+ */
+static inline double AMCurveFunctionTransform(AMCurveFunction function, double positionInTime) {
+    double t = (positionInTime < .0 ? .0 : (positionInTime > 1.0 ? 1.0 : positionInTime));
+    switch (function) {
+        case AMCurveFunctionLinear: return AMLinear(t);
+        case AMCurveFunctionEaseInQuad: return AMEaseInQuad(t);
+        case AMCurveFunctionEaseOutQuad: return AMEaseOutQuad(t);
+        case AMCurveFunctionEaseInOutQuad: return AMEaseInOutQuad(t);
+        case AMCurveFunctionEaseInCubic: return AMEaseInCubic(t);
+        case AMCurveFunctionEaseOutCubic: return AMEaseOutCubic(t);
+        case AMCurveFunctionEaseInOutCubic: return AMEaseInOutCubic(t);
+        case AMCurveFunctionEaseInQuart: return AMEaseInQuart(t);
+        case AMCurveFunctionEaseOutQuart: return AMEaseOutQuart(t);
+        case AMCurveFunctionEaseInOutQuart: return AMEaseInOutQuart(t);
+        case AMCurveFunctionEaseInQuint: return AMEaseInQuint(t);
+        case AMCurveFunctionEaseOutQuint: return AMEaseOutQuint(t);
+        case AMCurveFunctionEaseInOutQuint: return AMEaseInOutQuint(t);
+        case AMCurveFunctionEaseInSine: return AMEaseInSine(t);
+        case AMCurveFunctionEaseOutSine: return AMEaseOutSine(t);
+        case AMCurveFunctionEaseInOutSine: return AMEaseInOutSine(t);
+        case AMCurveFunctionEaseInExpo: return AMEaseInExpo(t);
+        case AMCurveFunctionEaseOutExpo: return AMEaseOutExpo(t);
+        case AMCurveFunctionEaseInOutExpo: return AMEaseInOutExpo(t);
+        case AMCurveFunctionEaseInCirc: return AMEaseInCirc(t);
+        case AMCurveFunctionEaseOutCirc: return AMEaseOutCirc(t);
+        case AMCurveFunctionEaseInOutCirc: return AMEaseInOutCirc(t);
+        case AMCurveFunctionEaseInElastic: return AMEaseInElastic(t);
+        case AMCurveFunctionEaseOutElastic: return AMEaseOutElastic(t);
+        case AMCurveFunctionEaseInOutElastic: return AMEaseInOutElastic(t);
+        case AMCurveFunctionEaseInBack: return AMEaseInBack(t);
+        case AMCurveFunctionEaseOutBack: return AMEaseOutBack(t);
+        case AMCurveFunctionEaseInOutBack: return AMEaseInOutBack(t);
+        case AMCurveFunctionEaseInBounce: return AMEaseInBounce(t);
+        case AMCurveFunctionEaseOutBounce: return AMEaseOutBounce(t);
+        case AMCurveFunctionEaseInOutBounce: return AMEaseInOutBounce(t);
+        default: return t;
+    }
+}
+    
+/*!
+ Transforms a buffer of values in time using a build-in curve function.
+ 
+ @param function  The function of the curve. Must not be `AMCurveFunctionCustom`.
+ @param positions Positions in time - values outside one and zero are clamped.
+ @param count     The number of positions in the buffer.
+ @param output    A buffer of at least `count` elements that receives the positions on the curve. This can be the same buffer as `positions`.
+ 
+ @discussion The sine, expo and elastic functions are transformed one position at a time - as they are no faster in lanes.
+ */
+static inline void AMCurveFunctionTransformBatch(AMCurveFunction function, const double *positions, double *output, size_t count) {
+    switch (function) {
+        case AMCurveFunctionLinear: AMLinearBatch(positions, output, count); break;
+        case AMCurveFunctionEaseInQuad: AMEaseInQuadBatch(positions, output, count); break;
+        case AMCurveFunctionEaseOutQuad: AMEaseOutQuadBatch(positions, output, count); break;
+        case AMCurveFunctionEaseInOutQuad: AMEaseInOutQuadBatch(positions, output, count); break;
+        case AMCurveFunctionEaseInCubic: AMEaseInCubicBatch(positions, output, count); break;
+        case AMCurveFunctionEaseOutCubic: AMEaseOutCubicBatch(positions, output, count); break;
+        case AMCurveFunctionEaseInOutCubic: AMEaseInOutCubicBatch(positions, output, count); break;
+        case AMCurveFunctionEaseInQuart: AMEaseInQuartBatch(positions, output, count); break;
+        case AMCurveFunctionEaseOutQuart: AMEaseOutQuartBatch(positions, output, count); break;
+        case AMCurveFunctionEaseInOutQuart: AMEaseInOutQuartBatch(positions, output, count); break;
+        case AMCurveFunctionEaseInQuint: AMEaseInQuintBatch(positions, output, count); break;
+        case AMCurveFunctionEaseOutQuint: AMEaseOutQuintBatch(positions, output, count); break;
+        case AMCurveFunctionEaseInOutQuint: AMEaseInOutQuintBatch(positions, output, count); break;
+        case AMCurveFunctionEaseInSine: AMEaseInSineBatch(positions, output, count); break;
+        case AMCurveFunctionEaseOutSine: AMEaseOutSineBatch(positions, output, count); break;
+        case AMCurveFunctionEaseInOutSine: AMEaseInOutSineBatch(positions, output, count); break;
+        case AMCurveFunctionEaseInExpo: AMEaseInExpoBatch(positions, output, count); break;
+        case AMCurveFunctionEaseOutExpo: AMEaseOutExpoBatch(positions, output, count); break;
+        case AMCurveFunctionEaseInOutExpo: AMEaseInOutExpoBatch(positions, output, count); break;
+        case AMCurveFunctionEaseInCirc: AMEaseInCircBatch(positions, output, count); break;
+        case AMCurveFunctionEaseOutCirc: AMEaseOutCircBatch(positions, output, count); break;
+        case AMCurveFunctionEaseInOutCirc: AMEaseInOutCircBatch(positions, output, count); break;
+        case AMCurveFunctionEaseInElastic: AMEaseInElasticBatch(positions, output, count); break;
+        case AMCurveFunctionEaseOutElastic: AMEaseOutElasticBatch(positions, output, count); break;
+        case AMCurveFunctionEaseInOutElastic: AMEaseInOutElasticBatch(positions, output, count); break;
+        case AMCurveFunctionEaseInBack: AMEaseInBackBatch(positions, output, count); break;
+        case AMCurveFunctionEaseOutBack: AMEaseOutBackBatch(positions, output, count); break;
+        case AMCurveFunctionEaseInOutBack: AMEaseInOutBackBatch(positions, output, count); break;
+        case AMCurveFunctionEaseInBounce: AMEaseInBounceBatch(positions, output, count); break;
+        case AMCurveFunctionEaseOutBounce: AMEaseOutBounceBatch(positions, output, count); break;
+        case AMCurveFunctionEaseInOutBounce: AMEaseInOutBounceBatch(positions, output, count); break;
+        default: AMLinearBatch(positions, output, count); break;
+    }
+}
+    
+/*!
+ Returns the slope of a build-in curve function - the rate of change in position per unit of time.
+ 
+ @param function       The function of the curve. Must not be `AMCurveFunctionCustom`.
+ @param positionInTime Position in time - values outside one and zero are clamped.
+ 
+ @return The derivative of the curve at `positionInTime`.
+ */
+static inline double AMCurveFunctionDerivative(AMCurveFunction function, double positionInTime) {
+    double t = (positionInTime < .0 ? .0 : (positionInTime > 1.0 ? 1.0 : positionInTime));
+    switch (function) {
+        case AMCurveFunctionLinear: return AMLinearDerivative(t);
+        case AMCurveFunctionEaseInQuad: return AMEaseInQuadDerivative(t);
+        case AMCurveFunctionEaseOutQuad: return AMEaseOutQuadDerivative(t);
+        case AMCurveFunctionEaseInOutQuad: return AMEaseInOutQuadDerivative(t);
+        case AMCurveFunctionEaseInCubic: return AMEaseInCubicDerivative(t);
+        case AMCurveFunctionEaseOutCubic: return AMEaseOutCubicDerivative(t);
+        case AMCurveFunctionEaseInOutCubic: return AMEaseInOutCubicDerivative(t);
+        case AMCurveFunctionEaseInQuart: return AMEaseInQuartDerivative(t);
+        case AMCurveFunctionEaseOutQuart: return AMEaseOutQuartDerivative(t);
+        case AMCurveFunctionEaseInOutQuart: return AMEaseInOutQuartDerivative(t);
+        case AMCurveFunctionEaseInQuint: return AMEaseInQuintDerivative(t);
+        case AMCurveFunctionEaseOutQuint: return AMEaseOutQuintDerivative(t);
+        case AMCurveFunctionEaseInOutQuint: return AMEaseInOutQuintDerivative(t);
+        case AMCurveFunctionEaseInSine: return AMEaseInSineDerivative(t);
+        case AMCurveFunctionEaseOutSine: return AMEaseOutSineDerivative(t);
+        case AMCurveFunctionEaseInOutSine: return AMEaseInOutSineDerivative(t);
+        case AMCurveFunctionEaseInExpo: return AMEaseInExpoDerivative(t);
+        case AMCurveFunctionEaseOutExpo: return AMEaseOutExpoDerivative(t);
+        case AMCurveFunctionEaseInOutExpo: return AMEaseInOutExpoDerivative(t);
+        case AMCurveFunctionEaseInCirc: return AMEaseInCircDerivative(t);
+        case AMCurveFunctionEaseOutCirc: return AMEaseOutCircDerivative(t);
+        case AMCurveFunctionEaseInOutCirc: return AMEaseInOutCircDerivative(t);
+        case AMCurveFunctionEaseInElastic: return AMEaseInElasticDerivative(t);
+        case AMCurveFunctionEaseOutElastic: return AMEaseOutElasticDerivative(t);
+        case AMCurveFunctionEaseInOutElastic: return AMEaseInOutElasticDerivative(t);
+        case AMCurveFunctionEaseInBack: return AMEaseInBackDerivative(t);
+        case AMCurveFunctionEaseOutBack: return AMEaseOutBackDerivative(t);
+        case AMCurveFunctionEaseInOutBack: return AMEaseInOutBackDerivative(t);
+        case AMCurveFunctionEaseInBounce: return AMEaseInBounceDerivative(t);
+        case AMCurveFunctionEaseOutBounce: return AMEaseOutBounceDerivative(t);
+        case AMCurveFunctionEaseInOutBounce: return AMEaseInOutBounceDerivative(t);
+        default: return 1.0;
+    }
+}
+    
+// MARK: - Cubic Bezier
+    
+#define AM_CUBIC_BEZIER_SAMPLE_COUNT 11
+#define AM_CUBIC_BEZIER_NEWTON_ITERATIONS 8
+#define AM_CUBIC_BEZIER_NEWTON_MIN_SLOPE .001
+#define AM_CUBIC_BEZIER_PRECISION 1e-9
+#define AM_CUBIC_BEZIER_SUBDIVISION_MAX_ITERATIONS 40
+    
+/*!
+ A cubic Bezier curve with end points at (0, 0) and (1, 1) - as used by `CAMediaTimingFunction` and CSS `cubic-bezier()`. Use `AMCubicBezierMake` to create one.
+ */
+typedef struct {
+    double ax, bx, cx;
+    double ay, by, cy;
+    double samples[AM_CUBIC_BEZIER_SAMPLE_COUNT];
+} AMCubicBezier;
+    
+static inline double AMCubicBezierX(const AMCubicBezier *bezier, double t) {
+    return ((bezier->ax * t + bezier->bx) * t + bezier->cx) * t;
+}
+    
+static inline double AMCubicBezierY(const AMCubicBezier *bezier, double t) {
+    return ((bezier->ay * t + bezier->by) * t + bezier->cy) * t;
+}
+    
+static inline double AMCubicBezierSlopeX(const AMCubicBezier *bezier, double t) {
+    return (3.0 * bezier->ax * t + 2.0 * bezier->bx) * t + bezier->cx;
+}
+    
+static inline double AMCubicBezierSlopeY(const AMCubicBezier *bezier, double t) {
+    return (3.0 * bezier->ay * t + 2.0 * bezier->by) * t + bezier->cy;
+}
+    
+/*!
+ Returns a cubic Bezier curve with its polynomial coefficients and a table of x samples precomputed.
+ 
+ @param x1 The x coordinate of the first control point. Clamped to between zero and one.
+ @param y1 The y coordinate of the first control point.
+ @param x2 The x coordinate of the second control point. Clamped to between zero and one.
+ @param y2 The y coordinate of the second control point.
+ */
+static inline AMCubicBezier AMCubicBezierMake(double x1, double y1, double x2, double y2) {
+        
+    AMCubicBezier bezier;
+        
+    x1 = (x1 < .0 ? .0 : (x1 > 1.0 ? 1.0 : x1));
+    x2 = (x2 < .0 ? .0 : (x2 > 1.0 ? 1.0 : x2));
+        
+    bezier.cx = 3.0 * x1;
+    bezier.bx = 3.0 * (x2 - x1) - bezier.cx;
+    bezier.ax = 1.0 - bezier.cx - bezier.bx;
+        
+    bezier.cy = 3.0 * y1;
+    bezier.by = 3.0 * (y2 - y1) - bezier.cy;
+    bezier.ay = 1.0 - bezier.cy - bezier.by;
+        
+    for (int idx = 0 ; idx < AM_CUBIC_BEZIER_SAMPLE_COUNT ; idx++)
+        bezier.samples[idx] = AMCubicBezierX(&bezier, idx / (double)(AM_CUBIC_BEZIER_SAMPLE_COUNT - 1));
+        
+    return bezier;
+        
+}
+    
+/*!
+ Returns the curve parameter at which the curve reaches a specific x coordinate.
+ 
+ @discussion The sample table gives a first guess that is refined using Newton-Raphson iterations. Where the curve is too flat for Newton-Raphson to converge, bisection within the sample interval is used instead.
+ */
+static inline double AMCubicBezierSolveX(const AMCubicBezier *bezier, double x) {
+        
+    const double step = 1.0 / (AM_CUBIC_BEZIER_SAMPLE_COUNT - 1);
+        
+    int idx = 1;
+    while (idx < AM_CUBIC_BEZIER_SAMPLE_COUNT - 1 && bezier->samples[idx] <= x)
+        idx++;
+    idx--;
+        
+    double start = idx * step;
+    double delta = bezier->samples[idx + 1] - bezier->samples[idx];
+    double guess = (delta > .0 ? start + step * (x - bezier->samples[idx]) / delta : start);
+        
+    for (int iteration = 0 ; iteration < AM_CUBIC_BEZIER_NEWTON_ITERATIONS ; iteration++) {
+        double error = AMCubicBezierX(bezier, guess) - x;
+        if (fabs(error) <= AM_CUBIC_BEZIER_PRECISION) return guess;
+        double slope = AMCubicBezierSlopeX(bezier, guess);
+        if (slope < AM_CUBIC_BEZIER_NEWTON_MIN_SLOPE) break;
+        guess -= error / slope;
+    }
+        
+    double lower = start;
+    double upper = start + step;
+    for (int iteration = 0 ; iteration < AM_CUBIC_BEZIER_SUBDIVISION_MAX_ITERATIONS ; iteration++) {
+        guess = lower + (upper - lower) / 2.0;
+        double error = AMCubicBezierX(bezier, guess) - x;
+        if (fabs(error) <= AM_CUBIC_BEZIER_PRECISION) break;
+        if (error > .0) upper = guess;
+        else lower = guess;
+    }
+        
+    return guess;
+        
+}
+    
+/*!
+ Transforms a value in time using a cubic Bezier curve.
+ 
+ @param bezier         The curve.
+ @param positionInTime Position in time - values outside one and zero are clamped.
+ 
+ @return The position on the curve relative to `positionInTime`.
+ */
+static inline double AMCubicBezierTransform(const AMCubicBezier *bezier, double positionInTime) {
+    if (positionInTime <= .0) return .0;
+    if (positionInTime >= 1.0) return 1.0;
+    return AMCubicBezierY(bezier, AMCubicBezierSolveX(bezier, positionInTime));
+}
+    
+/*!
+ Returns the slope of a cubic Bezier curve - the rate of change in position per unit of time.
+ 
+ @param bezier         The curve.
+ @param positionInTime Position in time - values outside one and zero are clamped.
+ 
+ @return The derivative of the curve at `positionInTime`.
+ 
+ @discussion Where both control points coincide with an end point, the first derivatives vanish and the ratio of the second derivatives is used instead.
+ */
+static inline double AMCubicBezierDerivative(const AMCubicBezier *bezier, double positionInTime) {
+        
+    double x = (positionInTime < .0 ? .0 : (positionInTime > 1.0 ? 1.0 : positionInTime));
+    double t = (x == .0 || x == 1.0 ? x : AMCubicBezierSolveX(bezier, x));
+        
+    double slopeX = AMCubicBezierSlopeX(bezier, t);
+    double slopeY = AMCubicBezierSlopeY(bezier, t);
+        
+    if (fabs(slopeX) >= AM_CUBIC_BEZIER_PRECISION)
+        return slopeY / slopeX;
+        
+    if (fabs(slopeY) >= AM_CUBIC_BEZIER_PRECISION)
+        return (slopeY > .0 ? INFINITY : -INFINITY);
+        
+    double curvatureX = 6.0 * bezier->ax * t + 2.0 * bezier->bx;
+    double curvatureY = 6.0 * bezier->ay * t + 2.0 * bezier->by;
+        
+    return (curvatureX != .0 ? curvatureY / curvatureX : 1.0);
+        
+}
+    
+// MARK: - Spring
+    
+/*!
+ A damped harmonic oscillator moving from zero to one, evaluated using the closed form solution. Use `AMSpringMake` to create one.
+ */
+typedef struct {
+    double omega;       // Undamped angular frequency.
+    double zeta;        // Damping ratio.
+    double decay;       // Exponential decay rate of the displacement envelope.
+    double frequency;   // Damped angular frequency (underdamped only).
+    double a, b;        // Coefficients of the solution.
+    double r1, r2;      // Roots of the characteristic equation (overdamped only).
+} AMSpring;
+    
+/*!
+ Returns a spring with its solution precomputed.
+ 
+ @param mass            The mass attached to the spring. Must be greater than zero.
+ @param stiffness       The stiffness of the spring. Must be greater than zero.
+ @param damping         The damping of the spring.
+ @param initialVelocity The initial velocity, where one is the total distance traveled in one second.
+ */
+static inline AMSpring AMSpringMake(double mass, double stiffness, double damping, double initialVelocity) {
+        
+    AMSpring spring;
+        
+    /* Displacement from the rest position starts at minus one. */
+    const double x0 = -1.0;
+    const double v0 = initialVelocity;
+        
+    spring.omega = sqrt(stiffness / mass);
+    spring.zeta = damping / (2.0 * sqrt(stiffness * mass));
+    spring.frequency = spring.r1 = spring.r2 = .0;
+        
+    if (spring.zeta < 1.0) {
+        spring.frequency = spring.omega * sqrt(1.0 - spring.zeta * spring.zeta);
+        spring.decay = spring.zeta * spring.omega;
+        spring.a = x0;
+        spring.b = (v0 + spring.decay * x0) / spring.frequency;
+    } else if (spring.zeta == 1.0) {
+        spring.decay = spring.omega;
+        spring.a = x0;
+        spring.b = v0 + spring.omega * x0;
+    } else {
+        double root = sqrt(spring.zeta * spring.zeta - 1.0);
+        spring.r1 = -spring.omega * (spring.zeta - root);
+        spring.r2 = -spring.omega * (spring.zeta + root);
+        spring.decay = -spring.r1;
+        spring.b = (v0 - spring.r1 * x0) / (spring.r2 - spring.r1);
+        spring.a = x0 - spring.b;
+    }
+        
+    return spring;
+        
+}
+    
+/*!
+ Returns the displacement of a spring from its rest position at a specific time.
+ 
+ @param spring The spring.
+ @param time   The time in seconds since the spring was released.
+ */
+static inline double AMSpringDisplacement(const AMSpring *spring, double time) {
+    if (spring->zeta < 1.0)
+        return exp(-spring->decay * time) * (spring->a * cos(spring->frequency * time) + spring->b * sin(spring->frequency * time));
+    if (spring->zeta == 1.0)
+        return exp(-spring->decay * time) * (spring->a + spring->b * time);
+    return spring->a * exp(spring->r1 * time) + spring->b * exp(spring->r2 * time);
+}
+    
+/*!
+ Returns the velocity of a spring at a specific time.
+ 
+ @param spring The spring.
+ @param time   The time in seconds since the spring was released.
+ 
+ @return The velocity, where one is the total distance traveled in one second.
+ */
+static inline double AMSpringVelocity(const AMSpring *spring, double time) {
+    if (spring->zeta < 1.0) {
+        double c = cos(spring->frequency * time);
+        double s = sin(spring->frequency * time);
+        return exp(-spring->decay * time) * ((spring->b * spring->frequency - spring->a * spring->decay) * c - (spring->a * spring->frequency + spring->b * spring->decay) * s);
+    }
+    if (spring->zeta == 1.0)
+        return exp(-spring->decay * time) * (spring->b - spring->decay * (spring->a + spring->b * time));
+    return spring->a * spring->r1 * exp(spring->r1 * time) + spring->b * spring->r2 * exp(spring->r2 * time);
+}
+    
+/*!
+ Returns the time it takes for a spring to settle within a tolerance of its rest position.
+ 
+ @param spring    The spring.
+ @param tolerance The maximum displacement from the rest position - where one is the total distance.
+ 
+ @discussion The duration is computed from the envelope of the displacement, so the spring stays within the tolerance from then on. Springs without damping never settle, so `INFINITY` is returned.
+ */
+static inline double AMSpringSettlingDuration(const AMSpring *spring, double tolerance) {
+        
+    if (!(spring->decay > .0))
+        return INFINITY;
+        
+    double amplitude;
+        
+    if (spring->zeta < 1.0)
+        amplitude = sqrt(spring->a * spring->a + spring->b * spring->b);
+    else if (spring->zeta > 1.0)
+        amplitude = fabs(spring->a) + fabs(spring->b);
+    else {
+        /* The critically damped envelope is (|a| + |b|t)e^(-decay * t) - solved by fixed point iteration. */
+        double time = .0;
+        for (int iteration = 0 ; iteration < 16 ; iteration++)
+            time = fmax(.0, log((fabs(spring->a) + fabs(spring->b) * time) / tolerance) / spring->decay);
+        return time;
+    }
+        
+    return fmax(.0, log(amplitude / tolerance) / spring->decay);
+        
+}
+    
+// MARK: - Keyframe Reduction
+    
+/*!
+ Marks the samples needed to reproduce values of several components by linear interpolation within a tolerance (Ramer-Douglas-Peucker).
+ 
+ @param times      The sample times in ascending order.
+ @param values     The values at the sample times - `components` consecutive values per sample.
+ @param components The number of components of each value.
+ @param count      The number of samples.
+ @param tolerance  The maximum distance of any component from the line through the kept samples. Zero or less keeps all samples.
+ @param keep       On return, whether each sample is kept. Must hold `count` elements.
+ 
+ @discussion Use this for values that are not linear in the curve position - like colors interpolated outside of sRGB, which are reduced on their sRGB components.
+ 
+ @return The number of samples kept. The first and last samples are always kept - and all samples are kept if memory cannot be allocated.
+ */
+static inline size_t AMCurveReduceComponentSamples(const double *times, const double *values, size_t components, size_t count, double tolerance, bool *keep) {
+        
+    for (size_t idx = 0 ; idx < count ; idx++)
+        keep[idx] = (tolerance <= 0.0 || idx == 0 || idx == count - 1);
+        
+    if (tolerance <= 0.0 || count < 3)
+        return count;
+        
+    /* Each split pops one range and pushes two - so the stack never holds more than `count` ranges. Short curves use the call stack. */
+    size_t local[2 * 128];
+    size_t *stack = (count <= 128 ? local : (size_t *)malloc(sizeof(size_t) * count * 2));
+        
+    /* Without memory for the stack all samples are kept. */
+    if (!stack) {
+        for (size_t idx = 0 ; idx < count ; idx++)
+            keep[idx] = true;
+        return count;
+    }
+        
+    size_t kept = 2;
+    size_t depth = 0;
+        
+    stack[depth++] = 0;
+    stack[depth++] = count - 1;
+        
+    while (depth > 0) {
+            
+        size_t last = stack[--depth];
+        size_t first = stack[--depth];
+            
+        double span = times[last] - times[first];
+        double maxError = 0.0;
+        size_t maxIndex = 0;
+            
+        for (size_t idx = first + 1 ; idx < last ; idx++) {
+            double offset = times[idx] - times[first];
+            for (size_t component = 0 ; component < components ; component++) {
+                double from = values[first * components + component];
+                double slope = (values[last * components + component] - from) / span;
+                double error = fabs(values[idx * components + component] - (from + slope * offset));
+                if (error > maxError) {
+                    maxError = error;
+                    maxIndex = idx;
+                }
+            }
+        }
+            
+        if (maxError > tolerance) {
+                
+            keep[maxIndex] = true;
+            kept++;
+                
+            stack[depth++] = first;
+            stack[depth++] = maxIndex;
+            stack[depth++] = maxIndex;
+            stack[depth++] = last;
+                
+        }
+            
+    }
+        
+    if (stack != local)
+        free(stack);
+        
+    return kept;
+        
+}
+    
+/*!
+ Marks the samples needed to reproduce a curve by linear interpolation within a tolerance (Ramer-Douglas-Peucker).
+ 
+ @param times     The sample times in ascending order.
+ @param positions The curve positions at the sample times.
+ @param count     The number of samples.
+ @param tolerance The maximum distance between the curve and the line through the kept samples. Zero or less keeps all samples.
+ @param keep      On return, whether each sample is kept. Must hold `count` elements.
+ 
+ @return The number of samples kept. The first and last samples are always kept - and all samples are kept if memory cannot be allocated.
+ */
+static inline size_t AMCurveReduceSamples(const double *times, const double *positions, size_t count, double tolerance, bool *keep) {
+    return AMCurveReduceComponentSamples(times, positions, 1, count, tolerance, keep);
+}
+    
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* AMCurveKernels_h */
@@ -30,11 +30,17 @@
 
 @import QuartzCore;
 
+#import "AMColorKernels.h"
+
 @class AMCurve;
+@class AMKeyframeCache;
+@class AMInterpolator;
 @protocol AMInterpolatable;
 
 /*!
  The `AMCurvedAnimation` class is a `CAAnimation` subclass that provides basic animation of a `CALayer` property. This class is much like Core Animation's `CABasicAnimation` except it allows for custom interpolation using `AMCurve`.
+ 
+ Keyframes are generated lazily - when the animation is added to a layer, or when `keyTimes` or `values` are read - so configuring an animation is cheap. The curve is sampled at `keyframeRate` and keyframes that can be reproduced by linear interpolation within `keyframeTolerance` are dropped.
  */
 @interface AMCurvedAnimation : CAKeyframeAnimation
 
@@ -57,4 +63,46 @@
  */
 @property (nonatomic,strong,nullable) id<AMInterpolatable> toValue;
 
+/*!
+ The velocity at which the animation should begin - in units of the value per second. Default is `nil`, which begins at the velocity of the curve.
+ 
+ @discussion Used to continue the motion of an interrupted animation. Animations with an initial velocity keep all samples, and do not share keyframes through the cache. Ignored for values without a velocity (generic values and transforms).
+ */
+@property (nonatomic,strong,nullable) id<AMInterpolatable> initialVelocity;
+
+/*!
+ The color space in which `UIColor` and `CGColorRef` values are interpolated. Default is `AMColorSpaceSRGB`.
+ 
+ @discussion The endpoints are converted into the color space once for all keyframes. Keyframes are generated in the color space and reduced on their sRGB components - so only the interpolation between them is in sRGB, as Core Animation interpolates colors.
+ */
+@property (nonatomic) AMColorSpace colorSpace;
+
+/*!
+ An interpolator that generates the values - replacing `fromValue`, `toValue`, `initialVelocity` and `colorSpace`. Default is `nil`.
+ 
+ @discussion Use it for values that do not follow from two endpoints - like a point moving along an `AMMotionPath`. Animations with an interpolator keep all samples, as their values are not linear in the curve, and do not share keyframes through the cache.
+ */
+@property (nonatomic,strong,nullable) AMInterpolator *interpolator;
+
+/// -------------------------
+/// @name Keyframe Generation
+/// -------------------------
+
+/*!
+ The number of times per second the curve is sampled. Default is 60. Use 120 for high refresh rate displays.
+ */
+@property (nonatomic) double keyframeRate;
+
+/*!
+ The maximum deviation from the curve allowed when removing redundant keyframes - where one is the distance between `fromValue` and `toValue`. Default is 0.001. Set to zero to keep all samples.
+ 
+ @discussion The deviation is measured on the curve - values with non-linear interpolation (like transforms) may deviate slightly more. Colors outside of sRGB are measured on their sRGB components instead.
+ */
+@property (nonatomic) double keyframeTolerance;
+
+/*!
+ The cache used to share keyframes between animations with identical setups. Default is the shared cache. Set to `nil` to always generate keyframes.
+ */
+@property (nonatomic,strong,nullable) AMKeyframeCache *keyframeCache;
+
 @end
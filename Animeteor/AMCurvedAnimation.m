@@ -30,9 +30,18 @@
 
 #import "AMCurve.h"
 #import "AMInterpolatable.h"
+#import "AMInterpolator.h"
+#import "AMKeyframeCache.h"
+#import "AMInstrumentation.h"
 
 #import "AMCurvedAnimation.h"
 
+@interface AMCurvedAnimation () {
+    BOOL _keyframesNeedUpdate;
+}
+
+@end
+
 @implementation AMCurvedAnimation
 
 #pragma mark - Creating an Animation
@@ -48,28 +57,191 @@
     
 }
 
+- (instancetype)init {
+    
+    if ((self = [super init])) {
+        
+        _keyframeRate = 60.0;
+        _keyframeTolerance = 0.001;
+        _keyframeCache = [AMKeyframeCache sharedCache];
+        
+    }
+    
+    return self;
+    
+}
+
+- (id)copyWithZone:(NSZone *)zone {
+    
+    /* Core Animation copies the animation when added to a layer - so this is the latest point to generate keyframes. */
+    [self updateKeyframesIfNeeded];
+    
+    AMCurvedAnimation *animation = [super copyWithZone:zone];
+    
+    animation->_curve = _curve;
+    animation->_fromValue = _fromValue;
+    animation->_toValue = _toValue;
+    animation->_initialVelocity = _initialVelocity;
+    animation->_colorSpace = _colorSpace;
+    animation->_interpolator = _interpolator;
+    animation->_keyframeRate = _keyframeRate;
+    animation->_keyframeTolerance = _keyframeTolerance;
+    animation->_keyframeCache = _keyframeCache;
+    animation->_keyframesNeedUpdate = NO;
+    
+    return animation;
+    
+}
+
 #pragma mark - Private Methods
 
-- (void)applyInterpolationIfSetupComplete {
+- (void)setNeedsKeyframesUpdate {
+    
+    _keyframesNeedUpdate = YES;
     
-    if (self.duration && self.curve && self.fromValue && self.toValue && self.speed) {
+}
+
+- (void)updateKeyframesIfNeeded {
+    
+    if (!_keyframesNeedUpdate)
+        return;
+    
+    _keyframesNeedUpdate = NO;
+    
+    if (self.duration && self.curve && (self.interpolator || (self.fromValue && self.toValue)) && self.speed && self.keyframeRate > 0.0) {
         
-        NSMutableArray *keyTimes = [[NSMutableArray alloc] init];
-        NSMutableArray *values = [[NSMutableArray alloc] init];
+        NSArray *keyTimes;
+        NSArray *values;
         
-        for (NSTimeInterval t = .0 ; t <= 1.0 ; t += 1.0 / (60.0 * (self.duration / self.speed))) {
-            
-            [keyTimes addObject:@(t)];
-            [values addObject:[self.fromValue interpolateWithValue:self.toValue
-                                                        atPosition:[self.curve transform:t]]];
-            
+        AMInterpolator *interpolator = self.interpolator;
+        BOOL carriesVelocity = NO;
+        
+        /* The animation plays over its duration scaled by its speed - which the velocity is relative to. */
+        NSTimeInterval effectiveDuration = fabs(self.duration / self.speed);
+        
+        /* Keyframes with an initial velocity are specific to the interrupted animation - and do not follow the curve alone. */
+        if (!interpolator && self.initialVelocity) {
+            interpolator = [[AMInterpolator alloc] initWithFromValue:self.fromValue toValue:self.toValue colorSpace:self.colorSpace];
+            carriesVelocity = [interpolator setInitialVelocity:self.initialVelocity slope:[self.curve derivative:0.0] duration:effectiveDuration];
         }
         
-        self.keyTimes = keyTimes;
-        self.values = values;
+        /* Keyframes of specific interpolators are neither cached nor reduced. */
+        BOOL keepsSamples = (carriesVelocity || self.interpolator);
+        
+        if (!keepsSamples && [self.keyframeCache getKeyTimes:&keyTimes values:&values forAnimation:self]) {
+            super.keyTimes = keyTimes;
+            super.values = values;
+            return;
+        }
+        
+        AM_INSTRUMENT_BEGIN(AMInstrumentationPhaseKeyframes);
+        
+        /* Times are computed from an integer index, so they never drift and the last one is always exactly one. */
+        NSUInteger frames = MAX((NSUInteger)ceil(effectiveDuration * self.keyframeRate), (NSUInteger)1);
+        NSUInteger count = frames + 1;
+        
+        double *times = malloc(sizeof(double) * count);
+        double *positions = malloc(sizeof(double) * count);
+        bool *keep = malloc(sizeof(bool) * count);
+        
+        /* Without memory for the samples the animation has no keyframes - and shows the model value. */
+        if (!times || !positions || !keep) {
+            free(times);
+            free(positions);
+            free(keep);
+            AM_INSTRUMENT_END(AMInstrumentationPhaseKeyframes);
+            super.keyTimes = super.values = nil;
+            return;
+        }
+        
+        for (NSUInteger idx = 0 ; idx < count ; idx++)
+            times[idx] = (double)idx / frames;
+        
+        /* Transform all positions at once. */
+        [self.curve transformPositions:times count:count output:positions];
+        
+        /* The value type is resolved - and colors converted - once for all keyframes. */
+        interpolator = interpolator ?: [[AMInterpolator alloc] initWithFromValue:self.fromValue toValue:self.toValue colorSpace:self.colorSpace];
+        
+        NSUInteger kept;
+        
+        /* Colors outside of sRGB do not follow the curve position - so they are reduced on the sRGB components Core Animation interpolates. */
+        if (!keepsSamples && interpolator.type == AMInterpolatorTypeColor && interpolator.colorSpace != AMColorSpaceSRGB) {
+            double *components = malloc(sizeof(double) * 4 * count);
+            if (components) {
+                CGFloat rgba[4];
+                for (NSUInteger idx = 0 ; idx < count ; idx++) {
+                    [interpolator interpolateAtPosition:positions[idx] into:rgba];
+                    for (NSUInteger component = 0 ; component < 4 ; component++)
+                        components[idx * 4 + component] = rgba[component];
+                }
+                kept = AMCurveReduceComponentSamples(times, components, 4, count, self.keyframeTolerance, keep);
+                free(components);
+            } else
+                kept = AMCurveReduceSamples(times, positions, count, 0.0, keep);
+        } else
+            kept = AMCurveReduceSamples(times, positions, count, (keepsSamples ? 0.0 : self.keyframeTolerance), keep);
+        
+        /* Compact the kept samples in place. */
+        NSUInteger keptIndex = 0;
+        for (NSUInteger idx = 0 ; idx < count ; idx++) {
+            if (!keep[idx]) continue;
+            times[keptIndex] = times[idx];
+            positions[keptIndex] = positions[idx];
+            keptIndex++;
+        }
+        
+        NSMutableArray *generatedKeyTimes = [[NSMutableArray alloc] initWithCapacity:kept];
+        for (NSUInteger idx = 0 ; idx < kept ; idx++)
+            [generatedKeyTimes addObject:@(times[idx])];
+        
+        NSArray *generatedValues;
+        
+        if (carriesVelocity) {
+            NSMutableArray *carriedValues = [[NSMutableArray alloc] initWithCapacity:kept];
+            for (NSUInteger idx = 0 ; idx < kept ; idx++)
+                [carriedValues addObject:[interpolator valueAtPosition:positions[idx] progress:times[idx]]];
+            generatedValues = carriedValues;
+        } else
+            generatedValues = [interpolator valuesAtPositions:positions count:kept];
+        
+        free(times);
+        free(positions);
+        free(keep);
+        
+        AM_INSTRUMENT_END(AMInstrumentationPhaseKeyframes);
+        AM_INSTRUMENT_KEYFRAMES(kept);
+        
+        /* Immutable copies are shared by all animations with the same setup. */
+        keyTimes = [generatedKeyTimes copy];
+        values = [generatedValues copy];
+        
+        if (!keepsSamples)
+            [self.keyframeCache setKeyTimes:keyTimes values:values forAnimation:self];
+        
+        super.keyTimes = keyTimes;
+        super.values = values;
         
     } else
-        self.keyTimes = self.values = nil;
+        super.keyTimes = super.values = nil;
+    
+}
+
+#pragma mark - Keyframes
+
+- (NSArray<NSNumber *> *)keyTimes {
+    
+    [self updateKeyframesIfNeeded];
+    
+    return [super keyTimes];
+    
+}
+
+- (NSArray *)values {
+    
+    [self updateKeyframesIfNeeded];
+    
+    return [super values];
     
 }
 
@@ -79,7 +251,7 @@
     
     [super setSpeed:speed];
     
-    [self applyInterpolationIfSetupComplete];
+    [self setNeedsKeyframesUpdate];
     
 }
 
@@ -87,7 +259,7 @@
     
     [super setDuration:duration];
     
-    [self applyInterpolationIfSetupComplete];
+    [self setNeedsKeyframesUpdate];
     
 }
 
@@ -95,7 +267,7 @@
     
     _curve = curve;
     
-    [self applyInterpolationIfSetupComplete];
+    [self setNeedsKeyframesUpdate];
     
 }
 
@@ -103,7 +275,7 @@
     
     _fromValue = fromValue;
     
-    [self applyInterpolationIfSetupComplete];
+    [self setNeedsKeyframesUpdate];
     
 }
 
@@ -111,7 +283,47 @@
     
     _toValue = toValue;
     
-    [self applyInterpolationIfSetupComplete];
+    [self setNeedsKeyframesUpdate];
+    
+}
+
+- (void)setInitialVelocity:(id<AMInterpolatable>)initialVelocity {
+    
+    _initialVelocity = initialVelocity;
+    
+    [self setNeedsKeyframesUpdate];
+    
+}
+
+- (void)setColorSpace:(AMColorSpace)colorSpace {
+    
+    _colorSpace = colorSpace;
+    
+    [self setNeedsKeyframesUpdate];
+    
+}
+
+- (void)setInterpolator:(AMInterpolator *)interpolator {
+    
+    _interpolator = interpolator;
+    
+    [self setNeedsKeyframesUpdate];
+    
+}
+
+- (void)setKeyframeRate:(double)keyframeRate {
+    
+    _keyframeRate = keyframeRate;
+    
+    [self setNeedsKeyframesUpdate];
+    
+}
+
+- (void)setKeyframeTolerance:(double)keyframeTolerance {
+    
+    _keyframeTolerance = keyframeTolerance;
+    
+    [self setNeedsKeyframesUpdate];
     
 }
 
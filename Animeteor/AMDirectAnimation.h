@@ -29,13 +29,26 @@
 //
 
 #import "AMAnimation.h"
+#import "AMAnimationRegistry.h"
+#import "AMColorKernels.h"
 
+@class AMCurve;
+@class AMFrameTicker;
+@class AMMotionPath;
 @protocol AMInterpolatable;
 
+/*!
+ A prototype of a block that sets the animated value on an object.
+ 
+ @param object The object being animated.
+ @param value  A pointer to the unboxed value - a `double` for numbers, the struct for `NSValue` types (like `CGPoint` or `CATransform3D`), four `CGFloat` (red, green, blue and alpha in sRGB) for colors, the elements for `AMNumericBuffer` values, or an `id` for other types.
+ */
+typedef void (^AMDirectAnimationSetterBlock)(id _Nonnull object, const void * _Nonnull value);
+
 /*!
  The `AMDirectAnimation` class enables animating anything not normally animatable. The `AMDirectAnimation` does not use Core Animation. Instead it sets the values of properties directly on objects. This is useful when you want to animate as an example the `contentOffset` of a `UIScrollView` instance - or the `volume` property of a `AVAudioPlayer` instance.
  */
-@interface AMDirectAnimation : NSObject <AMAnimation>
+@interface AMDirectAnimation : NSObject <AMRetargetableAnimation>
 
 /// ---------------------------
 /// @name Creating an Animation
@@ -51,7 +64,7 @@
  @param keyPath    The keypath of the object to animate.
  @param fromValue  Animate from this value. Providing `nil` will default to keyPaths current value on the object.
  @param toValue    Animate to this value.
- @param duration   The duration of the animation.
+ @param duration   The duration of the animation. Providing zero with a spring curve will default to the settling duration of the spring.
  @param delay      The delay of the animation.
  @param curve      The curve of the animation. Providing `nil` will default to a linear curve.
  @param completion An optional completion block that gets called when the animation completes.
@@ -67,4 +80,129 @@
                                   curve:(AMCurve * _Nullable)curve
                              completion:(AMCompletionBlock _Nullable)completion;
 
+/*!
+ Returns an initialized direct animation object that moves a point along a motion path at constant speed.
+ 
+ @param object     The object to animate.
+ @param keyPath    The keypath of a `CGPoint` of the object to animate - like `center` of a view.
+ @param motionPath The path to move along.
+ @param duration   The duration of the animation. Providing zero with a spring curve will default to the settling duration of the spring.
+ @param delay      The delay of the animation.
+ @param curve      The curve of the animation - which moves the point along the path. Providing `nil` will default to a linear curve.
+ @param completion An optional completion block that gets called when the animation completes.
+ 
+ @return An initialized direct animation object.
+ */
+- (instancetype _Nonnull)initWithObject:(id _Nonnull)object
+                                keyPath:(NSString * _Nonnull)keyPath
+                             motionPath:(AMMotionPath * _Nonnull)motionPath
+                               duration:(NSTimeInterval)duration
+                                  delay:(NSTimeInterval)delay
+                                  curve:(AMCurve * _Nullable)curve
+                             completion:(AMCompletionBlock _Nullable)completion;
+
+/// -----------------------------------
+/// @name Getting Animation Information
+/// -----------------------------------
+
+/*!
+ Returns the key path being animated.
+ */
+@property (nonatomic,copy,readonly,nonnull) NSString *keyPath;
+
+/*!
+ Returns the curve of the animation.
+ */
+@property (nonatomic,strong,readonly,nonnull) AMCurve *curve;
+
+/*!
+ Returns the motion path of the animation, or `nil` if it animates between two values.
+ */
+@property (nonatomic,strong,readonly,nullable) AMMotionPath *motionPath;
+
+/// ------------------------
+/// @name Configuring Timing
+/// ------------------------
+
+/*!
+ The ticker that steps the animation. Default is the shared ticker. Providing `nil` will reset it to the shared ticker.
+ 
+ @discussion When the ticker is pipelined, the curve and interpolation of the next frame are computed on the ticker's worker queue - leaving only applying the value to the main thread. Custom curves must then be safe to call from any thread.
+ */
+@property (nonatomic,null_resettable) AMFrameTicker *ticker;
+
+/*!
+ The number of frames per second the animation is stepped at. Default is zero - which steps the animation at the native frame rate of the ticker.
+ 
+ @discussion The ticker's display link runs at the highest rate preferred by its animations, and animations preferring a lower rate skip the frames in between. Use a low rate for slow or long running animations - like progress bars or volume fades - that do not need every frame. The last frame of the animation is always applied.
+ */
+@property (nonatomic) NSInteger preferredFramesPerSecond;
+
+/*!
+ Determines how the animation resolves a conflict with another animation of the same key path on the same object. Default is `AMAnimationConflictPolicyReplace`.
+ 
+ @discussion The conflict is resolved when the animation takes effect - after its delay. See `AMAnimationRegistry`.
+ */
+@property (nonatomic) AMAnimationConflictPolicy conflictPolicy;
+
+/// -------------------------------
+/// @name Configuring Interpolation
+/// -------------------------------
+
+/*!
+ The color space in which `UIColor` and `CGColorRef` values are interpolated. Default is `AMColorSpaceSRGB`.
+ 
+ @discussion The endpoints are converted into the color space once as the animation begins - each frame is then a lerp and a conversion back into sRGB. Use `AMColorSpaceOKLab` for transitions that change lightness and hue evenly, without the muddy midpoints of sRGB.
+ */
+@property (nonatomic) AMColorSpace colorSpace;
+
+/// -------------------------
+/// @name Configuring Setting
+/// -------------------------
+
+/*!
+ An optional block that sets the animated value on the object - replacing key-value coding. Default is `nil`.
+ 
+ @discussion Without a setter block the key path is resolved once as the animation begins. If the object at the key path responds to a setter accepting the unboxed type of the values, the setter is called directly on every frame. Otherwise values are set using key-value coding.
+ 
+ `AMNumericBuffer` values are interpolated in place into a buffer allocated as the animation begins - and that same buffer is set on every frame. Objects must read its elements as it is set, rather than compare it to the buffer they hold.
+ */
+@property (nonatomic,copy,nullable) AMDirectAnimationSetterBlock setter;
+
+/*!
+ The smallest change of a value that is written to the object - measured on each component of the value (like the `x` and `y` of a point, or each element of a buffer). Frames changing the value less than this are skipped. Default is zero - which writes every frame.
+ 
+ @discussion Writing a value can trigger layout or other side effects in the animated object - use a threshold below what is visible (like a fraction of a point) to avoid writes the user cannot see. The last frame of the animation is always written. Generic values are always written.
+ */
+@property (nonatomic) double writeThreshold;
+
+/*!
+ An optional key path that is set to the tangent angle of the motion path - in radians - on every frame. Default is `nil`.
+ 
+ @discussion Use it to turn what moves along the path in the direction of motion - like `transform.rotation.z` of a layer. Ignored by animations without a motion path.
+ */
+@property (nonatomic,copy,nullable) NSString *rotationKeyPath;
+
+/// -----------------------
+/// @name Evaluating Values
+/// -----------------------
+
+/*!
+ Returns the value of the animation at a specific time. The animation does not need to be running.
+ 
+ @param time The time since the animation would begin - including its delay.
+ 
+ @return The interpolated value.
+ */
+- (id<AMInterpolatable> _Nonnull)valueAtTime:(NSTimeInterval)time;
+
+/*!
+ Returns the velocity of the animation at a specific time. The animation does not need to be running.
+ 
+ @param time The time since the animation would begin - including its delay.
+ 
+ @return The velocity in units of the value per second - or `nil` for values without a velocity (generic values and transforms).
+ */
+- (id<AMInterpolatable> _Nullable)velocityAtTime:(NSTimeInterval)time;
+
 @end
@@ -29,26 +29,84 @@
 //
 
 @import ObjectiveC.runtime;
-@import UIKit;
+@import QuartzCore;
 
 #import "AMMacros.h"
 
 #import "AMCurve.h"
+#import "AMSpringCurve.h"
+#import "AMFrameTicker.h"
 #import "AMInterpolatable.h"
+#import "AMInterpolator.h"
+#import "AMMotionPath.h"
+#import "AMNumericBuffer.h"
+#import "AMBufferKernels.h"
+#import "AMInstrumentation.h"
+#import "AMAnimationRegistry.h"
+#import "AMAnimationGroup+Private.h"
 
 #import "AMDirectAnimation.h"
 
 const void *AMDirectAnimationKey;
 
-@interface AMDirectAnimation ()
+// Fraction of the preferred frame interval that must pass before a frame is applied - leaves room for jitter of the display link.
+#define FRAME_INTERVAL_TOLERANCE .75
+
+typedef NS_ENUM(NSUInteger, AMDirectAnimationSetterKind) {
+    AMDirectAnimationSetterKindKeyValueCoding = 0,
+    AMDirectAnimationSetterKindBlock,
+    AMDirectAnimationSetterKindDouble,
+    AMDirectAnimationSetterKindFloat,
+    AMDirectAnimationSetterKindPair,
+    AMDirectAnimationSetterKindRect,
+    AMDirectAnimationSetterKindTransform3D,
+    AMDirectAnimationSetterKindObject
+};
+
+/* A value prepared ahead by a pipelined ticker. */
+typedef struct {
+    NSUInteger frame;
+    double progress;
+    double position;
+    BOOL hasValue;
+    union {
+        double number;
+        CGPoint pair;
+        CGRect rect;
+        CATransform3D transform;
+    } value;
+} AMDirectAnimationFrame;
+
+@interface AMDirectAnimation () <AMFrameTickerClient> {
+    AMDirectAnimationSetterKind _setterKind;
+    __weak id _setterTarget;
+    SEL _setterSelector;
+    IMP _setterIMP;
+    /* Reused storage for unboxed values - and the value last written to the object. */
+    union {
+        double number;
+        CGPoint pair;
+        CGRect rect;
+        CATransform3D transform;
+    } _value, _writtenValue;
+    BOOL _hasWrittenValue;
+    /* Buffers are interpolated in place - into the same buffer written to the object on every frame. */
+    AMNumericBuffer *_buffer;
+    AMNumericBuffer *_writtenBuffer;
+    /* Double buffer of prepared frames - indexed by frame parity. */
+    AMDirectAnimationFrame _preparedFrames[2];
+    CFTimeInterval _appliedFrameTime;
+    BOOL _registered;
+}
 
 @property (weak,nonatomic) id object;
-@property (nonatomic) NSString *keyPath;
+@property (nonatomic,copy) NSString *keyPath;
 @property (nonatomic) id<AMInterpolatable> fromValue;
 @property (nonatomic) id<AMInterpolatable> toValue;
+@property (nonatomic) AMInterpolator *interpolator;
 @property (nonatomic) AMCurve *curve;
-@property (nonatomic) CADisplayLink *displayLink;
-@property (nonatomic) NSDate *beginTime;
+@property (nonatomic) AMCurveFunction curveFunction;
+@property (nonatomic) CFTimeInterval beginTime;
 
 @property (nonatomic,readwrite,getter = isAnimating) BOOL animating;
 @property (nonatomic,readwrite,getter = isComplete) BOOL complete;
@@ -74,13 +132,20 @@ const void *AMDirectAnimationKey;
     if ((self = [super init])) {
         
         _object = object;
-        _keyPath = keyPath;
+        _keyPath = [keyPath copy];
         _duration = duration;
         _delay = delay;
-        _fromValue = [fromValue copyWithZone:nil];
-        _toValue = [toValue copyWithZone:nil];
+        _fromValue = AMInterpolatableCopy(fromValue);
+        _toValue = AMInterpolatableCopy(toValue);
         _curve = (curve ?: [AMCurve linear]);
         _completion = [completion copy];
+        _ticker = [AMFrameTicker sharedTicker];
+        
+        AM_INSTRUMENT_CREATED(AMInstrumentationObjectDirectAnimation);
+        
+        /* Springs know their own duration. */
+        if (_duration <= 0.0 && [_curve isKindOfClass:[AMSpringCurve class]])
+            _duration = ((AMSpringCurve *)_curve).settlingDuration;
         
         objc_setAssociatedObject(self, &AMDirectAnimationKey, self, OBJC_ASSOCIATION_RETAIN_NONATOMIC);
         
@@ -95,12 +160,42 @@ const void *AMDirectAnimationKey;
     
 }
 
+- (instancetype)initWithObject:(id)object
+                       keyPath:(NSString *)keyPath
+                    motionPath:(AMMotionPath *)motionPath
+                      duration:(NSTimeInterval)duration
+                         delay:(NSTimeInterval)delay
+                         curve:(AMCurve *)curve
+                    completion:(void (^)(BOOL finished))completion {
+    
+    if ((self = [self initWithObject:object
+                             keyPath:keyPath
+                           fromValue:[NSValue valueWithCGPoint:motionPath.startPoint]
+                             toValue:[NSValue valueWithCGPoint:motionPath.endPoint]
+                            duration:duration
+                               delay:delay
+                               curve:curve
+                          completion:completion])) {
+        
+        _motionPath = motionPath;
+        
+    }
+    
+    return self;
+    
+}
+
+- (void)dealloc {
+    
+    AM_INSTRUMENT_DESTROYED(AMInstrumentationObjectDirectAnimation);
+    
+}
+
 #pragma mark - Internals
 
 - (void)endAnimation:(BOOL)animationFinished {
     
-    [self.displayLink invalidate];
-    self.displayLink = nil;
+    [self.ticker removeClient:self];
     
     self.complete = YES;
     self.finished = animationFinished;
@@ -108,18 +203,463 @@ const void *AMDirectAnimationKey;
     if (self.completion)
         self.completion(animationFinished);
     
+    AMAnimationGroupAnimationCompleted(self, animationFinished);
+    
+    if (_registered)
+        [AMAnimationRegistry unregisterAnimation:self forTarget:self.object keyPath:self.keyPath];
+    
     objc_setAssociatedObject(self, &AMDirectAnimationKey, nil, OBJC_ASSOCIATION_RETAIN_NONATOMIC);
     
 }
 
-- (void)displayDidUpdate:(CADisplayLink *)displayLink {
+- (void)registerAnimation {
+    
+    _registered = YES;
+    
+    id object = self.object;
+    if (!object)
+        return;
+    
+    /* The presented value and velocity must be read before the current animation is cancelled. */
+    id<AMInterpolatable> presentationValue = nil;
+    id<AMInterpolatable> presentationVelocity = nil;
+    
+    if (self.conflictPolicy == AMAnimationConflictPolicyRetarget) {
+        id current = [AMAnimationRegistry animationForTarget:object keyPath:self.keyPath];
+        if ([current conformsToProtocol:@protocol(AMRetargetableAnimation)]) {
+            presentationValue = [current presentationValue];
+            presentationVelocity = [current presentationVelocity];
+        }
+    }
+    
+    id<AMAnimation> previous = [AMAnimationRegistry registerAnimation:self forTarget:object keyPath:self.keyPath];
+    
+    /* Motion paths begin where the path begins. */
+    if (previous && self.conflictPolicy != AMAnimationConflictPolicyReplace && !self.motionPath) {
+        
+        /* The worker may be preparing a frame with the interpolator about to be replaced. */
+        [self.ticker waitForPreparedFrame];
+        _preparedFrames[0].frame = _preparedFrames[1].frame = 0;
+        
+        self.fromValue = presentationValue ?: [object valueForKeyPath:self.keyPath];
+        self.interpolator = [[AMInterpolator alloc] initWithFromValue:self.fromValue toValue:self.toValue colorSpace:self.colorSpace];
+        
+        /* The setter depends on the type of the interpolator - and the last written value belongs to the old one. */
+        [self resolveSetter];
+        [self resolveBuffer];
+        _hasWrittenValue = NO;
+        
+        if (presentationVelocity)
+            [self.interpolator setInitialVelocity:presentationVelocity slope:[self slopeAtProgress:0.0] duration:self.duration];
+        
+    }
+    
+}
+
+- (void)resolveSetter {
+    
+    _setterKind = AMDirectAnimationSetterKindKeyValueCoding;
+    _setterTarget = nil;
+    _setterIMP = NULL;
+    
+    if (self.setter) {
+        _setterKind = AMDirectAnimationSetterKindBlock;
+        return;
+    }
+    
+    if (self.interpolator.type == AMInterpolatorTypeGeneric)
+        return;
+    
+    /* Resolve the object owning the last key of the path. */
+    NSRange range = [self.keyPath rangeOfString:@"." options:NSBackwardsSearch];
+    id target = (range.location == NSNotFound ? self.object : [self.object valueForKeyPath:[self.keyPath substringToIndex:range.location]]);
+    NSString *key = (range.location == NSNotFound ? self.keyPath : [self.keyPath substringFromIndex:NSMaxRange(range)]);
+    
+    if (!target || [key length] == 0)
+        return;
+    
+    SEL selector = NSSelectorFromString([NSString stringWithFormat:@"set%@%@:", [[key substringToIndex:1] uppercaseString], [key substringFromIndex:1]]);
+    
+    if (![target respondsToSelector:selector])
+        return;
+    
+    NSMethodSignature *signature = [target methodSignatureForSelector:selector];
+    if ([signature numberOfArguments] != 3)
+        return;
+    
+    const char *argumentType = [signature getArgumentTypeAtIndex:2];
+    AMDirectAnimationSetterKind kind = AMDirectAnimationSetterKindKeyValueCoding;
+    
+    switch (self.interpolator.type) {
+        case AMInterpolatorTypeNumber:
+            if (0 == strcmp(argumentType, @encode(double))) kind = AMDirectAnimationSetterKindDouble;
+            else if (0 == strcmp(argumentType, @encode(float))) kind = AMDirectAnimationSetterKindFloat;
+            break;
+        case AMInterpolatorTypePoint:
+        case AMInterpolatorTypeSize:
+        case AMInterpolatorTypeVector:
+            if (0 == strcmp(argumentType, self.interpolator.objCType)) kind = AMDirectAnimationSetterKindPair;
+            break;
+        case AMInterpolatorTypeRect:
+            if (0 == strcmp(argumentType, self.interpolator.objCType)) kind = AMDirectAnimationSetterKindRect;
+            break;
+        case AMInterpolatorTypeTransform3D:
+            if (0 == strcmp(argumentType, self.interpolator.objCType)) kind = AMDirectAnimationSetterKindTransform3D;
+            break;
+        case AMInterpolatorTypeBuffer:
+            if (0 == strcmp(argumentType, @encode(id))) kind = AMDirectAnimationSetterKindObject;
+            break;
+        default:
+            break;
+    }
+    
+    if (kind == AMDirectAnimationSetterKindKeyValueCoding)
+        return;
+    
+    _setterKind = kind;
+    _setterTarget = target;
+    _setterSelector = selector;
+    _setterIMP = [target methodForSelector:selector];
+    
+}
+
+- (void)resolveBuffer {
+    
+    if (self.interpolator.type != AMInterpolatorTypeBuffer) {
+        _buffer = _writtenBuffer = nil;
+        return;
+    }
+    
+    AMNumericBuffer *fromBuffer = (AMNumericBuffer *)self.interpolator.fromValue;
+    
+    if (![_buffer isCompatibleWithBuffer:fromBuffer])
+        _buffer = [[AMNumericBuffer alloc] initWithType:fromBuffer.type count:fromBuffer.count];
+    
+    /* Buffers with a threshold are compared to a copy of the buffer last written. */
+    if (_writeThreshold <= 0.0)
+        _writtenBuffer = nil;
+    else if (![_writtenBuffer isCompatibleWithBuffer:fromBuffer])
+        _writtenBuffer = [[AMNumericBuffer alloc] initWithType:fromBuffer.type count:fromBuffer.count];
+    
+}
+
+- (void)applyValueAtPosition:(double)position progress:(double)progress {
+    
+    if (_buffer) {
+        [self applyBufferAtPosition:position progress:progress];
+        return;
+    }
+    
+    if (_setterKind == AMDirectAnimationSetterKindKeyValueCoding) {
+        
+        id value;
+        
+        AM_INSTRUMENT_BEGIN(AMInstrumentationPhaseInterpolation);
+        
+        /* Values with a threshold are compared unboxed - and only boxed if written. */
+        if (_writeThreshold > 0.0 && self.interpolator.type != AMInterpolatorTypeGeneric) {
+            [self.interpolator interpolateAtPosition:position progress:progress into:&_value];
+            value = ([self shouldWriteStoredValueAtProgress:progress] ? [self boxedStoredValue] : nil);
+        } else
+            value = [self.interpolator valueAtPosition:position progress:progress];
+        
+        AM_INSTRUMENT_END(AMInstrumentationPhaseInterpolation);
+        
+        if (!value)
+            return;
+        
+        AM_INSTRUMENT_BEGIN(AMInstrumentationPhaseWrite);
+        [self.object setValue:value forKeyPath:self.keyPath];
+        AM_INSTRUMENT_END(AMInstrumentationPhaseWrite);
+        
+        return;
+        
+    }
+    
+    AM_INSTRUMENT_BEGIN(AMInstrumentationPhaseInterpolation);
+    BOOL unboxed = [self.interpolator interpolateAtPosition:position progress:progress into:&_value];
+    AM_INSTRUMENT_END(AMInstrumentationPhaseInterpolation);
+    
+    if (!unboxed) {
+        
+        /* Only setter blocks are used with generic values. */
+        id object = self.object;
+        id value = [self.interpolator valueAtPosition:position progress:progress];
+        
+        AM_INSTRUMENT_BEGIN(AMInstrumentationPhaseWrite);
+        if (object)
+            self.setter(object, &value);
+        AM_INSTRUMENT_END(AMInstrumentationPhaseWrite);
+        
+        return;
+        
+    }
+    
+    [self applyStoredValueAtProgress:progress];
+    
+}
+
+- (void)applyBufferAtPosition:(double)position progress:(double)progress {
+    
+    AM_INSTRUMENT_BEGIN(AMInstrumentationPhaseInterpolation);
+    [self.interpolator interpolateAtPosition:position progress:progress into:_buffer.mutableBytes];
+    BOOL write = (!_writtenBuffer || [self shouldWriteBufferAtProgress:progress]);
+    AM_INSTRUMENT_END(AMInstrumentationPhaseInterpolation);
+    
+    id object = self.object;
+    
+    if (!write || !object)
+        return;
+    
+    AM_INSTRUMENT_BEGIN(AMInstrumentationPhaseWrite);
+    
+    id target = _setterTarget;
+    
+    if (_setterKind == AMDirectAnimationSetterKindBlock)
+        self.setter(object, _buffer.bytes);
+    else if (_setterKind == AMDirectAnimationSetterKindObject && target)
+        ((void (*)(id, SEL, id))_setterIMP)(target, _setterSelector, _buffer);
+    else
+        [object setValue:_buffer forKeyPath:self.keyPath];
+    
+    AM_INSTRUMENT_END(AMInstrumentationPhaseWrite);
+    
+}
+
+- (BOOL)shouldWriteBufferAtProgress:(double)progress {
+    
+    /* The first and last values are always written. */
+    BOOL changed = (!_hasWrittenValue || progress >= 1.0);
+    
+    if (!changed) {
+        if (_buffer.type == AMNumericBufferTypeDouble)
+            changed = AMBufferDiffersDoubles(_buffer.bytes, _writtenBuffer.bytes, _writeThreshold, _buffer.count);
+        else
+            changed = AMBufferDiffersFloats(_buffer.bytes, _writtenBuffer.bytes, _writeThreshold, _buffer.count);
+    }
+    
+    if (changed) {
+        memcpy(_writtenBuffer.mutableBytes, _buffer.bytes, self.interpolator.valueSize);
+        _hasWrittenValue = YES;
+    }
+    
+    return changed;
+    
+}
+
+- (BOOL)shouldWriteStoredValueAtProgress:(double)progress {
+    
+    /* The first and last values are always written. */
+    BOOL changed = (!_hasWrittenValue || progress >= 1.0);
+    
+    if (!changed) {
+        
+        if (self.interpolator.type == AMInterpolatorTypeNumber)
+            changed = (fabs(_value.number - _writtenValue.number) >= _writeThreshold);
+        else {
+            const CGFloat *components = (const CGFloat *)&_value;
+            const CGFloat *writtenComponents = (const CGFloat *)&_writtenValue;
+            for (NSUInteger idx = 0, count = self.interpolator.valueSize / sizeof(CGFloat) ; idx < count && !changed ; idx++)
+                changed = (fabs(components[idx] - writtenComponents[idx]) >= _writeThreshold);
+        }
+        
+    }
+    
+    if (changed) {
+        memcpy(&_writtenValue, &_value, sizeof(_value));
+        _hasWrittenValue = YES;
+    }
+    
+    return changed;
+    
+}
+
+- (id)boxedStoredValue {
     
-    double progress = MIN([[NSDate date] timeIntervalSinceDate:self.beginTime] / self.duration, 1.0);
+    return [self.interpolator boxValue:&_value];
     
-    if (progress >= 0 && progress <= 1.0)
-        [self.object setValue:[self.fromValue interpolateWithValue:self.toValue
-                                                        atPosition:[self.curve transform:progress]]
-                   forKeyPath:self.keyPath];
+}
+
+- (void)applyStoredValueAtProgress:(double)progress {
+    
+    if (_writeThreshold > 0.0 && ![self shouldWriteStoredValueAtProgress:progress])
+        return;
+    
+    AM_INSTRUMENT_BEGIN(AMInstrumentationPhaseWrite);
+    [self writeStoredValue];
+    AM_INSTRUMENT_END(AMInstrumentationPhaseWrite);
+    
+}
+
+- (void)writeStoredValue {
+    
+    if (_setterKind == AMDirectAnimationSetterKindBlock) {
+        
+        id object = self.object;
+        if (object)
+            self.setter(object, &_value);
+        
+        return;
+        
+    }
+    
+    id target = _setterTarget;
+    if (!target)
+        return;
+    
+    /* CGPoint, CGSize and CGVector are all pairs of CGFloats - and share calling convention. */
+    switch (_setterKind) {
+        case AMDirectAnimationSetterKindDouble:
+            ((void (*)(id, SEL, double))_setterIMP)(target, _setterSelector, _value.number);
+            break;
+        case AMDirectAnimationSetterKindFloat:
+            ((void (*)(id, SEL, float))_setterIMP)(target, _setterSelector, (float)_value.number);
+            break;
+        case AMDirectAnimationSetterKindPair:
+            ((void (*)(id, SEL, CGPoint))_setterIMP)(target, _setterSelector, _value.pair);
+            break;
+        case AMDirectAnimationSetterKindRect:
+            ((void (*)(id, SEL, CGRect))_setterIMP)(target, _setterSelector, _value.rect);
+            break;
+        case AMDirectAnimationSetterKindTransform3D:
+            ((void (*)(id, SEL, CATransform3D))_setterIMP)(target, _setterSelector, _value.transform);
+            break;
+        default:
+            break;
+    }
+    
+}
+
+- (void)prepareInterpolation {
+    
+    self.fromValue = self.fromValue ?: [self.object valueForKeyPath:self.keyPath];
+    self.curve = self.curve ?: [AMCurve linear];
+    self.curveFunction = self.curve.function;
+    self.interpolator = (self.motionPath ? [[AMInterpolator alloc] initWithMotionPath:self.motionPath] : [[AMInterpolator alloc] initWithFromValue:self.fromValue toValue:self.toValue colorSpace:self.colorSpace]);
+    
+    [self resolveSetter];
+    [self resolveBuffer];
+    
+}
+
+- (void)applyRotationAtPosition:(double)position {
+    
+    if (!self.rotationKeyPath || !self.motionPath)
+        return;
+    
+    AM_INSTRUMENT_BEGIN(AMInstrumentationPhaseWrite);
+    [self.object setValue:@([self.motionPath angleAtPosition:position]) forKeyPath:self.rotationKeyPath];
+    AM_INSTRUMENT_END(AMInstrumentationPhaseWrite);
+    
+}
+
+- (double)positionAtProgress:(double)progress {
+    
+    AM_INSTRUMENT_BEGIN(AMInstrumentationPhaseCurve);
+    
+    /* Build-in curves are evaluated inline without messaging the curve. */
+    double position = (self.curveFunction != AMCurveFunctionCustom ? AMCurveFunctionTransform(self.curveFunction, progress) : [self.curve transform:progress]);
+    
+    AM_INSTRUMENT_END(AMInstrumentationPhaseCurve);
+    
+    return position;
+    
+}
+
+- (double)slopeAtProgress:(double)progress {
+    
+    return (self.curveFunction != AMCurveFunctionCustom ? AMCurveFunctionDerivative(self.curveFunction, progress) : [self.curve derivative:progress]);
+    
+}
+
+- (BOOL)shouldApplyFrameAtTime:(CFTimeInterval)time {
+    
+    /* Frames before the animation begins apply nothing - and the last frame is always applied. */
+    if (_preferredFramesPerSecond <= 0 || time < self.beginTime || time >= self.beginTime + self.duration)
+        return YES;
+    
+    if (_appliedFrameTime > 0.0 && time - _appliedFrameTime < FRAME_INTERVAL_TOLERANCE / _preferredFramesPerSecond)
+        return NO;
+    
+    _appliedFrameTime = time;
+    
+    return YES;
+    
+}
+
+- (double)progressAtTime:(NSTimeInterval)time {
+    
+    if (self.duration <= 0.0)
+        return (time >= self.delay ? 1.0 : 0.0);
+    
+    return MIN(MAX((time - self.delay) / self.duration, 0.0), 1.0);
+    
+}
+
+#pragma mark - Frame Ticker Client
+
+- (void)ticker:(AMFrameTicker *)ticker prepareFrame:(NSUInteger)frame atTime:(CFTimeInterval)time {
+    
+    AMDirectAnimationFrame *preparedFrame = &_preparedFrames[frame & 1];
+    
+    preparedFrame->progress = MIN((time - self.beginTime) / self.duration, 1.0);
+    preparedFrame->position = [self positionAtProgress:MAX(preparedFrame->progress, 0.0)];
+    AM_INSTRUMENT_BEGIN(AMInstrumentationPhaseInterpolation);
+    /* Buffers do not fit a prepared frame - they are interpolated as the frame is applied. */
+    preparedFrame->hasValue = (_setterKind != AMDirectAnimationSetterKindKeyValueCoding && self.interpolator.type != AMInterpolatorTypeBuffer && [self.interpolator interpolateAtPosition:preparedFrame->position progress:MAX(preparedFrame->progress, 0.0) into:&preparedFrame->value]);
+    AM_INSTRUMENT_END(AMInstrumentationPhaseInterpolation);
+    preparedFrame->frame = frame;
+    
+}
+
+- (NSInteger)preferredFramesPerSecondForTicker:(AMFrameTicker *)ticker {
+    
+    return self.preferredFramesPerSecond;
+    
+}
+
+- (void)ticker:(AMFrameTicker *)ticker didTickAtTime:(CFTimeInterval)time {
+    
+    /* Conflicts are resolved as the animation takes effect. */
+    if (!_registered && time >= self.beginTime)
+        [self registerAnimation];
+    
+    if (![self shouldApplyFrameAtTime:time])
+        return;
+    
+    AMDirectAnimationFrame *preparedFrame = &_preparedFrames[ticker.frameIndex & 1];
+    
+    /* Use the frame prepared on the worker queue when available. */
+    if (ticker.isPipelined && preparedFrame->frame == ticker.frameIndex) {
+        
+        double progress = preparedFrame->progress;
+        
+        if (progress >= 0 && progress <= 1.0) {
+            if (preparedFrame->hasValue) {
+                memcpy(&_value, &preparedFrame->value, sizeof(_value));
+                [self applyStoredValueAtProgress:progress];
+            } else
+                [self applyValueAtPosition:preparedFrame->position progress:progress];
+            [self applyRotationAtPosition:preparedFrame->position];
+        }
+        
+        if (progress == 1.0)
+            [self endAnimation:YES];
+        
+        return;
+        
+    }
+    
+    double progress = MIN((time - self.beginTime) / self.duration, 1.0);
+    
+    if (progress >= 0 && progress <= 1.0) {
+        
+        double position = [self positionAtProgress:progress];
+        
+        [self applyValueAtPosition:position progress:progress];
+        [self applyRotationAtPosition:position];
+        
+    }
     
     if (progress == 1.0)
         [self endAnimation:YES];
@@ -135,6 +675,69 @@ const void *AMDirectAnimationKey;
 @synthesize delay=_delay;
 @synthesize completion=_completion;
 
+- (void)setTicker:(AMFrameTicker *)ticker {
+    
+    AMAssertMainThread();
+    AMAssertMutableState();
+    
+    _ticker = ticker ?: [AMFrameTicker sharedTicker];
+    
+}
+
+- (void)setPreferredFramesPerSecond:(NSInteger)preferredFramesPerSecond {
+    
+    AMAssertMainThread();
+    AMAssertMutableState();
+    
+    _preferredFramesPerSecond = preferredFramesPerSecond;
+    
+}
+
+- (void)setColorSpace:(AMColorSpace)colorSpace {
+    
+    AMAssertMainThread();
+    AMAssertMutableState();
+    
+    _colorSpace = colorSpace;
+    
+}
+
+- (void)setWriteThreshold:(double)writeThreshold {
+    
+    AMAssertMainThread();
+    AMAssertMutableState();
+    
+    _writeThreshold = writeThreshold;
+    
+}
+
+- (void)setRotationKeyPath:(NSString *)rotationKeyPath {
+    
+    AMAssertMainThread();
+    AMAssertMutableState();
+    
+    _rotationKeyPath = [rotationKeyPath copy];
+    
+}
+
+- (void)setConflictPolicy:(AMAnimationConflictPolicy)conflictPolicy {
+    
+    AMAssertMainThread();
+    AMAssertMutableState();
+    
+    _conflictPolicy = conflictPolicy;
+    
+}
+
+- (void)setSetter:(AMDirectAnimationSetterBlock)setter {
+    
+    AMAssertMainThread();
+    AMAssertMutableState();
+    
+    _setter = [setter copy];
+    
+}
+
 - (void)setDuration:(NSTimeInterval)duration {
     
     AMAssertMainThread();
@@ -142,6 +745,8 @@ const void *AMDirectAnimationKey;
     
     _duration = duration;
     
+    AMAnimationGroupAnimationRetimed(self);
+    
 }
 
 - (void)setDelay:(NSTimeInterval)delay {
@@ -151,6 +756,8 @@ const void *AMDirectAnimationKey;
     
     _delay = delay;
     
+    AMAnimationGroupAnimationRetimed(self);
+    
 }
 
 - (void)setCompletion:(AMCompletionBlock)completion {
@@ -173,13 +780,11 @@ const void *AMDirectAnimationKey;
         
         [NSObject cancelPreviousPerformRequestsWithTarget:self selector:@selector(beginAnimation) object:nil];
         
-        self.fromValue = self.fromValue ?: [self.object valueForKeyPath:self.keyPath];
-        self.curve = self.curve ?: [AMCurve linear];
+        [self prepareInterpolation];
         
-        self.beginTime = [NSDate dateWithTimeIntervalSinceNow:self.delay];
+        self.beginTime = self.ticker.currentTime + self.delay;
         
-        self.displayLink = [[UIScreen mainScreen] displayLinkWithTarget:self selector:@selector(displayDidUpdate:)];
-        [self.displayLink addToRunLoop:[NSRunLoop mainRunLoop] forMode:NSRunLoopCommonModes];
+        [self.ticker addClient:self];
         
         self.animating = YES;
         
@@ -205,4 +810,82 @@ const void *AMDirectAnimationKey;
     
 }
 
+- (void)seekToTime:(NSTimeInterval)time {
+    
+    AMAssertMainThread();
+    
+    if (!self.interpolator)
+        [self prepareInterpolation];
+    
+    double progress = [self progressAtTime:time];
+    
+    /* Seeking always writes. */
+    _hasWrittenValue = NO;
+    
+    double position = [self positionAtProgress:progress];
+    
+    [self applyValueAtPosition:position progress:progress];
+    [self applyRotationAtPosition:position];
+    
+}
+
+#pragma mark - Evaluating Values
+
+- (id<AMInterpolatable>)valueAtTime:(NSTimeInterval)time {
+    
+    AMAssertMainThread();
+    
+    if (!self.interpolator)
+        [self prepareInterpolation];
+    
+    double progress = [self progressAtTime:time];
+    
+    return [self.interpolator valueAtPosition:[self positionAtProgress:progress] progress:progress];
+    
+}
+
+- (id<AMInterpolatable>)velocityAtTime:(NSTimeInterval)time {
+    
+    AMAssertMainThread();
+    
+    if (!self.interpolator)
+        [self prepareInterpolation];
+    
+    double progress = [self progressAtTime:time];
+    
+    return [self.interpolator velocityAtProgress:progress slope:[self slopeAtProgress:progress] duration:self.duration];
+    
+}
+
+#pragma mark - Retargeting
+
+- (NSTimeInterval)presentationTime {
+    
+    /* The value on screen is the one of the most recent frame. */
+    return self.ticker.frameTime - self.beginTime + self.delay;
+    
+}
+
+- (id<AMInterpolatable>)presentationValue {
+    
+    AMAssertMainThread();
+    
+    if (!self.isAnimating || self.isComplete)
+        return nil;
+    
+    return [self valueAtTime:[self presentationTime]];
+    
+}
+
+- (id<AMInterpolatable>)presentationVelocity {
+    
+    AMAssertMainThread();
+    
+    if (!self.isAnimating || self.isComplete)
+        return nil;
+    
+    return [self velocityAtTime:[self presentationTime]];
+    
+}
+
 @end
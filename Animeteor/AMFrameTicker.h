@@ -0,0 +1,186 @@
+//
+//  AMFrameTicker.h
+//  Animeteor
+//
+//  Copyright (c) 2013-2015, Kristian Trenskow
+//  All rights reserved.
+//  
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are met:
+//  
+//  1. Redistributions of source code must retain the above copyright notice,
+//  this list of conditions and the following disclaimer.
+//  
+//  2. Redistributions in binary form must reproduce the above copyright notice,
+//  this list of conditions and the following disclaimer in the documentation
+//  and/or other materials provided with the distribution.
+//  
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+//  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+//  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+//  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+//  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+//  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+//  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+//  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+//  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+//  POSSIBILITY OF SUCH DAMAGE.
+//
+
+@import Foundation;
+@import QuartzCore;
+
+@class AMFrameTicker;
+
+/*!
+ A prototype that defines a clock used by a ticker.
+ 
+ @return The current time in seconds.
+ */
+typedef CFTimeInterval (^AMClockBlock)(void);
+
+/*!
+ The `AMFrameTickerClient` protocol is implemented by objects that wants to be stepped once every frame by an `AMFrameTicker`.
+ */
+@protocol AMFrameTickerClient <NSObject>
+
+@required
+/*!
+ Tells the client that a new frame has begun.
+ 
+ @param ticker The ticker that ticked.
+ @param time   The timestamp of the frame. All clients stepped in the same frame receive the same timestamp.
+ */
+- (void)ticker:(AMFrameTicker * _Nonnull)ticker didTickAtTime:(CFTimeInterval)time;
+
+@optional
+/*!
+ Tells the client to prepare a future frame. Only sent to clients of pipelined tickers - and always on the ticker's worker queue, so implementations must only read state that does not change while the client is registered.
+ 
+ Frames are prepared one frame ahead into one of two buffers selected by the parity of `frame` - while the main thread applies the other. The client should use the prepared results in `ticker:didTickAtTime:` when the ticker's `frameIndex` equals `frame`.
+ 
+ @param ticker The ticker preparing the frame.
+ @param frame  The index of the frame being prepared.
+ @param time   The predicted timestamp of the frame.
+ */
+- (void)ticker:(AMFrameTicker * _Nonnull)ticker prepareFrame:(NSUInteger)frame atTime:(CFTimeInterval)time;
+
+/*!
+ Asks the client for the frame rate it needs. Clients not implementing this are stepped at the native frame rate of the display.
+ 
+ @param ticker The ticker asking.
+ 
+ @return The number of frames per second the client needs - or zero for the native frame rate.
+ */
+- (NSInteger)preferredFramesPerSecondForTicker:(AMFrameTicker * _Nonnull)ticker;
+
+@end
+
+/*!
+ The `AMFrameTicker` class steps a set of clients once per frame. The shared ticker is driven by a single `CADisplayLink` and samples the frame timestamp once per frame - no matter how many clients are registered. Tickers created with a custom clock are not driven by a display link and needs to be stepped manually using `tick`, which makes them usable in tests and benchmarks.
+ */
+@interface AMFrameTicker : NSObject
+
+/// ---------------------
+/// @name Getting Tickers
+/// ---------------------
+
+/*!
+ Returns the shared ticker driven by the main screen's display link.
+ 
+ @return The shared ticker.
+ */
++ (AMFrameTicker * _Nonnull)sharedTicker;
+
+/// ----------------------
+/// @name Creating Tickers
+/// ----------------------
+
++ (instancetype _Nullable)new UNAVAILABLE_ATTRIBUTE;
+- (instancetype _Nullable)init UNAVAILABLE_ATTRIBUTE;
+
+/*!
+ Returns an initialized ticker that reads time from a custom clock. The ticker is not driven by a display link - use `tick` to step it.
+ 
+ @param clock A block that returns the current time in seconds.
+ 
+ @return An initialized ticker.
+ */
+- (instancetype _Nonnull)initWithClock:(AMClockBlock _Nonnull)clock;
+
+/// ---------------------------
+/// @name Getting Ticker Timing
+/// ---------------------------
+
+/*!
+ Returns the current time of the ticker's clock.
+ */
+@property (nonatomic,readonly) CFTimeInterval currentTime;
+
+/*!
+ Returns the timestamp of the most recent frame.
+ */
+@property (nonatomic,readonly) CFTimeInterval frameTime;
+
+/*!
+ Returns the index of the most recent frame. The index is incremented once per frame starting at one.
+ */
+@property (nonatomic,readonly) NSUInteger frameIndex;
+
+/*!
+ Returns the frame rate requested from the display link - the highest rate needed by any client, or zero for the native frame rate.
+ 
+ @discussion The rate is resolved as clients are added and removed. When all clients prefer a lower rate - like slow progress bars or volume fades - the display link fires less often and the main thread does less work.
+ */
+@property (nonatomic,readonly) NSInteger preferredFramesPerSecond;
+
+/// ----------------------------
+/// @name Configuring Pipelining
+/// ----------------------------
+
+/*!
+ Determines if frames are prepared ahead on a worker queue. Default is `NO`.
+ 
+ @discussion When pipelined, clients implementing `ticker:prepareFrame:atTime:` are asked to prepare the next frame on a worker queue while the main thread applies the current one. The main thread only waits if the worker has not finished preparing by the next frame.
+ */
+@property (nonatomic,getter = isPipelined) BOOL pipelined;
+
+/*!
+ Blocks until the frame being prepared on the worker queue is ready. Use this before changing state that clients read while preparing frames. Does nothing if the ticker has never been pipelined.
+ */
+- (void)waitForPreparedFrame;
+
+/// ----------------------
+/// @name Managing Clients
+/// ----------------------
+
+/*!
+ Returns the number of clients currently registered with the ticker.
+ */
+@property (nonatomic,readonly) NSUInteger numberOfClients;
+
+/*!
+ Adds a client to the ticker. The client is retained until it is removed. A client added while the ticker is ticking will receive its first tick on the next frame.
+ 
+ @param client The client to add.
+ */
+- (void)addClient:(id<AMFrameTickerClient> _Nonnull)client;
+
+/*!
+ Removes a client from the ticker. A client removed while the ticker is ticking will not be stepped again.
+ 
+ @param client The client to remove.
+ */
+- (void)removeClient:(id<AMFrameTickerClient> _Nonnull)client;
+
+/// -------------------
+/// @name Stepping Time
+/// -------------------
+
+/*!
+ Samples the clock once and steps all registered clients with that time.
+ */
+- (void)tick;
+
+@end
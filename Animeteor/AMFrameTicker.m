@@ -0,0 +1,338 @@
+//
+//  AMFrameTicker.m
+//  Animeteor
+//
+//  Copyright (c) 2013-2015, Kristian Trenskow
+//  All rights reserved.
+//  
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are met:
+//  
+//  1. Redistributions of source code must retain the above copyright notice,
+//  this list of conditions and the following disclaimer.
+//  
+//  2. Redistributions in binary form must reproduce the above copyright notice,
+//  this list of conditions and the following disclaimer in the documentation
+//  and/or other materials provided with the distribution.
+//  
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+//  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+//  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+//  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+//  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+//  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+//  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+//  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+//  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+//  POSSIBILITY OF SUCH DAMAGE.
+//
+
+#import "AMMacros.h"
+#import "AMInstrumentation.h"
+
+#import "AMFrameTicker.h"
+
+@interface AMFrameTicker ()
+
+@property (nonatomic,copy) AMClockBlock clock;
+@property (nonatomic) CADisplayLink *displayLink;
+@property (nonatomic) NSMutableArray *clients;
+@property (nonatomic) NSHashTable *pendingRemovals;
+@property (nonatomic,getter = isTicking) BOOL ticking;
+@property (nonatomic) dispatch_queue_t workerQueue;
+@property (nonatomic) dispatch_group_t workerGroup;
+@property (nonatomic) NSArray *preparingClients;
+@property (nonatomic) CFTimeInterval frameDuration;
+
+@property (nonatomic,readwrite) CFTimeInterval frameTime;
+@property (nonatomic,readwrite) NSUInteger frameIndex;
+@property (nonatomic,readwrite) NSInteger preferredFramesPerSecond;
+
+@end
+
+@implementation AMFrameTicker
+
+#pragma mark - Getting Tickers
+
++ (AMFrameTicker *)sharedTicker {
+    
+    static AMFrameTicker *ticker;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        ticker = [[AMFrameTicker alloc] initWithClock:^{
+            return CACurrentMediaTime();
+        }];
+        ticker.displayLink = [CADisplayLink displayLinkWithTarget:ticker selector:@selector(displayDidUpdate:)];
+        ticker.displayLink.paused = YES;
+        [ticker.displayLink addToRunLoop:[NSRunLoop mainRunLoop] forMode:NSRunLoopCommonModes];
+    });
+    
+    return ticker;
+    
+}
+
+#pragma mark - Setup / Teardown
+
+- (instancetype)initWithClock:(AMClockBlock)clock {
+    
+    if ((self = [super init])) {
+        
+        _clock = [clock copy];
+        _clients = [[NSMutableArray alloc] init];
+        _pendingRemovals = [NSHashTable hashTableWithOptions:NSPointerFunctionsStrongMemory | NSPointerFunctionsObjectPointerPersonality];
+        _frameDuration = 1.0 / 60.0;
+        
+    }
+    
+    return self;
+    
+}
+
+#pragma mark - Internals
+
+- (void)displayDidUpdate:(CADisplayLink *)displayLink {
+    
+    /* The duration of the link is the one of the display - not of the preferred frame rate. */
+    self.frameDuration = (self.preferredFramesPerSecond > 0 ? MAX(displayLink.duration, 1.0 / self.preferredFramesPerSecond) : displayLink.duration);
+    
+    [self tickAtTime:displayLink.timestamp];
+    
+}
+
+- (NSInteger)preferredFramesPerSecondOfClient:(id<AMFrameTickerClient>)client {
+    
+    if (![client respondsToSelector:@selector(preferredFramesPerSecondForTicker:)])
+        return 0;
+    
+    return MAX([client preferredFramesPerSecondForTicker:self], 0);
+    
+}
+
+- (void)updatePreferredFramesPerSecond {
+    
+    NSInteger preferredFramesPerSecond = 0;
+    
+    for (id<AMFrameTickerClient> client in self.clients) {
+        
+        if ([self.pendingRemovals count] > 0 && [self.pendingRemovals containsObject:client])
+            continue;
+        
+        NSInteger clientFramesPerSecond = [self preferredFramesPerSecondOfClient:client];
+        
+        /* A single client at the native rate sets the rate for all. */
+        if (clientFramesPerSecond == 0) {
+            preferredFramesPerSecond = 0;
+            break;
+        }
+        
+        preferredFramesPerSecond = MAX(preferredFramesPerSecond, clientFramesPerSecond);
+        
+    }
+    
+    [self setDisplayLinkFramesPerSecond:preferredFramesPerSecond];
+    
+}
+
+- (void)addPreferredFramesPerSecondOfClient:(id<AMFrameTickerClient>)client {
+    
+    /* Adding a client can only raise the rate - so there is no need to visit the other clients. */
+    NSInteger clientFramesPerSecond = [self preferredFramesPerSecondOfClient:client];
+    
+    if (self.numberOfClients == 1)
+        [self setDisplayLinkFramesPerSecond:clientFramesPerSecond];
+    else if (self.preferredFramesPerSecond > 0)
+        [self setDisplayLinkFramesPerSecond:(clientFramesPerSecond == 0 ? 0 : MAX(self.preferredFramesPerSecond, clientFramesPerSecond))];
+    
+}
+
+- (void)setDisplayLinkFramesPerSecond:(NSInteger)preferredFramesPerSecond {
+    
+    if (preferredFramesPerSecond == self.preferredFramesPerSecond)
+        return;
+    
+    self.preferredFramesPerSecond = preferredFramesPerSecond;
+    
+    CADisplayLink *displayLink = self.displayLink;
+    if (!displayLink)
+        return;
+    
+    if ([displayLink respondsToSelector:@selector(setPreferredFramesPerSecond:)])
+        displayLink.preferredFramesPerSecond = preferredFramesPerSecond;
+    else {
+        /* Before iOS 10 the rate is given as an interval of 60 Hz frames. */
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wdeprecated-declarations"
+        displayLink.frameInterval = (preferredFramesPerSecond > 0 ? MAX((NSInteger)round(60.0 / preferredFramesPerSecond), 1) : 1);
+#pragma clang diagnostic pop
+    }
+    
+}
+
+- (void)prepareFrame:(NSUInteger)frame atTime:(CFTimeInterval)time {
+    
+    /* Wait for the previous frame to be prepared - its buffers are about to be read. */
+    dispatch_group_wait(self.workerGroup, DISPATCH_TIME_FOREVER);
+    
+    if (!self.preparingClients) {
+        NSMutableArray *preparingClients = [[NSMutableArray alloc] init];
+        for (id<AMFrameTickerClient> client in self.clients)
+            if ([client respondsToSelector:@selector(ticker:prepareFrame:atTime:)])
+                [preparingClients addObject:client];
+        self.preparingClients = preparingClients;
+    }
+    
+    NSArray *clients = self.preparingClients;
+    
+    if ([clients count] == 0)
+        return;
+    
+    dispatch_group_async(self.workerGroup, self.workerQueue, ^{
+        for (id<AMFrameTickerClient> client in clients)
+            [client ticker:self prepareFrame:frame atTime:time];
+    });
+    
+}
+
+- (void)tickAtTime:(CFTimeInterval)time {
+    
+    AMAssertMainThread();
+    
+    CFTimeInterval interval = (self.frameTime > 0.0 ? time - self.frameTime : 0.0);
+    
+    if (interval > 0.0 && !self.displayLink)
+        self.frameDuration = interval;
+    
+    AM_INSTRUMENT_FRAME_BEGAN(interval, self.frameDuration, self.numberOfClients);
+    AM_INSTRUMENT_BEGIN(AMInstrumentationPhaseFrame);
+    
+    self.frameTime = time;
+    self.frameIndex++;
+    
+    /* The next frame is prepared while this frame is applied. */
+    if (self.isPipelined)
+        [self prepareFrame:self.frameIndex + 1 atTime:time + self.frameDuration];
+    
+    self.ticking = YES;
+    
+    /* Clients added during the pass are appended and will be stepped next frame. */
+    for (NSUInteger idx = 0, count = [self.clients count] ; idx < count ; idx++) {
+        
+        id<AMFrameTickerClient> client = self.clients[idx];
+        
+        if ([self.pendingRemovals count] > 0 && [self.pendingRemovals containsObject:client])
+            continue;
+        
+        [client ticker:self didTickAtTime:time];
+        
+    }
+    
+    self.ticking = NO;
+    
+    if ([self.pendingRemovals count] > 0) {
+        
+        NSUInteger kept = 0;
+        for (NSUInteger idx = 0, count = [self.clients count] ; idx < count ; idx++) {
+            id client = self.clients[idx];
+            if (![self.pendingRemovals containsObject:client])
+                self.clients[kept++] = client;
+        }
+        
+        [self.clients removeObjectsInRange:NSMakeRange(kept, [self.clients count] - kept)];
+        [self.pendingRemovals removeAllObjects];
+        
+        self.preparingClients = nil;
+        
+        [self updatePreferredFramesPerSecond];
+        
+    }
+    
+    self.displayLink.paused = ([self.clients count] == 0);
+    
+    AM_INSTRUMENT_END(AMInstrumentationPhaseFrame);
+    AM_INSTRUMENT_FRAME_ENDED();
+    
+}
+
+#pragma mark - Properties
+
+- (CFTimeInterval)currentTime {
+    
+    return self.clock();
+    
+}
+
+- (NSUInteger)numberOfClients {
+    
+    return [self.clients count] - [self.pendingRemovals count];
+    
+}
+
+- (void)setPipelined:(BOOL)pipelined {
+    
+    AMAssertMainThread();
+    
+    if (pipelined && !self.workerQueue) {
+        self.workerQueue = dispatch_queue_create("com.trenskow.Animeteor.ticker", DISPATCH_QUEUE_SERIAL);
+        dispatch_set_target_queue(self.workerQueue, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_HIGH, 0));
+        self.workerGroup = dispatch_group_create();
+    }
+    
+    /* Let any frame in preparation finish. */
+    if (!pipelined && self.workerGroup)
+        dispatch_group_wait(self.workerGroup, DISPATCH_TIME_FOREVER);
+    
+    _pipelined = pipelined;
+    
+}
+
+- (void)waitForPreparedFrame {
+    
+    AMAssertMainThread();
+    
+    if (self.workerGroup)
+        dispatch_group_wait(self.workerGroup, DISPATCH_TIME_FOREVER);
+    
+}
+
+#pragma mark - Public Methods
+
+- (void)addClient:(id<AMFrameTickerClient>)client {
+    
+    AMAssertMainThread();
+    
+    if ([self.pendingRemovals containsObject:client])
+        [self.pendingRemovals removeObject:client];
+    else if ([self.clients indexOfObjectIdenticalTo:client] == NSNotFound) {
+        [self.clients addObject:client];
+        self.preparingClients = nil;
+        [self addPreferredFramesPerSecondOfClient:client];
+    }
+    
+    self.displayLink.paused = NO;
+    
+}
+
+- (void)removeClient:(id<AMFrameTickerClient>)client {
+    
+    AMAssertMainThread();
+    
+    if (self.isTicking) {
+        if ([self.clients indexOfObjectIdenticalTo:client] != NSNotFound)
+            [self.pendingRemovals addObject:client];
+    } else {
+        [self.clients removeObjectIdenticalTo:client];
+        self.preparingClients = nil;
+        [self updatePreferredFramesPerSecond];
+        self.displayLink.paused = ([self.clients count] == 0);
+    }
+    
+}
+
+- (void)tick {
+    
+    [self tickAtTime:self.currentTime];
+    
+}
+
+@end
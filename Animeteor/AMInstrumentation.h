@@ -0,0 +1,197 @@
+//
+//  AMInstrumentation.h
+//  Animeteor
+//
+//  Copyright (c) 2013-2015, Kristian Trenskow
+//  All rights reserved.
+//  
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are met:
+//  
+//  1. Redistributions of source code must retain the above copyright notice,
+//  this list of conditions and the following disclaimer.
+//  
+//  2. Redistributions in binary form must reproduce the above copyright notice,
+//  this list of conditions and the following disclaimer in the documentation
+//  and/or other materials provided with the distribution.
+//  
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+//  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+//  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+//  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+//  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+//  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+//  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+//  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+//  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+//  POSSIBILITY OF SUCH DAMAGE.
+//
+
+@import Foundation;
+
+/*!
+ Instrumentation is compiled in when `AM_INSTRUMENTATION` is defined to a non-zero value - as an example using `GCC_PREPROCESSOR_DEFINITIONS`. When disabled all instrumentation hooks compile to nothing, and snapshots are all zeros.
+ */
+#ifndef AM_INSTRUMENTATION
+#define AM_INSTRUMENTATION 0
+#endif
+
+/*!
+ The phases of work timed by the instrumentation.
+ */
+typedef NS_ENUM(NSUInteger, AMInstrumentationPhase) {
+    /*! Evaluating curves. */
+    AMInstrumentationPhaseCurve = 0,
+    /*! Interpolating values. */
+    AMInstrumentationPhaseInterpolation,
+    /*! Writing values to objects. */
+    AMInstrumentationPhaseWrite,
+    /*! Generating keyframes for layer animations. */
+    AMInstrumentationPhaseKeyframes,
+    /*! Stepping all clients of a ticker. */
+    AMInstrumentationPhaseFrame,
+    AMInstrumentationPhaseCount
+};
+
+/*!
+ The kinds of animation objects counted by the instrumentation.
+ */
+typedef NS_ENUM(NSUInteger, AMInstrumentationObject) {
+    AMInstrumentationObjectDirectAnimation = 0,
+    AMInstrumentationObjectLayerAnimation,
+    AMInstrumentationObjectAnimationGroup,
+    AMInstrumentationObjectCount
+};
+
+/*!
+ A snapshot of the instrumentation. Frame values are of the most recently completed frame.
+ */
+typedef struct {
+    /*! The number of frames stepped. */
+    NSUInteger frames;
+    /*! The number of ticker clients active in the frame. */
+    NSUInteger activeAnimations;
+    /*! The time spent in each phase during the frame - indexed by `AMInstrumentationPhase`. */
+    NSTimeInterval phaseDurations[AMInstrumentationPhaseCount];
+    /*! The number of keyframes generated during the frame. */
+    NSUInteger keyframesGenerated;
+    /*! The number of frames that took longer than the frame duration to step. */
+    NSUInteger lateFrames;
+    /*! The number of display refreshes skipped between frames. */
+    NSUInteger droppedFrames;
+    /*! The number of animation objects alive - indexed by `AMInstrumentationObject`. */
+    NSUInteger liveObjects[AMInstrumentationObjectCount];
+    /*! The number of animation objects ever created - indexed by `AMInstrumentationObject`. */
+    NSUInteger createdObjects[AMInstrumentationObjectCount];
+} AMInstrumentationSnapshot;
+
+/*!
+ The `AMInstrumentationSink` protocol is implemented by objects that receive instrumentation events - like a bridge to signposts. Phase events may be sent from the worker queue of a pipelined ticker, so implementations must be thread safe.
+ */
+@protocol AMInstrumentationSink <NSObject>
+
+@optional
+/*!
+ Tells the sink that a phase has begun.
+ 
+ @param phase The phase that began.
+ */
+- (void)instrumentationDidBeginPhase:(AMInstrumentationPhase)phase;
+
+/*!
+ Tells the sink that a phase has ended.
+ 
+ @param phase    The phase that ended.
+ @param duration The duration of the phase in seconds.
+ */
+- (void)instrumentationDidEndPhase:(AMInstrumentationPhase)phase duration:(NSTimeInterval)duration;
+
+/*!
+ Tells the sink that a frame has completed.
+ 
+ @param snapshot A snapshot taken at the end of the frame.
+ */
+- (void)instrumentationDidFinishFrame:(AMInstrumentationSnapshot)snapshot;
+
+@end
+
+/*!
+ The `AMInstrumentation` class exposes counters and timings of the animation engine.
+ */
+@interface AMInstrumentation : NSObject
+
+/// ----------------------------------
+/// @name Getting Instrumentation Data
+/// ----------------------------------
+
+/*!
+ Returns `YES` if instrumentation was compiled in.
+ */
++ (BOOL)isEnabled;
+
+/*!
+ Returns a snapshot of the instrumentation.
+ 
+ @return The snapshot.
+ */
++ (AMInstrumentationSnapshot)snapshot;
+
+/*!
+ Resets all counters except the live object counts.
+ */
++ (void)reset;
+
+/// -----------------------
+/// @name Configuring Sinks
+/// -----------------------
+
+/*!
+ Sets the sink that receives instrumentation events.
+ 
+ @param sink The sink - or `nil` to remove the current sink.
+ 
+ @discussion The sink can be replaced while pipelined tickers report phases from their worker queue. A replaced sink may still receive an event that was being sent when it was replaced.
+ */
++ (void)setSink:(id<AMInstrumentationSink> _Nullable)sink;
+
+/*!
+ Returns the sink that receives instrumentation events.
+ */
++ (id<AMInstrumentationSink> _Nullable)sink;
+
+@end
+
+/*
+ Hooks used by the animation engine. They are not meant to be called by clients.
+ */
+
+#if AM_INSTRUMENTATION
+
+FOUNDATION_EXPORT uint64_t AMInstrumentationBeginPhase(AMInstrumentationPhase phase);
+FOUNDATION_EXPORT void AMInstrumentationEndPhase(AMInstrumentationPhase phase, uint64_t start);
+FOUNDATION_EXPORT void AMInstrumentationCountKeyframes(NSUInteger count);
+FOUNDATION_EXPORT void AMInstrumentationObjectCreated(AMInstrumentationObject object);
+FOUNDATION_EXPORT void AMInstrumentationObjectDestroyed(AMInstrumentationObject object);
+FOUNDATION_EXPORT void AMInstrumentationFrameBegan(CFTimeInterval interval, CFTimeInterval frameDuration, NSUInteger activeAnimations);
+FOUNDATION_EXPORT void AMInstrumentationFrameEnded(void);
+
+#define AM_INSTRUMENT_BEGIN(phase) uint64_t __am_instrument_##phase = AMInstrumentationBeginPhase(phase)
+#define AM_INSTRUMENT_END(phase) AMInstrumentationEndPhase(phase, __am_instrument_##phase)
+#define AM_INSTRUMENT_KEYFRAMES(count) AMInstrumentationCountKeyframes(count)
+#define AM_INSTRUMENT_CREATED(object) AMInstrumentationObjectCreated(object)
+#define AM_INSTRUMENT_DESTROYED(object) AMInstrumentationObjectDestroyed(object)
+#define AM_INSTRUMENT_FRAME_BEGAN(interval, frameDuration, activeAnimations) AMInstrumentationFrameBegan(interval, frameDuration, activeAnimations)
+#define AM_INSTRUMENT_FRAME_ENDED() AMInstrumentationFrameEnded()
+
+#else
+
+#define AM_INSTRUMENT_BEGIN(phase) do {} while (0)
+#define AM_INSTRUMENT_END(phase) do {} while (0)
+#define AM_INSTRUMENT_KEYFRAMES(count) do {} while (0)
+#define AM_INSTRUMENT_CREATED(object) do {} while (0)
+#define AM_INSTRUMENT_DESTROYED(object) do {} while (0)
+#define AM_INSTRUMENT_FRAME_BEGAN(interval, frameDuration, activeAnimations) do {} while (0)
+#define AM_INSTRUMENT_FRAME_ENDED() do {} while (0)
+
+#endif
@@ -0,0 +1,246 @@
+//
+//  AMInstrumentation.m
+//  Animeteor
+//
+//  Copyright (c) 2013-2015, Kristian Trenskow
+//  All rights reserved.
+//  
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are met:
+//  
+//  1. Redistributions of source code must retain the above copyright notice,
+//  this list of conditions and the following disclaimer.
+//  
+//  2. Redistributions in binary form must reproduce the above copyright notice,
+//  this list of conditions and the following disclaimer in the documentation
+//  and/or other materials provided with the distribution.
+//  
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+//  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+//  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+//  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+//  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+//  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+//  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+//  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+//  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+//  POSSIBILITY OF SUCH DAMAGE.
+//
+
+#import <mach/mach_time.h>
+#import <pthread.h>
+
+#import "AMInstrumentation.h"
+
+#if AM_INSTRUMENTATION
+
+/* Counters are updated from the main thread and from the worker queue of pipelined tickers, so all updates are atomic. */
+static volatile uint64_t AMInstrumentationFrames;
+static volatile uint64_t AMInstrumentationLateFrames;
+static volatile uint64_t AMInstrumentationDroppedFrames;
+static volatile uint64_t AMInstrumentationPhaseTicks[AMInstrumentationPhaseCount];
+static volatile uint64_t AMInstrumentationKeyframes;
+static volatile int64_t AMInstrumentationLiveObjects[AMInstrumentationObjectCount];
+static volatile uint64_t AMInstrumentationCreatedObjects[AMInstrumentationObjectCount];
+
+/* Values of the frame in progress - reset when a frame begins. */
+static NSUInteger AMInstrumentationFrameActiveAnimations;
+static CFTimeInterval AMInstrumentationFrameDuration;
+static uint64_t AMInstrumentationFramePhaseTicks[AMInstrumentationPhaseCount];
+static uint64_t AMInstrumentationFrameKeyframes;
+
+/* Values of the last completed frame. */
+static AMInstrumentationSnapshot AMInstrumentationLastFrame;
+
+/* The sink is replaced on the main thread while phases are reported from the worker queue - so it is read and written under a lock. The flags are read without the lock as a hint only. */
+static pthread_mutex_t AMInstrumentationSinkLock = PTHREAD_MUTEX_INITIALIZER;
+static id<AMInstrumentationSink> AMInstrumentationCurrentSink;
+static volatile BOOL AMInstrumentationSinkBegins;
+static volatile BOOL AMInstrumentationSinkEnds;
+static volatile BOOL AMInstrumentationSinkFrames;
+
+/* Returns the current sink retained - if it still responds to the event of `flag`. */
+static id<AMInstrumentationSink> AMInstrumentationSinkForEvent(volatile BOOL *flag) {
+    
+    pthread_mutex_lock(&AMInstrumentationSinkLock);
+    id<AMInstrumentationSink> sink = (*flag ? AMInstrumentationCurrentSink : nil);
+    pthread_mutex_unlock(&AMInstrumentationSinkLock);
+    
+    return sink;
+    
+}
+
+static double AMInstrumentationSecondsPerTick(void) {
+    
+    static double secondsPerTick;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        mach_timebase_info_data_t info;
+        mach_timebase_info(&info);
+        secondsPerTick = (double)info.numer / (double)info.denom / 1e9;
+    });
+    
+    return secondsPerTick;
+    
+}
+
+uint64_t AMInstrumentationBeginPhase(AMInstrumentationPhase phase) {
+    
+    if (AMInstrumentationSinkBegins)
+        [AMInstrumentationSinkForEvent(&AMInstrumentationSinkBegins) instrumentationDidBeginPhase:phase];
+    
+    return mach_absolute_time();
+    
+}
+
+void AMInstrumentationEndPhase(AMInstrumentationPhase phase, uint64_t start) {
+    
+    uint64_t ticks = mach_absolute_time() - start;
+    
+    __sync_fetch_and_add(&AMInstrumentationPhaseTicks[phase], ticks);
+    
+    if (AMInstrumentationSinkEnds)
+        [AMInstrumentationSinkForEvent(&AMInstrumentationSinkEnds) instrumentationDidEndPhase:phase duration:ticks * AMInstrumentationSecondsPerTick()];
+    
+}
+
+void AMInstrumentationCountKeyframes(NSUInteger count) {
+    
+    __sync_fetch_and_add(&AMInstrumentationKeyframes, count);
+    
+}
+
+void AMInstrumentationObjectCreated(AMInstrumentationObject object) {
+    
+    __sync_fetch_and_add(&AMInstrumentationLiveObjects[object], 1);
+    __sync_fetch_and_add(&AMInstrumentationCreatedObjects[object], 1);
+    
+}
+
+void AMInstrumentationObjectDestroyed(AMInstrumentationObject object) {
+    
+    __sync_fetch_and_sub(&AMInstrumentationLiveObjects[object], 1);
+    
+}
+
+void AMInstrumentationFrameBegan(CFTimeInterval interval, CFTimeInterval frameDuration, NSUInteger activeAnimations) {
+    
+    /* An interval spanning more than one refresh means refreshes were skipped. */
+    if (frameDuration > 0.0 && interval > frameDuration * 1.5)
+        __sync_fetch_and_add(&AMInstrumentationDroppedFrames, (uint64_t)round(interval / frameDuration) - 1);
+    
+    AMInstrumentationFrameActiveAnimations = activeAnimations;
+    AMInstrumentationFrameDuration = frameDuration;
+    AMInstrumentationFrameKeyframes = AMInstrumentationKeyframes;
+    for (NSUInteger phase = 0 ; phase < AMInstrumentationPhaseCount ; phase++)
+        AMInstrumentationFramePhaseTicks[phase] = AMInstrumentationPhaseTicks[phase];
+    
+}
+
+void AMInstrumentationFrameEnded(void) {
+    
+    double secondsPerTick = AMInstrumentationSecondsPerTick();
+    
+    AMInstrumentationSnapshot frame = {0};
+    
+    frame.activeAnimations = AMInstrumentationFrameActiveAnimations;
+    frame.keyframesGenerated = (NSUInteger)(AMInstrumentationKeyframes - AMInstrumentationFrameKeyframes);
+    for (NSUInteger phase = 0 ; phase < AMInstrumentationPhaseCount ; phase++)
+        frame.phaseDurations[phase] = (AMInstrumentationPhaseTicks[phase] - AMInstrumentationFramePhaseTicks[phase]) * secondsPerTick;
+    
+    if (AMInstrumentationFrameDuration > 0.0 && frame.phaseDurations[AMInstrumentationPhaseFrame] > AMInstrumentationFrameDuration)
+        __sync_fetch_and_add(&AMInstrumentationLateFrames, 1);
+    
+    __sync_fetch_and_add(&AMInstrumentationFrames, 1);
+    
+    AMInstrumentationLastFrame = frame;
+    
+    if (AMInstrumentationSinkFrames)
+        [AMInstrumentationSinkForEvent(&AMInstrumentationSinkFrames) instrumentationDidFinishFrame:[AMInstrumentation snapshot]];
+    
+}
+
+#endif
+
+@implementation AMInstrumentation
+
+#pragma mark - Getting Instrumentation Data
+
++ (BOOL)isEnabled {
+    
+    return AM_INSTRUMENTATION;
+    
+}
+
++ (AMInstrumentationSnapshot)snapshot {
+    
+    AMInstrumentationSnapshot snapshot = {0};
+    
+#if AM_INSTRUMENTATION
+    snapshot = AMInstrumentationLastFrame;
+    snapshot.frames = (NSUInteger)AMInstrumentationFrames;
+    snapshot.lateFrames = (NSUInteger)AMInstrumentationLateFrames;
+    snapshot.droppedFrames = (NSUInteger)AMInstrumentationDroppedFrames;
+    for (NSUInteger object = 0 ; object < AMInstrumentationObjectCount ; object++) {
+        snapshot.liveObjects[object] = (NSUInteger)MAX(AMInstrumentationLiveObjects[object], 0);
+        snapshot.createdObjects[object] = (NSUInteger)AMInstrumentationCreatedObjects[object];
+    }
+#endif
+    
+    return snapshot;
+    
+}
+
++ (void)reset {
+    
+#if AM_INSTRUMENTATION
+    AMInstrumentationFrames = 0;
+    AMInstrumentationLateFrames = 0;
+    AMInstrumentationDroppedFrames = 0;
+    AMInstrumentationLastFrame = (AMInstrumentationSnapshot){0};
+    for (NSUInteger object = 0 ; object < AMInstrumentationObjectCount ; object++)
+        AMInstrumentationCreatedObjects[object] = (uint64_t)MAX(AMInstrumentationLiveObjects[object], 0);
+#endif
+    
+}
+
+#pragma mark - Configuring Sinks
+
++ (void)setSink:(id<AMInstrumentationSink>)sink {
+    
+#if AM_INSTRUMENTATION
+    BOOL begins = [sink respondsToSelector:@selector(instrumentationDidBeginPhase:)];
+    BOOL ends = [sink respondsToSelector:@selector(instrumentationDidEndPhase:duration:)];
+    BOOL frames = [sink respondsToSelector:@selector(instrumentationDidFinishFrame:)];
+    
+    /* The previous sink is released outside the lock. Events already read keep it alive until they are sent. */
+    id<AMInstrumentationSink> previous;
+    
+    pthread_mutex_lock(&AMInstrumentationSinkLock);
+    previous = AMInstrumentationCurrentSink;
+    AMInstrumentationCurrentSink = sink;
+    AMInstrumentationSinkBegins = begins;
+    AMInstrumentationSinkEnds = ends;
+    AMInstrumentationSinkFrames = frames;
+    pthread_mutex_unlock(&AMInstrumentationSinkLock);
+    
+    previous = nil;
+#endif
+    
+}
+
++ (id<AMInstrumentationSink>)sink {
+    
+#if AM_INSTRUMENTATION
+    pthread_mutex_lock(&AMInstrumentationSinkLock);
+    id<AMInstrumentationSink> sink = AMInstrumentationCurrentSink;
+    pthread_mutex_unlock(&AMInstrumentationSinkLock);
+    return sink;
+#else
+    return nil;
+#endif
+    
+}
+
+@end
@@ -29,7 +29,9 @@
 //
 
 /*!
- The `AMInterpolatable` is implemented by classes that are able to interpolate their value with other values. Currently Animeteor implements this on `NSNumber` and `NSValue`.
+ The `AMInterpolatable` is implemented by classes that are able to interpolate their value with other values. Currently Animeteor implements this on `NSNumber`, `NSValue` and `UIColor`.
+ 
+ `CGColorRef` values cannot adopt the protocol - but are accepted as values too, as `AMInterpolator` interpolates them unboxed.
  */
 @protocol AMInterpolatable <NSCopying>
 
@@ -46,3 +48,14 @@
                                   atPosition:(double)position;
 
 @end
+
+/*!
+ Returns a copy of a value to animate.
+ 
+ @param value The value to copy.
+ 
+ @return A copy of the value - or the value itself if it is immutable without adopting `NSCopying` (like a `CGColorRef`).
+ */
+static inline id _Nullable AMInterpolatableCopy(id _Nullable value) {
+    return ([value respondsToSelector:@selector(copyWithZone:)] ? [value copyWithZone:nil] : value);
+}
@@ -0,0 +1,252 @@
+//
+//  AMInterpolator.h
+//  Animeteor
+//
+//  Copyright (c) 2013-2015, Kristian Trenskow
+//  All rights reserved.
+//  
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are met:
+//  
+//  1. Redistributions of source code must retain the above copyright notice,
+//  this list of conditions and the following disclaimer.
+//  
+//  2. Redistributions in binary form must reproduce the above copyright notice,
+//  this list of conditions and the following disclaimer in the documentation
+//  and/or other materials provided with the distribution.
+//  
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+//  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+//  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+//  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+//  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+//  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+//  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+//  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+//  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+//  POSSIBILITY OF SUCH DAMAGE.
+//
+
+@import Foundation;
+
+#import "AMInterpolatable.h"
+#import "AMColorKernels.h"
+
+@class AMMotionPath;
+
+/*!
+ The types of values an interpolator can interpolate unboxed.
+ */
+typedef NS_ENUM(NSUInteger, AMInterpolatorType) {
+    /*! Values are interpolated by the endpoints' `interpolateWithValue:atPosition:`. */
+    AMInterpolatorTypeGeneric = 0,
+    /*! `NSNumber` values of any numeric type. Unboxed as `double`. */
+    AMInterpolatorTypeNumber,
+    /*! `NSValue` values of type `CGPoint`. */
+    AMInterpolatorTypePoint,
+    /*! `NSValue` values of type `CGSize`. */
+    AMInterpolatorTypeSize,
+    /*! `NSValue` values of type `CGRect`. */
+    AMInterpolatorTypeRect,
+    /*! `NSValue` values of type `CGVector`. */
+    AMInterpolatorTypeVector,
+    /*! `NSValue` values of type `CATransform3D`. Decomposed once into translation, scale, skew, perspective and rotation. */
+    AMInterpolatorTypeTransform3D,
+    /*! `UIColor` or `CGColorRef` values. Unboxed as four `CGFloat` - red, green, blue and alpha in (extended) sRGB. The endpoints are converted once into the color space of the interpolator. */
+    AMInterpolatorTypeColor,
+    /*! `AMNumericBuffer` values of the same type and count. Unboxed as the elements - `objCType` is the type of an element, and `valueSize` the size of all elements. */
+    AMInterpolatorTypeBuffer
+};
+
+/*!
+ The `AMInterpolator` class interpolates between two values with the type resolved once. The endpoints are unboxed when the interpolator is created, so interpolating involves no type checks, string comparisons or allocations - unless a boxed value is asked for. Buffers are interpolated in SIMD lanes into storage given by the caller.
+ 
+ Values of types not known to the interpolator are interpolated using the [AMInterpolatable](AMInterpolatable) protocol.
+ */
+@interface AMInterpolator : NSObject
+
+/// ----------------------------
+/// @name Creating Interpolators
+/// ----------------------------
+
++ (instancetype _Nullable)new UNAVAILABLE_ATTRIBUTE;
+- (instancetype _Nullable)init UNAVAILABLE_ATTRIBUTE;
+
+/*!
+ Returns an initialized interpolator.
+ 
+ @param fromValue The value at position zero.
+ @param toValue   The value at position one. Must be of the same type as `fromValue`.
+ 
+ @return An initialized interpolator.
+ */
+- (instancetype _Nonnull)initWithFromValue:(id<AMInterpolatable> _Nonnull)fromValue
+                                   toValue:(id<AMInterpolatable> _Nonnull)toValue;
+
+/*!
+ Returns an initialized interpolator that interpolates colors in a specific color space.
+ 
+ @param fromValue  The value at position zero.
+ @param toValue    The value at position one. Must be of the same type as `fromValue`.
+ @param colorSpace The color space in which colors are interpolated. Ignored for values that are not colors.
+ 
+ @return An initialized interpolator.
+ */
+- (instancetype _Nonnull)initWithFromValue:(id<AMInterpolatable> _Nonnull)fromValue
+                                   toValue:(id<AMInterpolatable> _Nonnull)toValue
+                                colorSpace:(AMColorSpace)colorSpace;
+
+/*!
+ Returns an initialized interpolator that moves a point along a motion path at constant speed.
+ 
+ @param motionPath The motion path - where position zero is its start and position one its end.
+ 
+ @discussion The interpolator is of the point type - with the start and end of the path as its values.
+ 
+ @return An initialized interpolator.
+ */
+- (instancetype _Nonnull)initWithMotionPath:(AMMotionPath * _Nonnull)motionPath;
+
+/*!
+ Returns an initialized interpolator of the tangent angles along a motion path - in radians.
+ 
+ @param motionPath The motion path - where position zero is its start and position one its end.
+ 
+ @discussion The interpolator is of the number type - use it to rotate what moves along the path.
+ 
+ @return An initialized interpolator.
+ */
+- (instancetype _Nonnull)initWithAnglesOfMotionPath:(AMMotionPath * _Nonnull)motionPath;
+
+/// --------------------------------------
+/// @name Getting Interpolator Information
+/// --------------------------------------
+
+/*!
+ Returns the value at position zero.
+ */
+@property (nonatomic,readonly,nonnull) id<AMInterpolatable> fromValue;
+
+/*!
+ Returns the value at position one.
+ */
+@property (nonatomic,readonly,nonnull) id<AMInterpolatable> toValue;
+
+/*!
+ Returns the resolved type of the values.
+ */
+@property (nonatomic,readonly) AMInterpolatorType type;
+
+/*!
+ Returns the color space in which colors are interpolated. Default is `AMColorSpaceSRGB`.
+ */
+@property (nonatomic,readonly) AMColorSpace colorSpace;
+
+/*!
+ Returns the motion path of the interpolator, or `nil` if it interpolates between two values.
+ */
+@property (nonatomic,readonly,nullable) AMMotionPath *motionPath;
+
+/*!
+ Returns the Objective-C type encoding of unboxed values, or `NULL` for generic interpolators. For buffers this is the type of an element.
+ */
+@property (nonatomic,readonly,nullable) const char *objCType;
+
+/*!
+ Returns the size in bytes of unboxed values, or zero for generic interpolators.
+ */
+@property (nonatomic,readonly) size_t valueSize;
+
+/// -------------------
+/// @name Interpolating
+/// -------------------
+
+/*!
+ Writes the unboxed value at a position.
+ 
+ @param position The position between zero and one.
+ @param value    Storage of at least `valueSize` bytes that receives the value.
+ 
+ @return `YES` if a value was written - `NO` for generic interpolators.
+ */
+- (BOOL)interpolateAtPosition:(double)position into:(void * _Nonnull)value;
+
+/*!
+ Returns the boxed value at a position.
+ 
+ @param position The position between zero and one.
+ 
+ @return The interpolated value.
+ */
+- (id<AMInterpolatable> _Nonnull)valueAtPosition:(double)position;
+
+/*!
+ Returns boxed values at a number of positions.
+ 
+ @param positions The positions between zero and one.
+ @param count     The number of positions.
+ 
+ @return An array with the interpolated values.
+ */
+- (NSArray * _Nonnull)valuesAtPositions:(const double * _Nonnull)positions count:(NSUInteger)count;
+
+/*!
+ Boxes an unboxed value.
+ 
+ @param value A value of `valueSize` bytes - like one written by `interpolateAtPosition:into:`.
+ 
+ @return The boxed value - or `nil` for generic interpolators. Colors are boxed as a `UIColor` or a `CGColorRef` - whichever `fromValue` is. Buffers are boxed as a new `AMNumericBuffer` with a copy of the elements.
+ */
+- (id<AMInterpolatable> _Nullable)boxValue:(const void * _Nonnull)value;
+
+/// --------------
+/// @name Velocity
+/// --------------
+
+/*!
+ Makes the values start out at a specific velocity instead of the velocity given by the curve.
+ 
+ @param velocity The velocity at progress zero - in units of the value per second. Must be of the same type as the values.
+ @param slope    The slope of the curve at progress zero.
+ @param duration The duration of the animation.
+ 
+ @discussion The difference in velocity is carried by a term that vanishes at both ends of the animation - along with its own velocity at the end - so the values still start at `fromValue` and settle at `toValue` as the curve does. The term is only applied when interpolating with a progress.
+ 
+ @return `YES` if the velocity was applied - `NO` for generic, transform, color, buffer and motion path interpolators, or if the velocity is of another type.
+ */
+- (BOOL)setInitialVelocity:(id<AMInterpolatable> _Nonnull)velocity slope:(double)slope duration:(NSTimeInterval)duration;
+
+/*!
+ Writes the unboxed value at a position - including the initial velocity.
+ 
+ @param position The position between zero and one.
+ @param progress The progress in time between zero and one.
+ @param value    Storage of at least `valueSize` bytes that receives the value.
+ 
+ @return `YES` if a value was written - `NO` for generic interpolators.
+ */
+- (BOOL)interpolateAtPosition:(double)position progress:(double)progress into:(void * _Nonnull)value;
+
+/*!
+ Returns the boxed value at a position - including the initial velocity.
+ 
+ @param position The position between zero and one.
+ @param progress The progress in time between zero and one.
+ 
+ @return The interpolated value.
+ */
+- (id<AMInterpolatable> _Nonnull)valueAtPosition:(double)position progress:(double)progress;
+
+/*!
+ Returns the boxed velocity at a progress.
+ 
+ @param progress The progress in time between zero and one.
+ @param slope    The slope of the curve at `progress`.
+ @param duration The duration of the animation.
+ 
+ @return The velocity in units of the value per second - or `nil` for generic, transform, color, buffer and motion path interpolators.
+ */
+- (id<AMInterpolatable> _Nullable)velocityAtProgress:(double)progress slope:(double)slope duration:(NSTimeInterval)duration;
+
+@end
@@ -0,0 +1,505 @@
+//
+//  AMInterpolator.m
+//  Animeteor
+//
+//  Copyright (c) 2013-2015, Kristian Trenskow
+//  All rights reserved.
+//  
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are met:
+//  
+//  1. Redistributions of source code must retain the above copyright notice,
+//  this list of conditions and the following disclaimer.
+//  
+//  2. Redistributions in binary form must reproduce the above copyright notice,
+//  this list of conditions and the following disclaimer in the documentation
+//  and/or other materials provided with the distribution.
+//  
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+//  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+//  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+//  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+//  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+//  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+//  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+//  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+//  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+//  POSSIBILITY OF SUCH DAMAGE.
+//
+
+@import UIKit;
+
+#import "AMTransformKernels.h"
+#import "AMBufferKernels.h"
+#import "AMValueKernels.h"
+#import "AMMotionPath.h"
+#import "AMNumericBuffer.h"
+
+#import "AMInterpolator.h"
+
+@interface AMInterpolator () {
+    /* Endpoints are kept unboxed as components - the value at a position is `from + delta * position`. */
+    double _fromNumber;
+    double _deltaNumber;
+    double _from[4];
+    double _delta[4];
+    NSUInteger _components;
+    AMTransformInterpolation _transform;
+    /* Colors are kept in the color space of the interpolator - and boxed as the class of `fromValue`. */
+    double _fromColor[4];
+    double _deltaColor[4];
+    BOOL _boxesCGColor;
+    /* Buffers are kept as copies of their elements - so changes to the endpoints do not affect the interpolation. */
+    AMNumericBuffer *_fromBuffer;
+    AMNumericBuffer *_deltaBuffer;
+    /* Motion paths are looked up directly - for points or the angles of their tangents. */
+    BOOL _motionPathAngles;
+    /* The initial velocity is carried by `carry * p(1 - p)^2` - which is zero at both ends, and has a slope of one at the start and zero at the end. */
+    double _carryNumber;
+    double _carry[4];
+    BOOL _carries;
+}
+
+@end
+
+static BOOL AMInterpolatorGetColor(id value, double *rgba) {
+    
+    UIColor *color;
+    
+    if (!value)
+        return NO;
+    
+    if ([value isKindOfClass:[UIColor class]])
+        color = value;
+    else if (CFGetTypeID((__bridge CFTypeRef)value) == CGColorGetTypeID())
+        color = [UIColor colorWithCGColor:(__bridge CGColorRef)value];
+    else
+        return NO;
+    
+    CGFloat red, green, blue, alpha;
+    
+    if (![color getRed:&red green:&green blue:&blue alpha:&alpha]) {
+        /* Grayscale colors are not converted to RGB on older systems. */
+        if (![color getWhite:&red alpha:&alpha])
+            return NO;
+        green = blue = red;
+    }
+    
+    rgba[0] = red;
+    rgba[1] = green;
+    rgba[2] = blue;
+    rgba[3] = alpha;
+    
+    return YES;
+    
+}
+
+@implementation AMInterpolator
+
+#pragma mark - Setup / Teardown
+
+- (instancetype)initWithFromValue:(id<AMInterpolatable>)fromValue toValue:(id<AMInterpolatable>)toValue {
+    
+    return [self initWithFromValue:fromValue toValue:toValue colorSpace:AMColorSpaceSRGB];
+    
+}
+
+- (instancetype)initWithFromValue:(id<AMInterpolatable>)fromValue toValue:(id<AMInterpolatable>)toValue colorSpace:(AMColorSpace)colorSpace {
+    
+    if ((self = [super init])) {
+        
+        _fromValue = fromValue;
+        _toValue = toValue;
+        _colorSpace = colorSpace;
+        
+        [self resolveType];
+        
+    }
+    
+    return self;
+    
+}
+
+- (instancetype)initWithMotionPath:(AMMotionPath *)motionPath {
+    
+    if ((self = [super init])) {
+        
+        _motionPath = motionPath;
+        _fromValue = [NSValue valueWithCGPoint:motionPath.startPoint];
+        _toValue = [NSValue valueWithCGPoint:motionPath.endPoint];
+        
+        [self resolveType];
+        
+    }
+    
+    return self;
+    
+}
+
+- (instancetype)initWithAnglesOfMotionPath:(AMMotionPath *)motionPath {
+    
+    if ((self = [super init])) {
+        
+        _motionPath = motionPath;
+        _motionPathAngles = YES;
+        _fromValue = @([motionPath angleAtPosition:0.0]);
+        _toValue = @([motionPath angleAtPosition:1.0]);
+        
+        [self resolveType];
+        
+    }
+    
+    return self;
+    
+}
+
+#pragma mark - Internals
+
+- (void)resolveType {
+    
+    id from = self.fromValue;
+    id to = self.toValue;
+    
+    /* Missing endpoints (like the default background color of a layer) are left to the generic path. */
+    if (!from || !to)
+        return;
+    
+    if ([from isKindOfClass:[AMNumericBuffer class]] && [to isKindOfClass:[AMNumericBuffer class]]) {
+        [self resolveBufferFromValue:from toValue:to];
+        return;
+    }
+    
+    /* Numbers of any type - like @0 and @1 - are interpolated as doubles. */
+    if ([from isKindOfClass:[NSNumber class]] && [to isKindOfClass:[NSNumber class]]) {
+        
+        _type = AMInterpolatorTypeNumber;
+        _objCType = @encode(double);
+        _valueSize = sizeof(double);
+        _fromNumber = [from doubleValue];
+        _deltaNumber = [to doubleValue] - _fromNumber;
+        
+        return;
+        
+    }
+    
+    if ([self resolveColorFromValue:from toValue:to])
+        return;
+    
+    if (![from isKindOfClass:[NSValue class]] || ![to isKindOfClass:[NSValue class]] || 0 != strcmp([from objCType], [to objCType]))
+        return;
+    
+    const char *type = [from objCType];
+    
+    if (0 == strcmp(type, @encode(CGPoint))) {
+        _type = AMInterpolatorTypePoint;
+        _objCType = @encode(CGPoint);
+        _valueSize = sizeof(CGPoint);
+    } else if (0 == strcmp(type, @encode(CGSize))) {
+        _type = AMInterpolatorTypeSize;
+        _objCType = @encode(CGSize);
+        _valueSize = sizeof(CGSize);
+    } else if (0 == strcmp(type, @encode(CGRect))) {
+        _type = AMInterpolatorTypeRect;
+        _objCType = @encode(CGRect);
+        _valueSize = sizeof(CGRect);
+    } else if (0 == strcmp(type, @encode(CGVector))) {
+        _type = AMInterpolatorTypeVector;
+        _objCType = @encode(CGVector);
+        _valueSize = sizeof(CGVector);
+    } else if (0 == strcmp(type, @encode(CATransform3D))) {
+        _type = AMInterpolatorTypeTransform3D;
+        _objCType = @encode(CATransform3D);
+        _valueSize = sizeof(CATransform3D);
+        [self resolveTransformFromValue:from toValue:to];
+        return;
+    } else
+        return;
+    
+    /* All supported structs are plain arrays of CGFloats. */
+    _components = _valueSize / sizeof(CGFloat);
+    
+    CGFloat fromComponents[4];
+    CGFloat toComponents[4];
+    [from getValue:fromComponents];
+    [to getValue:toComponents];
+    
+    for (NSUInteger idx = 0 ; idx < _components ; idx++) {
+        _from[idx] = fromComponents[idx];
+        _delta[idx] = toComponents[idx] - fromComponents[idx];
+    }
+    
+}
+
+- (BOOL)resolveColorFromValue:(id)fromValue toValue:(id)toValue {
+    
+    double from[4];
+    double to[4];
+    
+    if (!AMInterpolatorGetColor(fromValue, from) || !AMInterpolatorGetColor(toValue, to))
+        return NO;
+    
+    _type = AMInterpolatorTypeColor;
+    _objCType = @encode(CGFloat[4]);
+    _valueSize = sizeof(CGFloat) * 4;
+    _boxesCGColor = ![fromValue isKindOfClass:[UIColor class]];
+    
+    /* The endpoints are converted once - so a position is a lerp and a conversion back into sRGB. */
+    double toColor[4];
+    AMColorFromSRGB(_colorSpace, from, _fromColor);
+    AMColorFromSRGB(_colorSpace, to, toColor);
+    
+    for (NSUInteger idx = 0 ; idx < 4 ; idx++)
+        _deltaColor[idx] = toColor[idx] - _fromColor[idx];
+    
+    return YES;
+    
+}
+
+- (void)resolveBufferFromValue:(AMNumericBuffer *)fromValue toValue:(AMNumericBuffer *)toValue {
+    
+    if (![fromValue isCompatibleWithBuffer:toValue])
+        return;
+    
+    _type = AMInterpolatorTypeBuffer;
+    _objCType = (fromValue.type == AMNumericBufferTypeDouble ? @encode(double) : @encode(float));
+    _valueSize = fromValue.elementSize * fromValue.count;
+    _fromBuffer = [fromValue copy];
+    _deltaBuffer = [[AMNumericBuffer alloc] initWithType:fromValue.type count:fromValue.count];
+    
+    if (fromValue.type == AMNumericBufferTypeDouble)
+        AMBufferSubtractDoubles(fromValue.bytes, toValue.bytes, _deltaBuffer.mutableBytes, fromValue.count);
+    else
+        AMBufferSubtractFloats(fromValue.bytes, toValue.bytes, _deltaBuffer.mutableBytes, fromValue.count);
+    
+}
+
+- (void)resolveTransformFromValue:(NSValue *)fromValue toValue:(NSValue *)toValue {
+    
+    CATransform3D from = [fromValue CATransform3DValue];
+    CATransform3D to = [toValue CATransform3DValue];
+    
+    /* `CATransform3D` and `AMTransformMatrix` share layout - but `CGFloat` might be a float. */
+    AMTransformMatrix fromMatrix;
+    AMTransformMatrix toMatrix;
+    for (NSUInteger idx = 0 ; idx < 16 ; idx++) {
+        ((double *)fromMatrix.m)[idx] = ((CGFloat *)&from)[idx];
+        ((double *)toMatrix.m)[idx] = ((CGFloat *)&to)[idx];
+    }
+    
+    AMTransformInterpolationMake(&fromMatrix, &toMatrix, &_transform);
+    
+}
+
+#pragma mark - Interpolating
+
+- (BOOL)interpolateAtPosition:(double)position into:(void *)value {
+    
+    if (self.type == AMInterpolatorTypeGeneric)
+        return NO;
+    
+    if (_motionPath) {
+        if (_motionPathAngles)
+            *(double *)value = [_motionPath angleAtPosition:position];
+        else
+            *(CGPoint *)value = [_motionPath pointAtPosition:position];
+        return YES;
+    }
+    
+    if (self.type == AMInterpolatorTypeNumber) {
+        AMValueLerp(&_fromNumber, &_deltaNumber, position, value, 1);
+        return YES;
+    }
+    
+    if (self.type == AMInterpolatorTypeTransform3D) {
+        AMTransformMatrix matrix = AMTransformInterpolationEvaluate(&_transform, position);
+        CGFloat *components = value;
+        for (NSUInteger idx = 0 ; idx < 16 ; idx++)
+            components[idx] = ((double *)matrix.m)[idx];
+        return YES;
+    }
+    
+    if (self.type == AMInterpolatorTypeBuffer) {
+        if (_fromBuffer.type == AMNumericBufferTypeDouble)
+            AMBufferLerpDoubles(_fromBuffer.bytes, _deltaBuffer.bytes, position, value, _fromBuffer.count);
+        else
+            AMBufferLerpFloats(_fromBuffer.bytes, _deltaBuffer.bytes, position, value, _fromBuffer.count);
+        return YES;
+    }
+    
+    if (self.type == AMInterpolatorTypeColor) {
+        double rgba[4];
+        AMColorInterpolate(_colorSpace, _fromColor, _deltaColor, position, rgba);
+        CGFloat *components = value;
+        for (NSUInteger idx = 0 ; idx < 4 ; idx++)
+            components[idx] = rgba[idx];
+        return YES;
+    }
+    
+    double components[4];
+    AMValueLerp(_from, _delta, position, components, _components);
+    
+    CGFloat *output = value;
+    for (NSUInteger idx = 0 ; idx < _components ; idx++)
+        output[idx] = components[idx];
+    
+    return YES;
+    
+}
+
+- (id<AMInterpolatable>)valueAtPosition:(double)position {
+    
+    switch (self.type) {
+        case AMInterpolatorTypeGeneric:
+            return [self.fromValue interpolateWithValue:self.toValue
+                                             atPosition:position];
+        case AMInterpolatorTypeNumber:
+            return @(_motionPath ? [_motionPath angleAtPosition:position] : _deltaNumber * position + _fromNumber);
+        case AMInterpolatorTypeTransform3D: {
+            CATransform3D transform;
+            [self interpolateAtPosition:position into:&transform];
+            return [NSValue valueWithCATransform3D:transform];
+        }
+        case AMInterpolatorTypeBuffer: {
+            AMNumericBuffer *buffer = [[AMNumericBuffer alloc] initWithType:_fromBuffer.type count:_fromBuffer.count];
+            [self interpolateAtPosition:position into:buffer.mutableBytes];
+            return buffer;
+        }
+        default: {
+            CGFloat components[4];
+            [self interpolateAtPosition:position into:components];
+            return [self boxValue:components];
+        }
+    }
+    
+}
+
+- (NSArray *)valuesAtPositions:(const double *)positions count:(NSUInteger)count {
+    
+    NSMutableArray *values = [[NSMutableArray alloc] initWithCapacity:count];
+    
+    for (NSUInteger idx = 0 ; idx < count ; idx++)
+        [values addObject:[self valueAtPosition:positions[idx]]];
+    
+    return values;
+    
+}
+
+- (id<AMInterpolatable>)boxValue:(const void *)value {
+    
+    switch (self.type) {
+        case AMInterpolatorTypeGeneric:
+            return nil;
+        case AMInterpolatorTypeNumber:
+            return @(*(const double *)value);
+        case AMInterpolatorTypeTransform3D:
+            return [NSValue valueWithCATransform3D:*(const CATransform3D *)value];
+        case AMInterpolatorTypeColor: {
+            const CGFloat *components = value;
+            UIColor *color = [UIColor colorWithRed:components[0] green:components[1] blue:components[2] alpha:components[3]];
+            return (_boxesCGColor ? (__bridge id)color.CGColor : color);
+        }
+        case AMInterpolatorTypeBuffer:
+            return (_fromBuffer.type == AMNumericBufferTypeDouble ? [[AMNumericBuffer alloc] initWithDoubles:value count:_fromBuffer.count] : [[AMNumericBuffer alloc] initWithFloats:value count:_fromBuffer.count]);
+        default:
+            return [NSValue valueWithBytes:value objCType:self.objCType];
+    }
+    
+}
+
+#pragma mark - Velocity
+
+- (BOOL)setInitialVelocity:(id<AMInterpolatable>)velocity slope:(double)slope duration:(NSTimeInterval)duration {
+    
+    if (self.type == AMInterpolatorTypeGeneric || self.type == AMInterpolatorTypeTransform3D || self.type == AMInterpolatorTypeColor || self.type == AMInterpolatorTypeBuffer || _motionPath || !isfinite(slope))
+        return NO;
+    
+    if (self.type == AMInterpolatorTypeNumber) {
+        if (![(id)velocity isKindOfClass:[NSNumber class]] || !isfinite([(NSNumber *)velocity doubleValue]))
+            return NO;
+        _carryNumber = [(NSNumber *)velocity doubleValue] * duration - _deltaNumber * slope;
+        _carries = YES;
+        return YES;
+    }
+    
+    if (![(id)velocity isKindOfClass:[NSValue class]] || 0 != strcmp([(NSValue *)velocity objCType], self.objCType))
+        return NO;
+    
+    CGFloat components[4];
+    [(NSValue *)velocity getValue:components];
+    
+    for (NSUInteger idx = 0 ; idx < _components ; idx++)
+        if (!isfinite(components[idx]))
+            return NO;
+    
+    for (NSUInteger idx = 0 ; idx < _components ; idx++)
+        _carry[idx] = components[idx] * duration - _delta[idx] * slope;
+    
+    _carries = YES;
+    
+    return YES;
+    
+}
+
+- (BOOL)interpolateAtPosition:(double)position progress:(double)progress into:(void *)value {
+    
+    if (!_carries)
+        return [self interpolateAtPosition:position into:value];
+    
+    if (self.type == AMInterpolatorTypeNumber) {
+        AMValueLerpCarrying(&_fromNumber, &_deltaNumber, &_carryNumber, position, progress, value, 1);
+        return YES;
+    }
+    
+    double components[4];
+    AMValueLerpCarrying(_from, _delta, _carry, position, progress, components, _components);
+    
+    CGFloat *output = value;
+    for (NSUInteger idx = 0 ; idx < _components ; idx++)
+        output[idx] = components[idx];
+    
+    return YES;
+    
+}
+
+- (id<AMInterpolatable>)valueAtPosition:(double)position progress:(double)progress {
+    
+    if (!_carries)
+        return [self valueAtPosition:position];
+    
+    if (self.type == AMInterpolatorTypeNumber) {
+        double number;
+        AMValueLerpCarrying(&_fromNumber, &_deltaNumber, &_carryNumber, position, progress, &number, 1);
+        return @(number);
+    }
+    
+    CGFloat components[4];
+    [self interpolateAtPosition:position progress:progress into:components];
+    
+    return [NSValue valueWithBytes:components objCType:self.objCType];
+    
+}
+
+- (id<AMInterpolatable>)velocityAtProgress:(double)progress slope:(double)slope duration:(NSTimeInterval)duration {
+    
+    if (self.type == AMInterpolatorTypeGeneric || self.type == AMInterpolatorTypeTransform3D || self.type == AMInterpolatorTypeColor || self.type == AMInterpolatorTypeBuffer || _motionPath || duration <= 0.0)
+        return nil;
+    
+    if (self.type == AMInterpolatorTypeNumber) {
+        double velocity;
+        AMValueVelocity(&_deltaNumber, (_carries ? &_carryNumber : NULL), slope, progress, duration, &velocity, 1);
+        return @(velocity);
+    }
+    
+    double velocity[4];
+    AMValueVelocity(_delta, (_carries ? _carry : NULL), slope, progress, duration, velocity, _components);
+    
+    CGFloat components[4];
+    for (NSUInteger idx = 0 ; idx < _components ; idx++)
+        components[idx] = velocity[idx];
+    
+    return [NSValue valueWithBytes:components objCType:self.objCType];
+    
+}
+
+@end
@@ -0,0 +1,199 @@
+//
+//  AMKeyframeArchive.h
+//  Animeteor
+//
+//  Copyright (c) 2013-2015, Kristian Trenskow
+//  All rights reserved.
+//  
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are met:
+//  
+//  1. Redistributions of source code must retain the above copyright notice,
+//  this list of conditions and the following disclaimer.
+//  
+//  2. Redistributions in binary form must reproduce the above copyright notice,
+//  this list of conditions and the following disclaimer in the documentation
+//  and/or other materials provided with the distribution.
+//  
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+//  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+//  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+//  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+//  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+//  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+//  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+//  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+//  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+//  POSSIBILITY OF SUCH DAMAGE.
+//
+
+@import QuartzCore;
+
+#import "AMAnimation.h"
+#import "AMCurveKernels.h"
+#import "AMInterpolator.h"
+
+@class AMDirectAnimation;
+
+/*!
+ The `AMKeyframeTrack` class is the baked keyframes of one animated key path. Keyframes are read directly from the archive's data - no curves are evaluated when a track is used.
+ */
+@interface AMKeyframeTrack : NSObject
+
++ (instancetype _Nullable)new UNAVAILABLE_ATTRIBUTE;
+- (instancetype _Nullable)init UNAVAILABLE_ATTRIBUTE;
+
+/// -------------------------------
+/// @name Getting Track Information
+/// -------------------------------
+
+/*!
+ Returns the animated key path.
+ */
+@property (nonatomic,readonly,nonnull) NSString *keyPath;
+
+/*!
+ Returns the duration of the baked animation.
+ */
+@property (nonatomic,readonly) NSTimeInterval duration;
+
+/*!
+ Returns the delay of the baked animation.
+ */
+@property (nonatomic,readonly) NSTimeInterval delay;
+
+/*!
+ Returns the function of the curve the track was baked from - or `AMCurveFunctionCustom` for block and subclassed curves.
+ */
+@property (nonatomic,readonly) AMCurveFunction curveFunction;
+
+/*!
+ Returns the type of the values.
+ */
+@property (nonatomic,readonly) AMInterpolatorType type;
+
+/*!
+ Returns the number of keyframes.
+ */
+@property (nonatomic,readonly) NSUInteger count;
+
+/*!
+ Returns the number of floats in every value.
+ */
+@property (nonatomic,readonly) NSUInteger componentCount;
+
+/*!
+ Returns the key times of the keyframes - between zero and one.
+ */
+@property (nonatomic,readonly,nonnull) const float *keyTimes NS_RETURNS_INNER_POINTER;
+
+/*!
+ Returns the values of the keyframes - `componentCount` floats per keyframe. Structs are stored as their CGFloat members in order - and colors as red, green, blue and alpha in (extended) sRGB.
+ */
+@property (nonatomic,readonly,nonnull) const float *values NS_RETURNS_INNER_POINTER;
+
+/// -------------------------
+/// @name Playing Back Tracks
+/// -------------------------
+
+/*!
+ Returns a keyframe animation of the track.
+ 
+ @discussion The animation has the duration of the track and no begin time. Set `beginTime` to `CACurrentMediaTime() + delay` to honor the delay.
+ 
+ @return A keyframe animation.
+ */
+- (CAKeyframeAnimation * _Nonnull)keyframeAnimation;
+
+/*!
+ Returns a direct animation that plays back the track on an object.
+ 
+ @param object     The object to animate.
+ @param completion An optional completion block that gets called when the animation completes.
+ 
+ @return A direct animation.
+ */
+- (AMDirectAnimation * _Nonnull)directAnimationWithObject:(id _Nonnull)object completion:(AMCompletionBlock _Nullable)completion;
+
+/*!
+ Returns the value of the track at a specific time.
+ 
+ @param time The time since the animation would begin - including its delay.
+ 
+ @return The value interpolated linearly between the neighbouring keyframes.
+ */
+- (id<AMInterpolatable> _Nonnull)valueAtTime:(NSTimeInterval)time;
+
+@end
+
+/*!
+ The `AMKeyframeArchive` class bakes animations into a compact binary format, and loads them back without evaluating curves or interpolating values. Use it for animations that are the same every launch - like onboarding or loading sequences.
+ 
+ An archive holds a track of packed float keyframes for every animated key path - with the duration, delay and curve of the animation. Archives are memory mapped when loaded from a file, so tracks read their keyframes directly from the file. Archives are stored in the byte order of the device that baked them.
+ */
+@interface AMKeyframeArchive : NSObject
+
++ (instancetype _Nullable)new UNAVAILABLE_ATTRIBUTE;
+- (instancetype _Nullable)init UNAVAILABLE_ATTRIBUTE;
+
+/// -----------------------
+/// @name Baking Animations
+/// -----------------------
+
+/*!
+ Bakes animations into archive data.
+ 
+ @param animations   The animations to bake. Layer animations and direct animations are baked into a track each - groups are baked as their animations.
+ @param keyframeRate The number of times per second the curves are sampled.
+ @param tolerance    The maximum deviation from the curve allowed when removing redundant keyframes - where one is the distance between the from and to values.
+ 
+ @return The archive data - which can be written to a file.
+ 
+ @discussion Tracks are stored in the order of the animations - with the animations of groups ordered by start time. Numbers, points, sizes, vectors, rects, transforms and colors are baked - colors in the color space of the animation. Other values - like buffers and values that cannot be unboxed - are not baked, nor are animations whose samples cannot be allocated. This method must be called on the main thread.
+ */
++ (NSData * _Nonnull)dataByBakingAnimations:(NSArray<id<AMAnimation>> * _Nonnull)animations
+                               keyframeRate:(double)keyframeRate
+                                  tolerance:(double)tolerance;
+
+/// ----------------------
+/// @name Loading Archives
+/// ----------------------
+
+/*!
+ Returns an archive loaded from data.
+ 
+ @param data The archive data. The data is retained and keyframes are read from it directly.
+ 
+ @return An archive - or `nil` if the data is not a valid archive.
+ */
+- (instancetype _Nullable)initWithData:(NSData * _Nonnull)data;
+
+/*!
+ Returns an archive loaded from a file by memory mapping it.
+ 
+ @param path The path of the archive file.
+ 
+ @return An archive - or `nil` if the file could not be read or is not a valid archive.
+ */
+- (instancetype _Nullable)initWithContentsOfFile:(NSString * _Nonnull)path;
+
+/// --------------------
+/// @name Getting Tracks
+/// --------------------
+
+/*!
+ Returns the tracks of the archive - in the order they were baked.
+ */
+@property (nonatomic,readonly,nonnull) NSArray<AMKeyframeTrack *> *tracks;
+
+/*!
+ Returns the first track of a key path.
+ 
+ @param keyPath The key path.
+ 
+ @return The first track animating the key path - or `nil` if none does.
+ */
+- (AMKeyframeTrack * _Nullable)trackForKeyPath:(NSString * _Nonnull)keyPath;
+
+@end
@@ -0,0 +1,530 @@
+//
+//  AMKeyframeArchive.m
+//  Animeteor
+//
+//  Copyright (c) 2013-2015, Kristian Trenskow
+//  All rights reserved.
+//  
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are met:
+//  
+//  1. Redistributions of source code must retain the above copyright notice,
+//  this list of conditions and the following disclaimer.
+//  
+//  2. Redistributions in binary form must reproduce the above copyright notice,
+//  this list of conditions and the following disclaimer in the documentation
+//  and/or other materials provided with the distribution.
+//  
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+//  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+//  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+//  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+//  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+//  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+//  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+//  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+//  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+//  POSSIBILITY OF SUCH DAMAGE.
+//
+
+@import UIKit;
+
+#import "AMMacros.h"
+
+#import "AMCurve.h"
+#import "AMMotionPath.h"
+#import "AMAnimationGroup.h"
+#import "AMLayerAnimation.h"
+#import "AMDirectAnimation.h"
+
+#import "AMKeyframeArchive.h"
+
+#define AM_KEYFRAME_ARCHIVE_MAGIC 0x414D4B41 /* AMKA */
+#define AM_KEYFRAME_ARCHIVE_VERSION 2
+
+/* Colors are boxed as `CGColorRef` values instead of `UIColor`. */
+#define AM_KEYFRAME_ARCHIVE_FLAG_CGCOLOR (1 << 0)
+
+/* The archive begins with a header followed by a table of tracks. Keyframes and key paths follow the table - referenced by offsets from the beginning of the archive. */
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t trackCount;
+    uint32_t reserved;
+} AMKeyframeArchiveHeader;
+
+typedef struct {
+    double duration;
+    double delay;
+    uint32_t keyPathOffset;
+    uint32_t keyPathLength;
+    uint32_t type;
+    uint32_t curveFunction;
+    uint32_t componentCount;
+    uint32_t keyframeCount;
+    uint32_t keyTimesOffset;
+    uint32_t valuesOffset;
+    uint32_t flags;
+    uint32_t reserved;
+} AMKeyframeArchiveEntry;
+
+/* Layer and direct animations share what is needed to bake them. */
+@protocol AMKeyframeArchiveBakeable <AMAnimation>
+
+@property (nonatomic,copy,readonly) NSString *keyPath;
+@property (nonatomic,readonly) AMCurve *curve;
+@property (nonatomic,readonly) AMColorSpace colorSpace;
+
+- (id<AMInterpolatable>)valueAtTime:(NSTimeInterval)time;
+
+@optional
+@property (nonatomic,readonly) AMMotionPath *motionPath;
+
+@end
+
+static NSUInteger AMKeyframeArchiveComponentCount(AMInterpolatorType type) {
+    
+    switch (type) {
+        case AMInterpolatorTypeNumber:
+            return 1;
+        case AMInterpolatorTypePoint:
+        case AMInterpolatorTypeSize:
+        case AMInterpolatorTypeVector:
+            return 2;
+        case AMInterpolatorTypeRect:
+        case AMInterpolatorTypeColor:
+            return 4;
+        case AMInterpolatorTypeTransform3D:
+            return 16;
+        default:
+            return 0;
+    }
+    
+}
+
+static id<AMInterpolatable> AMKeyframeArchiveBoxValue(AMInterpolatorType type, uint32_t flags, const float *components) {
+    
+    if (type == AMInterpolatorTypeNumber)
+        return @((double)components[0]);
+    
+    CGFloat value[16];
+    NSUInteger count = AMKeyframeArchiveComponentCount(type);
+    for (NSUInteger idx = 0 ; idx < count ; idx++)
+        value[idx] = components[idx];
+    
+    switch (type) {
+        case AMInterpolatorTypePoint:
+            return [NSValue valueWithBytes:value objCType:@encode(CGPoint)];
+        case AMInterpolatorTypeSize:
+            return [NSValue valueWithBytes:value objCType:@encode(CGSize)];
+        case AMInterpolatorTypeVector:
+            return [NSValue valueWithBytes:value objCType:@encode(CGVector)];
+        case AMInterpolatorTypeRect:
+            return [NSValue valueWithBytes:value objCType:@encode(CGRect)];
+        case AMInterpolatorTypeColor: {
+            UIColor *color = [UIColor colorWithRed:value[0] green:value[1] blue:value[2] alpha:value[3]];
+            return ((flags & AM_KEYFRAME_ARCHIVE_FLAG_CGCOLOR) ? (__bridge id)color.CGColor : color);
+        }
+        default:
+            return [NSValue valueWithBytes:value objCType:@encode(CATransform3D)];
+    }
+    
+}
+
+static void AMKeyframeArchiveFlattenAnimations(NSArray *animations, NSMutableArray *flattened) {
+    
+    for (id<AMAnimation> animation in animations) {
+        if ([animation isKindOfClass:[AMAnimationGroup class]])
+            AMKeyframeArchiveFlattenAnimations(((AMAnimationGroup *)animation).animations, flattened);
+        else if ([animation isKindOfClass:[AMLayerAnimation class]] || [animation isKindOfClass:[AMDirectAnimation class]])
+            [flattened addObject:animation];
+    }
+    
+}
+
+#pragma mark - Track
+
+@interface AMKeyframeTrack () {
+    NSData *_data;
+    uint32_t _flags;
+}
+
+- (instancetype)initWithData:(NSData *)data entry:(const AMKeyframeArchiveEntry *)entry keyPath:(NSString *)keyPath;
+
+@end
+
+@implementation AMKeyframeTrack
+
+#pragma mark - Setup / Teardown
+
+- (instancetype)initWithData:(NSData *)data entry:(const AMKeyframeArchiveEntry *)entry keyPath:(NSString *)keyPath {
+    
+    if ((self = [super init])) {
+        
+        _data = data;
+        _keyPath = keyPath;
+        _duration = entry->duration;
+        _delay = entry->delay;
+        _curveFunction = (AMCurveFunction)entry->curveFunction;
+        _type = (AMInterpolatorType)entry->type;
+        _count = entry->keyframeCount;
+        _componentCount = entry->componentCount;
+        _flags = entry->flags;
+        _keyTimes = (const float *)((const uint8_t *)data.bytes + entry->keyTimesOffset);
+        _values = (const float *)((const uint8_t *)data.bytes + entry->valuesOffset);
+        
+    }
+    
+    return self;
+    
+}
+
+#pragma mark - Internals
+
+- (void)getComponents:(float *)components atProgress:(double)progress {
+    
+    /* Find the first keyframe after the progress. */
+    NSUInteger low = 0, high = _count;
+    while (low < high) {
+        NSUInteger middle = low + (high - low) / 2;
+        if (_keyTimes[middle] <= progress) low = middle + 1;
+        else high = middle;
+    }
+    
+    if (low == 0 || low == _count) {
+        memcpy(components, _values + (low == 0 ? 0 : _count - 1) * _componentCount, sizeof(float) * _componentCount);
+        return;
+    }
+    
+    const float *from = _values + (low - 1) * _componentCount;
+    const float *to = _values + low * _componentCount;
+    float fraction = (float)((progress - _keyTimes[low - 1]) / (_keyTimes[low] - _keyTimes[low - 1]));
+    
+    for (NSUInteger idx = 0 ; idx < _componentCount ; idx++)
+        components[idx] = from[idx] + (to[idx] - from[idx]) * fraction;
+    
+}
+
+- (id<AMInterpolatable>)valueAtProgress:(double)progress {
+    
+    float components[16];
+    [self getComponents:components atProgress:progress];
+    
+    return AMKeyframeArchiveBoxValue(self.type, _flags, components);
+    
+}
+
+#pragma mark - Playing Back Tracks
+
+- (CAKeyframeAnimation *)keyframeAnimation {
+    
+    NSMutableArray *keyTimes = [[NSMutableArray alloc] initWithCapacity:_count];
+    NSMutableArray *values = [[NSMutableArray alloc] initWithCapacity:_count];
+    
+    for (NSUInteger idx = 0 ; idx < _count ; idx++) {
+        [keyTimes addObject:@(_keyTimes[idx])];
+        [values addObject:AMKeyframeArchiveBoxValue(self.type, _flags, _values + idx * _componentCount)];
+    }
+    
+    CAKeyframeAnimation *animation = [CAKeyframeAnimation animationWithKeyPath:self.keyPath];
+    animation.keyTimes = keyTimes;
+    animation.values = values;
+    animation.duration = self.duration;
+    animation.calculationMode = kCAAnimationLinear;
+    
+    return animation;
+    
+}
+
+- (AMDirectAnimation *)directAnimationWithObject:(id)object completion:(AMCompletionBlock)completion {
+    
+    AMAssertMainThread();
+    
+    /* The animation animates the progress linearly - the track maps it to values. */
+    AMDirectAnimation *animation = [[AMDirectAnimation alloc] initWithObject:object
+                                                                     keyPath:self.keyPath
+                                                                   fromValue:@0.0
+                                                                     toValue:@1.0
+                                                                    duration:self.duration
+                                                                       delay:self.delay
+                                                                       curve:[AMCurve linear]
+                                                                  completion:completion];
+    
+    NSString *keyPath = self.keyPath;
+    
+    animation.setter = ^(id target, const void *value) {
+        [target setValue:[self valueAtProgress:*(const double *)value] forKeyPath:keyPath];
+    };
+    
+    return animation;
+    
+}
+
+- (id<AMInterpolatable>)valueAtTime:(NSTimeInterval)time {
+    
+    double progress = (self.duration > 0.0 ? MIN(MAX((time - self.delay) / self.duration, 0.0), 1.0) : (time >= self.delay ? 1.0 : 0.0));
+    
+    return [self valueAtProgress:progress];
+    
+}
+
+@end
+
+#pragma mark - Archive
+
+@interface AMKeyframeArchive ()
+
+@property (nonatomic,readwrite) NSArray<AMKeyframeTrack *> *tracks;
+
+@end
+
+@implementation AMKeyframeArchive
+
+#pragma mark - Baking Animations
+
++ (NSData *)dataByBakingAnimations:(NSArray<id<AMAnimation>> *)animations keyframeRate:(double)keyframeRate tolerance:(double)tolerance {
+    
+    AMAssertMainThread();
+    
+    NSMutableArray *flattened = [[NSMutableArray alloc] init];
+    AMKeyframeArchiveFlattenAnimations(animations, flattened);
+    
+    NSMutableData *payload = [[NSMutableData alloc] init];
+    NSMutableData *entries = [[NSMutableData alloc] init];
+    
+    for (id<AMKeyframeArchiveBakeable> animation in flattened) {
+        
+        NSTimeInterval duration = animation.duration;
+        AMCurve *curve = animation.curve;
+        
+        /* The values at the ends resolve `nil` from values to the current value. */
+        AMMotionPath *motionPath = ([animation respondsToSelector:@selector(motionPath)] ? animation.motionPath : nil);
+        id<AMInterpolatable> fromValue = [animation valueAtTime:animation.delay];
+        AMInterpolator *interpolator;
+        
+        if (motionPath)
+            interpolator = [[AMInterpolator alloc] initWithMotionPath:motionPath];
+        else
+            interpolator = [[AMInterpolator alloc] initWithFromValue:fromValue
+                                                             toValue:[animation valueAtTime:animation.delay + duration]
+                                                          colorSpace:animation.colorSpace];
+        
+        NSUInteger componentCount = AMKeyframeArchiveComponentCount(interpolator.type);
+        if (componentCount == 0)
+            continue;
+        
+        /* Sampled and reduced like curved animations do. */
+        NSUInteger frames = MAX((NSUInteger)ceil(fabs(duration) * keyframeRate), (NSUInteger)1);
+        NSUInteger count = frames + 1;
+        
+        double *times = malloc(sizeof(double) * count);
+        double *positions = malloc(sizeof(double) * count);
+        bool *keep = malloc(sizeof(bool) * count);
+        
+        /* Tracks that cannot be sampled are not baked. */
+        if (!times || !positions || !keep) {
+            free(times);
+            free(positions);
+            free(keep);
+            continue;
+        }
+        
+        for (NSUInteger idx = 0 ; idx < count ; idx++)
+            times[idx] = (double)idx / frames;
+        
+        [curve transformPositions:times count:count output:positions];
+        
+        NSUInteger kept;
+        
+        /* Points along a motion path are not linear in the curve - and colors outside of sRGB are reduced on their baked components. */
+        if (interpolator.type == AMInterpolatorTypeColor && interpolator.colorSpace != AMColorSpaceSRGB) {
+            double *components = malloc(sizeof(double) * 4 * count);
+            if (components) {
+                CGFloat rgba[4];
+                for (NSUInteger idx = 0 ; idx < count ; idx++) {
+                    [interpolator interpolateAtPosition:positions[idx] into:rgba];
+                    for (NSUInteger component = 0 ; component < 4 ; component++)
+                        components[idx * 4 + component] = rgba[component];
+                }
+                kept = AMCurveReduceComponentSamples(times, components, 4, count, tolerance, keep);
+                free(components);
+            } else
+                kept = AMCurveReduceSamples(times, positions, count, 0.0, keep);
+        } else
+            kept = AMCurveReduceSamples(times, positions, count, (motionPath ? 0.0 : tolerance), keep);
+        
+        float *keyTimes = malloc(sizeof(float) * kept);
+        float *values = malloc(sizeof(float) * kept * componentCount);
+        
+        if (!keyTimes || !values) {
+            free(times);
+            free(positions);
+            free(keep);
+            free(keyTimes);
+            free(values);
+            continue;
+        }
+        
+        NSUInteger keptIndex = 0;
+        for (NSUInteger idx = 0 ; idx < count ; idx++) {
+            
+            if (!keep[idx]) continue;
+            
+            keyTimes[keptIndex] = (float)times[idx];
+            
+            /* Numbers are unboxed as doubles - structs and colors as CGFloats. */
+            union {
+                double number;
+                CGFloat components[16];
+            } value;
+            
+            [interpolator interpolateAtPosition:positions[idx] into:&value];
+            
+            float *components = values + keptIndex * componentCount;
+            if (interpolator.type == AMInterpolatorTypeNumber)
+                components[0] = (float)value.number;
+            else
+                for (NSUInteger component = 0 ; component < componentCount ; component++)
+                    components[component] = (float)value.components[component];
+            
+            keptIndex++;
+            
+        }
+        
+        NSData *keyPath = [animation.keyPath dataUsingEncoding:NSUTF8StringEncoding];
+        
+        AMKeyframeArchiveEntry entry;
+        memset(&entry, 0, sizeof(entry));
+        entry.duration = duration;
+        entry.delay = animation.delay;
+        entry.type = (uint32_t)interpolator.type;
+        entry.curveFunction = (uint32_t)curve.function;
+        entry.componentCount = (uint32_t)componentCount;
+        entry.keyframeCount = (uint32_t)kept;
+        entry.flags = (interpolator.type == AMInterpolatorTypeColor && ![(id)fromValue isKindOfClass:[UIColor class]] ? AM_KEYFRAME_ARCHIVE_FLAG_CGCOLOR : 0);
+        
+        /* Offsets are relative to the payload until the size of the table is known. */
+        entry.keyTimesOffset = (uint32_t)payload.length;
+        [payload appendBytes:keyTimes length:sizeof(float) * kept];
+        entry.valuesOffset = (uint32_t)payload.length;
+        [payload appendBytes:values length:sizeof(float) * kept * componentCount];
+        entry.keyPathOffset = (uint32_t)payload.length;
+        entry.keyPathLength = (uint32_t)keyPath.length;
+        [payload appendData:keyPath];
+        
+        /* Keep the floats of the next track aligned. */
+        [payload increaseLengthBy:(4 - payload.length % 4) % 4];
+        
+        [entries appendBytes:&entry length:sizeof(entry)];
+        
+        free(times);
+        free(positions);
+        free(keep);
+        free(keyTimes);
+        free(values);
+        
+    }
+    
+    NSUInteger trackCount = entries.length / sizeof(AMKeyframeArchiveEntry);
+    uint32_t payloadOffset = (uint32_t)(sizeof(AMKeyframeArchiveHeader) + entries.length);
+    
+    AMKeyframeArchiveEntry *entry = entries.mutableBytes;
+    for (NSUInteger idx = 0 ; idx < trackCount ; idx++) {
+        entry[idx].keyTimesOffset += payloadOffset;
+        entry[idx].valuesOffset += payloadOffset;
+        entry[idx].keyPathOffset += payloadOffset;
+    }
+    
+    AMKeyframeArchiveHeader header = { AM_KEYFRAME_ARCHIVE_MAGIC, AM_KEYFRAME_ARCHIVE_VERSION, (uint32_t)trackCount, 0 };
+    
+    NSMutableData *data = [[NSMutableData alloc] initWithCapacity:payloadOffset + payload.length];
+    [data appendBytes:&header length:sizeof(header)];
+    [data appendData:entries];
+    [data appendData:payload];
+    
+    return data;
+    
+}
+
+#pragma mark - Loading Archives
+
+- (instancetype)initWithData:(NSData *)data {
+    
+    if ((self = [super init])) {
+        
+        const uint8_t *bytes = data.bytes;
+        uint64_t length = data.length;
+        
+        AMKeyframeArchiveHeader header;
+        if (length < sizeof(header))
+            return nil;
+        
+        memcpy(&header, bytes, sizeof(header));
+        
+        if (header.magic != AM_KEYFRAME_ARCHIVE_MAGIC || header.version != AM_KEYFRAME_ARCHIVE_VERSION)
+            return nil;
+        
+        if (sizeof(header) + (uint64_t)header.trackCount * sizeof(AMKeyframeArchiveEntry) > length)
+            return nil;
+        
+        NSMutableArray *tracks = [[NSMutableArray alloc] initWithCapacity:header.trackCount];
+        
+        for (uint32_t idx = 0 ; idx < header.trackCount ; idx++) {
+            
+            AMKeyframeArchiveEntry entry;
+            memcpy(&entry, bytes + sizeof(header) + idx * sizeof(entry), sizeof(entry));
+            
+            /* Never trust offsets - the archive may be truncated or corrupt. */
+            if (entry.keyframeCount == 0 ||
+                entry.componentCount == 0 ||
+                entry.componentCount != AMKeyframeArchiveComponentCount((AMInterpolatorType)entry.type) ||
+                (entry.flags & ~(uint32_t)AM_KEYFRAME_ARCHIVE_FLAG_CGCOLOR) != 0 ||
+                entry.keyTimesOffset % sizeof(float) != 0 ||
+                entry.valuesOffset % sizeof(float) != 0 ||
+                (uint64_t)entry.keyTimesOffset + (uint64_t)entry.keyframeCount * sizeof(float) > length ||
+                (uint64_t)entry.valuesOffset + (uint64_t)entry.keyframeCount * entry.componentCount * sizeof(float) > length ||
+                (uint64_t)entry.keyPathOffset + entry.keyPathLength > length ||
+                !(entry.duration >= 0.0) || !isfinite(entry.delay))
+                return nil;
+            
+            NSString *keyPath = [[NSString alloc] initWithBytes:bytes + entry.keyPathOffset length:entry.keyPathLength encoding:NSUTF8StringEncoding];
+            if (!keyPath)
+                return nil;
+            
+            [tracks addObject:[[AMKeyframeTrack alloc] initWithData:data entry:&entry keyPath:keyPath]];
+            
+        }
+        
+        _tracks = [tracks copy];
+        
+    }
+    
+    return self;
+    
+}
+
+- (instancetype)initWithContentsOfFile:(NSString *)path {
+    
+    NSData *data = [NSData dataWithContentsOfFile:path options:NSDataReadingMappedAlways error:NULL];
+    
+    if (!data)
+        return nil;
+    
+    return [self initWithData:data];
+    
+}
+
+#pragma mark - Getting Tracks
+
+- (AMKeyframeTrack *)trackForKeyPath:(NSString *)keyPath {
+    
+    for (AMKeyframeTrack *track in self.tracks)
+        if ([track.keyPath isEqualToString:keyPath])
+            return track;
+    
+    return nil;
+    
+}
+
+@end
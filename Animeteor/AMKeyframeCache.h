@@ -0,0 +1,142 @@
+//
+//  AMKeyframeCache.h
+//  Animeteor
+//
+//  Copyright (c) 2013-2015, Kristian Trenskow
+//  All rights reserved.
+//  
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are met:
+//  
+//  1. Redistributions of source code must retain the above copyright notice,
+//  this list of conditions and the following disclaimer.
+//  
+//  2. Redistributions in binary form must reproduce the above copyright notice,
+//  this list of conditions and the following disclaimer in the documentation
+//  and/or other materials provided with the distribution.
+//  
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+//  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+//  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+//  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+//  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+//  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+//  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+//  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+//  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+//  POSSIBILITY OF SUCH DAMAGE.
+//
+
+@import Foundation;
+
+@class AMCurvedAnimation;
+
+/*!
+ The `AMKeyframeCache` class shares generated keyframes between curved animations with identical setups - like the same fade started on every layer of a grid. Keyframes are keyed by curve identity, from and to values, duration, speed, keyframe rate, tolerance and color space, and stored as immutable arrays that are handed to every animation with the same setup.
+ 
+ The cache is limited by the total number of keyframes it holds. When the limit is exceeded the least recently used keyframes are evicted. The cache is thread safe.
+ */
+@interface AMKeyframeCache : NSObject
+
+/// ----------------------------
+/// @name Getting Keyframe Cache
+/// ----------------------------
+
+/*!
+ Returns the shared keyframe cache used by curved animations by default.
+ 
+ @return The shared keyframe cache.
+ */
++ (AMKeyframeCache * _Nonnull)sharedCache;
+
+/// ------------------------------
+/// @name Creating Keyframe Caches
+/// ------------------------------
+
+/*!
+ Returns an initialized keyframe cache.
+ 
+ @param costLimit The maximum number of keyframes held by the cache.
+ 
+ @return An initialized keyframe cache.
+ */
+- (instancetype _Nonnull)initWithCostLimit:(NSUInteger)costLimit;
+
+/// ------------------------
+/// @name Managing Keyframes
+/// ------------------------
+
+/*!
+ Looks up the keyframes of an animation.
+ 
+ @param keyTimes  On return the cached key times or `nil` if none are cached.
+ @param values    On return the cached values or `nil` if none are cached.
+ @param animation The animation to look up keyframes for.
+ 
+ @return `YES` if keyframes were found.
+ */
+- (BOOL)getKeyTimes:(NSArray<NSNumber *> * _Nullable __autoreleasing * _Nonnull)keyTimes
+             values:(NSArray * _Nullable __autoreleasing * _Nonnull)values
+       forAnimation:(AMCurvedAnimation * _Nonnull)animation;
+
+/*!
+ Stores the keyframes of an animation. The arrays are copied, so they can be shared.
+ 
+ @param keyTimes  The key times of the animation.
+ @param values    The values of the animation.
+ @param animation The animation the keyframes belong to.
+ */
+- (void)setKeyTimes:(NSArray<NSNumber *> * _Nonnull)keyTimes
+             values:(NSArray * _Nonnull)values
+       forAnimation:(AMCurvedAnimation * _Nonnull)animation;
+
+/*!
+ Removes all keyframes from the cache.
+ */
+- (void)removeAllKeyframes;
+
+/// ---------------------------
+/// @name Configuring the Cache
+/// ---------------------------
+
+/*!
+ The maximum number of keyframes held by the cache. Default is 8192 for the shared cache and caches created using `init`.
+ */
+@property (nonatomic) NSUInteger costLimit;
+
+/// ------------------------------
+/// @name Getting Cache Statistics
+/// ------------------------------
+
+/*!
+ Returns the number of keyframes currently held by the cache.
+ */
+@property (nonatomic,readonly) NSUInteger totalCost;
+
+/*!
+ Returns the number of setups currently held by the cache.
+ */
+@property (nonatomic,readonly) NSUInteger count;
+
+/*!
+ Returns the number of lookups that found keyframes.
+ */
+@property (nonatomic,readonly) NSUInteger hitCount;
+
+/*!
+ Returns the number of lookups that found no keyframes.
+ */
+@property (nonatomic,readonly) NSUInteger missCount;
+
+/*!
+ Returns the number of setups evicted to stay within the cost limit.
+ */
+@property (nonatomic,readonly) NSUInteger evictionCount;
+
+/*!
+ Resets the hit, miss and eviction counters.
+ */
+- (void)resetStatistics;
+
+@end
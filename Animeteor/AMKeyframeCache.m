@@ -0,0 +1,378 @@
+//
+//  AMKeyframeCache.m
+//  Animeteor
+//
+//  Copyright (c) 2013-2015, Kristian Trenskow
+//  All rights reserved.
+//  
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are met:
+//  
+//  1. Redistributions of source code must retain the above copyright notice,
+//  this list of conditions and the following disclaimer.
+//  
+//  2. Redistributions in binary form must reproduce the above copyright notice,
+//  this list of conditions and the following disclaimer in the documentation
+//  and/or other materials provided with the distribution.
+//  
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+//  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+//  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+//  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+//  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+//  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+//  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+//  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+//  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+//  POSSIBILITY OF SUCH DAMAGE.
+//
+
+#import <pthread.h>
+
+#import "AMCurve.h"
+#import "AMCurvedAnimation.h"
+
+#import "AMKeyframeCache.h"
+
+@interface AMKeyframeCacheKey : NSObject <NSCopying>
+
+@property (nonatomic,readonly) AMCurve *curve;
+@property (nonatomic,readonly) id fromValue;
+@property (nonatomic,readonly) id toValue;
+@property (nonatomic,readonly) CFTimeInterval duration;
+@property (nonatomic,readonly) double keyframeRate;
+@property (nonatomic,readonly) double keyframeTolerance;
+@property (nonatomic,readonly) AMColorSpace colorSpace;
+@property (nonatomic,readonly) NSUInteger hashValue;
+
+@end
+
+@implementation AMKeyframeCacheKey
+
+- (instancetype)initWithAnimation:(AMCurvedAnimation *)animation {
+    
+    if ((self = [super init])) {
+        
+        /* The curve is retained, so its address cannot be reused by another curve while cached. */
+        _curve = animation.curve;
+        _fromValue = animation.fromValue;
+        _toValue = animation.toValue;
+        _duration = fabs(animation.duration / animation.speed);
+        _keyframeRate = animation.keyframeRate;
+        _keyframeTolerance = animation.keyframeTolerance;
+        _colorSpace = animation.colorSpace;
+        
+        _hashValue = (NSUInteger)(__bridge void *)_curve ^ ([_fromValue hash] * 31) ^ ([_toValue hash] * 61) ^ (NSUInteger)(_duration * 1000.0) ^ ((NSUInteger)_keyframeRate << 16);
+        
+    }
+    
+    return self;
+    
+}
+
+- (id)copyWithZone:(NSZone *)zone {
+    
+    return self;
+    
+}
+
+- (NSUInteger)hash {
+    
+    return self.hashValue;
+    
+}
+
+- (BOOL)isEqual:(AMKeyframeCacheKey *)object {
+    
+    if (self == object) return YES;
+    if (![object isKindOfClass:[AMKeyframeCacheKey class]]) return NO;
+    
+    return (_curve == object->_curve &&
+            _duration == object->_duration &&
+            _keyframeRate == object->_keyframeRate &&
+            _keyframeTolerance == object->_keyframeTolerance &&
+            _colorSpace == object->_colorSpace &&
+            [_fromValue isEqual:object->_fromValue] &&
+            [_toValue isEqual:object->_toValue]);
+    
+}
+
+@end
+
+@interface AMKeyframeCacheEntry : NSObject {
+    @public
+    AMKeyframeCacheKey *_key;
+    NSArray *_keyTimes;
+    NSArray *_values;
+    __unsafe_unretained AMKeyframeCacheEntry *_previous;
+    __unsafe_unretained AMKeyframeCacheEntry *_next;
+}
+
+@end
+
+@implementation AMKeyframeCacheEntry
+
+@end
+
+@interface AMKeyframeCache () {
+    pthread_mutex_t _lock;
+    NSMutableDictionary *_entries;
+    /* Entries are linked from most (head) to least (tail) recently used - the dictionary owns them. */
+    __unsafe_unretained AMKeyframeCacheEntry *_head;
+    __unsafe_unretained AMKeyframeCacheEntry *_tail;
+}
+
+@property (nonatomic,readwrite) NSUInteger totalCost;
+@property (nonatomic,readwrite) NSUInteger hitCount;
+@property (nonatomic,readwrite) NSUInteger missCount;
+@property (nonatomic,readwrite) NSUInteger evictionCount;
+
+@end
+
+@implementation AMKeyframeCache
+
+#pragma mark - Getting Keyframe Cache
+
++ (AMKeyframeCache *)sharedCache {
+    
+    static AMKeyframeCache *cache;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        cache = [[AMKeyframeCache alloc] init];
+    });
+    
+    return cache;
+    
+}
+
+#pragma mark - Setup / Teardown
+
+- (instancetype)init {
+    
+    return [self initWithCostLimit:8192];
+    
+}
+
+- (instancetype)initWithCostLimit:(NSUInteger)costLimit {
+    
+    if ((self = [super init])) {
+        
+        pthread_mutex_init(&_lock, NULL);
+        _entries = [[NSMutableDictionary alloc] init];
+        _costLimit = costLimit;
+        
+    }
+    
+    return self;
+    
+}
+
+- (void)dealloc {
+    
+    pthread_mutex_destroy(&_lock);
+    
+}
+
+#pragma mark - Internals
+
+- (void)unlinkEntry:(AMKeyframeCacheEntry *)entry {
+    
+    if (entry->_previous) entry->_previous->_next = entry->_next;
+    else _head = entry->_next;
+    
+    if (entry->_next) entry->_next->_previous = entry->_previous;
+    else _tail = entry->_previous;
+    
+    entry->_previous = entry->_next = nil;
+    
+}
+
+- (void)linkEntryAtHead:(AMKeyframeCacheEntry *)entry {
+    
+    entry->_previous = nil;
+    entry->_next = _head;
+    
+    if (_head) _head->_previous = entry;
+    _head = entry;
+    
+    if (!_tail) _tail = entry;
+    
+}
+
+- (void)removeEntry:(AMKeyframeCacheEntry *)entry {
+    
+    AMKeyframeCacheKey *key = entry->_key;
+    
+    [self unlinkEntry:entry];
+    _totalCost -= [entry->_keyTimes count];
+    [_entries removeObjectForKey:key];
+    
+}
+
+- (void)trimToCostLimit {
+    
+    while (_totalCost > _costLimit && _tail) {
+        [self removeEntry:_tail];
+        _evictionCount++;
+    }
+    
+}
+
+#pragma mark - Managing Keyframes
+
+- (BOOL)getKeyTimes:(NSArray<NSNumber *> *__autoreleasing *)keyTimes values:(NSArray *__autoreleasing *)values forAnimation:(AMCurvedAnimation *)animation {
+    
+    AMKeyframeCacheKey *key = [[AMKeyframeCacheKey alloc] initWithAnimation:animation];
+    
+    pthread_mutex_lock(&_lock);
+    
+    AMKeyframeCacheEntry *entry = _entries[key];
+    
+    if (entry) {
+        
+        [self unlinkEntry:entry];
+        [self linkEntryAtHead:entry];
+        
+        *keyTimes = entry->_keyTimes;
+        *values = entry->_values;
+        
+        _hitCount++;
+        
+    } else {
+        
+        *keyTimes = *values = nil;
+        
+        _missCount++;
+        
+    }
+    
+    pthread_mutex_unlock(&_lock);
+    
+    return (entry != nil);
+    
+}
+
+- (void)setKeyTimes:(NSArray<NSNumber *> *)keyTimes values:(NSArray *)values forAnimation:(AMCurvedAnimation *)animation {
+    
+    AMKeyframeCacheEntry *entry = [[AMKeyframeCacheEntry alloc] init];
+    entry->_key = [[AMKeyframeCacheKey alloc] initWithAnimation:animation];
+    entry->_keyTimes = [keyTimes copy];
+    entry->_values = [values copy];
+    
+    pthread_mutex_lock(&_lock);
+    
+    AMKeyframeCacheEntry *existing = _entries[entry->_key];
+    if (existing)
+        [self removeEntry:existing];
+    
+    _entries[entry->_key] = entry;
+    _totalCost += [entry->_keyTimes count];
+    [self linkEntryAtHead:entry];
+    
+    [self trimToCostLimit];
+    
+    pthread_mutex_unlock(&_lock);
+    
+}
+
+- (void)removeAllKeyframes {
+    
+    pthread_mutex_lock(&_lock);
+    
+    _head = _tail = nil;
+    _totalCost = 0;
+    [_entries removeAllObjects];
+    
+    pthread_mutex_unlock(&_lock);
+    
+}
+
+#pragma mark - Properties
+
+@synthesize costLimit=_costLimit;
+
+- (void)setCostLimit:(NSUInteger)costLimit {
+    
+    pthread_mutex_lock(&_lock);
+    
+    _costLimit = costLimit;
+    [self trimToCostLimit];
+    
+    pthread_mutex_unlock(&_lock);
+    
+}
+
+- (NSUInteger)costLimit {
+    
+    pthread_mutex_lock(&_lock);
+    NSUInteger costLimit = _costLimit;
+    pthread_mutex_unlock(&_lock);
+    
+    return costLimit;
+    
+}
+
+- (NSUInteger)count {
+    
+    pthread_mutex_lock(&_lock);
+    NSUInteger count = [_entries count];
+    pthread_mutex_unlock(&_lock);
+    
+    return count;
+    
+}
+
+- (NSUInteger)totalCost {
+    
+    pthread_mutex_lock(&_lock);
+    NSUInteger totalCost = _totalCost;
+    pthread_mutex_unlock(&_lock);
+    
+    return totalCost;
+    
+}
+
+#pragma mark - Statistics
+
+- (NSUInteger)hitCount {
+    
+    pthread_mutex_lock(&_lock);
+    NSUInteger hitCount = _hitCount;
+    pthread_mutex_unlock(&_lock);
+    
+    return hitCount;
+    
+}
+
+- (NSUInteger)missCount {
+    
+    pthread_mutex_lock(&_lock);
+    NSUInteger missCount = _missCount;
+    pthread_mutex_unlock(&_lock);
+    
+    return missCount;
+    
+}
+
+- (NSUInteger)evictionCount {
+    
+    pthread_mutex_lock(&_lock);
+    NSUInteger evictionCount = _evictionCount;
+    pthread_mutex_unlock(&_lock);
+    
+    return evictionCount;
+    
+}
+
+- (void)resetStatistics {
+    
+    pthread_mutex_lock(&_lock);
+    
+    _hitCount = _missCount = _evictionCount = 0;
+    
+    pthread_mutex_unlock(&_lock);
+    
+}
+
+@end
@@ -31,13 +31,19 @@
 @import QuartzCore;
 
 #import "AMAnimation.h"
+#import "AMAnimationRegistry.h"
+#import "AMColorKernels.h"
 
+@class AMCurve;
+@class AMMotionPath;
 @protocol AMInterpolatable;
 
 /*!
  The `AMLayerAnimation` provides animation on any animatable property of CALayer. Use this animation if you need to do custom animations on a layer that is not directly implemented in Animeteor as an explicit animation.
+ 
+ Seeking pauses the timing of the layer (`speed` and `timeOffset`) until the animation begins, is canceled or completes - so animations on the same layer are sought together. Only the first seek allocates. Seeking a completed animation sets the model value, which boxes it.
  */
-@interface AMLayerAnimation : NSObject <AMAnimation>
+@interface AMLayerAnimation : NSObject <AMRetargetableAnimation>
 
 /// ---------------------------
 /// @name Creating an Animation
@@ -53,7 +59,7 @@
  @param keyPath    The keyPath of the layer to animate.
  @param fromValue  Animates from this value. Providing `nil` will default to keyPaths current value on the layer.
  @param toValue    Animates to this value.
- @param duration   The duration of the animation.
+ @param duration   The duration of the animation. Providing zero with a spring curve will default to the settling duration of the spring.
  @param delay      The delay before the animation begins.
  @param curve      The curve of the animation. Providing `nil` will default to a linear curve.
  @param completion An optional completion block that gets called when the animation completes.
@@ -69,4 +75,93 @@
                                  curve:(AMCurve * _Nullable)curve
                             completion:(AMCompletionBlock _Nullable)completion;
 
+/*!
+ Returns an initialized layer animation object that moves the position of a layer along a motion path at constant speed.
+ 
+ @param layer      The layer to animate.
+ @param motionPath The path to move the position of the layer along.
+ @param duration   The duration of the animation. Providing zero with a spring curve will default to the settling duration of the spring.
+ @param delay      The delay of the animation.
+ @param curve      The curve of the animation - which moves the layer along the path. Providing `nil` will default to a linear curve.
+ @param completion An optional completion block that gets called when the animation completes.
+ 
+ @return An initialized layer animation object.
+ */
+- (instancetype _Nonnull)initWithLayer:(CALayer * _Nonnull)layer
+                            motionPath:(AMMotionPath * _Nonnull)motionPath
+                              duration:(NSTimeInterval)duration
+                                 delay:(NSTimeInterval)delay
+                                 curve:(AMCurve * _Nullable)curve
+                            completion:(AMCompletionBlock _Nullable)completion;
+
+/// -----------------------------------
+/// @name Getting Animation Information
+/// -----------------------------------
+
+/*!
+ Returns the key path being animated.
+ */
+@property (nonatomic,copy,readonly,nonnull) NSString *keyPath;
+
+/*!
+ Returns the curve of the animation.
+ */
+@property (nonatomic,copy,readonly,nonnull) AMCurve *curve;
+
+/*!
+ Returns the motion path of the animation, or `nil` if it animates between two values.
+ */
+@property (nonatomic,strong,readonly,nullable) AMMotionPath *motionPath;
+
+/// -------------------------
+/// @name Resolving Conflicts
+/// -------------------------
+
+/*!
+ Determines how the animation resolves a conflict with another animation of the same key path on the same layer. Default is `AMAnimationConflictPolicyReplace`.
+ 
+ @discussion The conflict is resolved when the animation takes effect - after its delay. See `AMAnimationRegistry`.
+ */
+@property (nonatomic) AMAnimationConflictPolicy conflictPolicy;
+
+/// -------------------------------
+/// @name Configuring Interpolation
+/// -------------------------------
+
+/*!
+ The color space in which `UIColor` and `CGColorRef` values are interpolated. Default is `AMColorSpaceSRGB`.
+ 
+ @discussion The endpoints are converted into the color space once as the animation begins - and keyframes are generated in it. Use `AMColorSpaceOKLab` for transitions that change lightness and hue evenly.
+ */
+@property (nonatomic) AMColorSpace colorSpace;
+
+/*!
+ An optional key path of the layer that is animated along with the position through the tangent angles of the motion path - in radians. Default is `nil`.
+ 
+ @discussion Use `transform.rotation.z` to turn the layer in the direction of motion. Ignored by animations without a motion path.
+ */
+@property (nonatomic,copy,nullable) NSString *rotationKeyPath;
+
+/// -----------------------
+/// @name Evaluating Values
+/// -----------------------
+
+/*!
+ Returns the value of the animation at a specific time. The animation does not need to be running.
+ 
+ @param time The time since the animation would begin - including its delay.
+ 
+ @return The interpolated value.
+ */
+- (id<AMInterpolatable> _Nonnull)valueAtTime:(NSTimeInterval)time;
+
+/*!
+ Returns the velocity of the animation at a specific time. The animation does not need to be running.
+ 
+ @param time The time since the animation would begin - including its delay.
+ 
+ @return The velocity in units of the value per second - or `nil` for values without a velocity (generic values and transforms).
+ */
+- (id<AMInterpolatable> _Nullable)velocityAtTime:(NSTimeInterval)time;
+
 @end
@@ -34,24 +34,52 @@
 
 #import "AMAnimation.h"
 #import "AMCurve.h"
+#import "AMSpringCurve.h"
 #import "AMCurvedAnimation.h"
 #import "AMInterpolatable.h"
+#import "AMInterpolator.h"
+#import "AMMotionPath.h"
+#import "AMInstrumentation.h"
+#import "AMAnimationRegistry.h"
+#import "AMAnimationGroup+Private.h"
 
 #import "AMLayerAnimation.h"
 
 #define ANIMATION_KEY_FOR_KEYPATH(x) [NSString stringWithFormat:@"layerAnimation.%@", x]
 
-const void *AMAnimationLayerKey;
-
 NSString *const AMLayerAnimationKey = @"AMAnimationKey";
 
-@interface AMLayerAnimation ()
+static const void *AMLayerSeekStateKey = &AMLayerSeekStateKey;
+
+/* The timing of a layer frozen while seeking - shared by all seeking animations of the layer. */
+@interface AMLayerSeekState : NSObject
+
+@property (nonatomic) float speed;
+@property (nonatomic) CFTimeInterval timeOffset;
+@property (nonatomic) CFTimeInterval origin;
+@property (nonatomic) NSUInteger count;
+
+@end
+
+@implementation AMLayerSeekState
+
+@end
+
+@interface AMLayerAnimation () {
+    /* Layer time at which the animations were attached - the time after the delay. */
+    CFTimeInterval _layerBeginTime;
+    AMLayerSeekState *_seekState;
+    NSTimeInterval _seekTime;
+    BOOL _seekAttached;
+}
 
 @property (weak,nonatomic) CALayer *layer;
 @property (nonatomic,copy) NSString *keyPath;
 @property (nonatomic,copy) id<AMInterpolatable> fromValue;
 @property (nonatomic,copy) id<AMInterpolatable> toValue;
 @property (copy,nonatomic) AMCurve *curve;
+@property (nonatomic) AMInterpolator *interpolator;
+@property (nonatomic) CFTimeInterval beginTime;
 
 @property (nonatomic,readwrite,getter = isAnimating) BOOL animating;
 @property (nonatomic,readwrite,getter = isComplete) BOOL complete;
@@ -80,13 +108,19 @@ NSString *const AMLayerAnimationKey = @"AMAnimationKey";
         _duration = duration;
         _delay = delay;
         _keyPath = keyPath;
-        _fromValue = [fromValue copyWithZone:nil];
-        _toValue = [toValue copyWithZone:nil];
+        _fromValue = AMInterpolatableCopy(fromValue);
+        _toValue = AMInterpolatableCopy(toValue);
         _curve = (curve ?: [AMCurve linear]);
         _completion = [completion copy];
         
-        /* Associate animation object with view, so it won't be released doing animation */
-        objc_setAssociatedObject(self.layer, &AMAnimationLayerKey, self, OBJC_ASSOCIATION_RETAIN_NONATOMIC);
+        AM_INSTRUMENT_CREATED(AMInstrumentationObjectLayerAnimation);
+        
+        /* Springs know their own duration. */
+        if (_duration <= 0.0 && [_curve isKindOfClass:[AMSpringCurve class]])
+            _duration = ((AMSpringCurve *)_curve).settlingDuration;
+        
+        /* Associate animation object with view, so it won't be released doing animation. Keyed by the animation itself, so animations on the same layer do not release each other. */
+        objc_setAssociatedObject(self.layer, (__bridge const void *)self, self, OBJC_ASSOCIATION_RETAIN_NONATOMIC);
         
         [self performSelector:@selector(beginAnimation)
                    withObject:nil
@@ -99,6 +133,36 @@ NSString *const AMLayerAnimationKey = @"AMAnimationKey";
     
 }
 
+- (instancetype)initWithLayer:(CALayer *)layer
+                   motionPath:(AMMotionPath *)motionPath
+                     duration:(NSTimeInterval)duration
+                        delay:(NSTimeInterval)delay
+                        curve:(AMCurve *)curve
+                   completion:(void (^)(BOOL finished))completion {
+    
+    if ((self = [self initWithLayer:layer
+                            keyPath:@"position"
+                          fromValue:[NSValue valueWithCGPoint:motionPath.startPoint]
+                            toValue:[NSValue valueWithCGPoint:motionPath.endPoint]
+                           duration:duration
+                              delay:delay
+                              curve:curve
+                         completion:completion])) {
+        
+        _motionPath = motionPath;
+        
+    }
+    
+    return self;
+    
+}
+
+- (void)dealloc {
+    
+    AM_INSTRUMENT_DESTROYED(AMInstrumentationObjectLayerAnimation);
+    
+}
+
 #pragma mark - Properties
 
 @synthesize duration=_duration;
@@ -112,6 +176,8 @@ NSString *const AMLayerAnimationKey = @"AMAnimationKey";
     
     _duration = duration;
     
+    AMAnimationGroupAnimationRetimed(self);
+    
 }
 
 - (void)setDelay:(NSTimeInterval)delay {
@@ -121,6 +187,35 @@ NSString *const AMLayerAnimationKey = @"AMAnimationKey";
     
     _delay = delay;
     
+    AMAnimationGroupAnimationRetimed(self);
+    
+}
+
+- (void)setConflictPolicy:(AMAnimationConflictPolicy)conflictPolicy {
+    
+    AMAssertMainThread();
+    AMAssertMutableState();
+    
+    _conflictPolicy = conflictPolicy;
+    
+}
+
+- (void)setColorSpace:(AMColorSpace)colorSpace {
+    
+    AMAssertMainThread();
+    AMAssertMutableState();
+    
+    _colorSpace = colorSpace;
+    
+}
+
+- (void)setRotationKeyPath:(NSString *)rotationKeyPath {
+    
+    AMAssertMainThread();
+    AMAssertMutableState();
+    
+    _rotationKeyPath = [rotationKeyPath copy];
+    
 }
 
 - (void)setCompletion:(AMCompletionBlock)completion {
@@ -164,6 +259,9 @@ NSString *const AMLayerAnimationKey = @"AMAnimationKey";
     AMAssertMainThread();
     AMAssertMutableState();
     
+    /* Animations not yet begun start over - running animations continue at the current time. */
+    [self endSeeking];
+    
     if (!self.isAnimating) {
         [NSObject cancelPreviousPerformRequestsWithTarget:self selector:@selector(beginAnimation) object:nil];
         
@@ -198,6 +296,13 @@ NSString *const AMLayerAnimationKey = @"AMAnimationKey";
         
         [self postponeAnimation];
         
+        /* The layer stays at the sought state. */
+        if (_seekState) {
+            CFTimeInterval time = _seekTime;
+            [self endSeeking];
+            [self setModelValuesAtTime:time];
+        }
+        
     } else if (self.isAnimating && !self.isComplete) {
         
         // We need to determine if we are on a delay or on actually animating.
@@ -211,7 +316,18 @@ NSString *const AMLayerAnimationKey = @"AMAnimationKey";
             
         } else { // Animation is in progress.
             
-            [self.layer setValue:[self.layer.presentationLayer valueForKeyPath:self.keyPath]
+            /* A seeking animation is left at the time it was sought to. */
+            NSTimeInterval time = [self presentationTime];
+            [self endSeeking];
+            
+            // The presented value is evaluated from the curve - instead of reading it back from the presentation layer.
+            if ([self rotates]) {
+                [self.layer setValue:[self rotationAtTime:time]
+                          forKeyPath:self.rotationKeyPath];
+                [self.layer removeAnimationForKey:ANIMATION_KEY_FOR_KEYPATH(self.rotationKeyPath)];
+            }
+            
+            [self.layer setValue:[self valueAtTime:time]
                       forKeyPath:self.keyPath];
             [self.layer removeAnimationForKey:ANIMATION_KEY_FOR_KEYPATH(self.keyPath)];
             
@@ -228,13 +344,14 @@ NSString *const AMLayerAnimationKey = @"AMAnimationKey";
 
 - (void)animationStarted {
     
-    [self.layer setValue:[_fromValue interpolateWithValue:_toValue
-                                               atPosition:[self.curve transform:1.0]]
+    [self.layer setValue:[self.interpolator valueAtPosition:[self.curve transform:1.0]]
               forKeyPath:_keyPath];
     
 }
 
 - (void)animationCompleted:(BOOL)finished {
+    
+    [self endSeeking];
 
     if (self.completion)
         self.completion(finished);
@@ -242,23 +359,307 @@ NSString *const AMLayerAnimationKey = @"AMAnimationKey";
     self.complete = YES;
     self.finished = finished;
     
+    AMAnimationGroupAnimationCompleted(self, finished);
+    
+    [AMAnimationRegistry unregisterAnimation:self forTarget:self.layer keyPath:_keyPath];
+    
     /* Remove animation from view so it can be released */
-    objc_setAssociatedObject(self.layer, &AMAnimationLayerKey, nil, OBJC_ASSOCIATION_RETAIN_NONATOMIC);
+    objc_setAssociatedObject(self.layer, (__bridge const void *)self, nil, OBJC_ASSOCIATION_RETAIN_NONATOMIC);
     
 }
 
 - (void)setupAnimations {
     
-    AMCurvedAnimation *customAnimation = [AMCurvedAnimation animationWithKeyPath:_keyPath];
-    customAnimation.fromValue = _fromValue;
-    customAnimation.toValue = _toValue;
+    /* The presented value and velocity must be read before the current animation is cancelled. */
+    id<AMInterpolatable> presentationValue = nil;
+    id<AMInterpolatable> presentationVelocity = nil;
     
-    [self.layer setValue:[_fromValue interpolateWithValue:_toValue
-                                               atPosition:[self.curve transform:1.0]]
+    if (self.conflictPolicy == AMAnimationConflictPolicyRetarget) {
+        id current = [AMAnimationRegistry animationForTarget:self.layer keyPath:_keyPath];
+        if ([current conformsToProtocol:@protocol(AMRetargetableAnimation)]) {
+            presentationValue = [current presentationValue];
+            presentationVelocity = [current presentationVelocity];
+        }
+    }
+    
+    /* Conflicts are resolved as the animation takes effect. */
+    id<AMAnimation> previous = [AMAnimationRegistry registerAnimation:self forTarget:self.layer keyPath:_keyPath];
+    
+    id<AMInterpolatable> initialVelocity = nil;
+    
+    /* The cancelled animation left the layer at its presented value - motion paths begin where the path begins. */
+    if (previous && self.conflictPolicy != AMAnimationConflictPolicyReplace && !self.motionPath)
+        _fromValue = presentationValue ?: [self.layer valueForKeyPath:_keyPath];
+    
+    /* The value type is resolved - and colors converted - once for the model value and presenting. */
+    self.interpolator = [self createInterpolator];
+    
+    if (previous && presentationVelocity && [self.interpolator setInitialVelocity:presentationVelocity slope:[self.curve derivative:0.0] duration:self.duration])
+        initialVelocity = presentationVelocity;
+    
+    AMCurvedAnimation *customAnimation = [self createAnimationWithInitialVelocity:initialVelocity];
+    
+    [self.layer setValue:[self.interpolator valueAtPosition:[self.curve transform:1.0]]
               forKeyPath:_keyPath];
     
+    /* An explicit begin time in the time of the layer - which seeking a running animation maps from. */
+    _layerBeginTime = [self.layer convertTime:CACurrentMediaTime() fromLayer:nil];
+    
+    /* The rotation follows along - completion is reported by the animation of the position alone. */
+    if ([self rotates]) {
+        
+        AMCurvedAnimation *rotationAnimation = [self createRotationAnimation];
+        rotationAnimation.beginTime = _layerBeginTime;
+        
+        [self.layer setValue:[self rotationAtTime:self.delay + self.duration]
+                  forKeyPath:self.rotationKeyPath];
+        [self.layer addAnimation:rotationAnimation forKey:ANIMATION_KEY_FOR_KEYPATH(self.rotationKeyPath)];
+        
+    }
+    
+    customAnimation.beginTime = _layerBeginTime;
+    
     [self prepareAnimation:customAnimation usingKey:ANIMATION_KEY_FOR_KEYPATH(_keyPath)];
     
+    self.beginTime = CACurrentMediaTime();
+    
+}
+
+#pragma mark - Interpolating
+
+- (AMInterpolator *)createInterpolator {
+    
+    if (self.motionPath)
+        return [[AMInterpolator alloc] initWithMotionPath:self.motionPath];
+    
+    return [[AMInterpolator alloc] initWithFromValue:_fromValue toValue:_toValue colorSpace:self.colorSpace];
+    
+}
+
+- (AMCurvedAnimation *)createAnimationWithInitialVelocity:(id<AMInterpolatable>)initialVelocity {
+    
+    AMCurvedAnimation *animation = [AMCurvedAnimation animationWithKeyPath:_keyPath];
+    animation.fromValue = _fromValue;
+    animation.toValue = _toValue;
+    animation.initialVelocity = initialVelocity;
+    animation.colorSpace = self.colorSpace;
+    
+    if (self.motionPath)
+        animation.interpolator = self.interpolator;
+    
+    return animation;
+    
+}
+
+- (AMCurvedAnimation *)createRotationAnimation {
+    
+    AMCurvedAnimation *animation = [AMCurvedAnimation animationWithKeyPath:self.rotationKeyPath];
+    animation.interpolator = [[AMInterpolator alloc] initWithAnglesOfMotionPath:self.motionPath];
+    animation.duration = self.duration;
+    animation.curve = self.curve;
+    
+    return animation;
+    
+}
+
+- (BOOL)rotates {
+    
+    return (self.motionPath && self.rotationKeyPath);
+    
+}
+
+- (NSNumber *)rotationAtTime:(NSTimeInterval)time {
+    
+    return @([self.motionPath angleAtPosition:[self.curve transform:[self progressAtTime:time]]]);
+    
+}
+
+#pragma mark - Seeking
+
+- (double)progressAtTime:(NSTimeInterval)time {
+    
+    if (!self.interpolator) {
+        _fromValue = _fromValue ?: [_layer valueForKeyPath:_keyPath];
+        _curve = _curve ?: [AMCurve linear];
+        self.interpolator = [self createInterpolator];
+    }
+    
+    return (self.duration > 0.0 ? MIN(MAX((time - self.delay) / self.duration, 0.0), 1.0) : (time >= self.delay ? 1.0 : 0.0));
+    
+}
+
+- (void)seekToTime:(NSTimeInterval)time {
+    
+    AMAssertMainThread();
+    
+    CALayer *layer = self.layer;
+    if (!layer)
+        return;
+    
+    /* Completed animations have nothing attached to present - the model value is set instead. */
+    if (self.isComplete) {
+        [self setModelValuesAtTime:time];
+        return;
+    }
+    
+    if (!_seekState)
+        [self beginSeeking];
+    
+    _seekTime = time;
+    
+    /* The layer is frozen - so its time is the time offset alone. */
+    layer.timeOffset = _seekState.origin + time;
+    
+}
+
+- (void)beginSeeking {
+    
+    CALayer *layer = self.layer;
+    BOOL presenting = [self isPresenting];
+    
+    /* Time zero of seeking is where the animation would begin - including its delay. */
+    CFTimeInterval origin = (presenting ? _layerBeginTime - self.delay : [layer convertTime:CACurrentMediaTime() fromLayer:nil]);
+    
+    _seekState = objc_getAssociatedObject(layer, AMLayerSeekStateKey);
+    
+    if (!_seekState) {
+        _seekState = [AMLayerSeekState new];
+        _seekState.speed = layer.speed;
+        _seekState.timeOffset = layer.timeOffset;
+        _seekState.origin = origin;
+        layer.speed = 0.0;
+        objc_setAssociatedObject(layer, AMLayerSeekStateKey, _seekState, OBJC_ASSOCIATION_RETAIN_NONATOMIC);
+    }
+    
+    _seekState.count++;
+    
+    if (presenting)
+        return;
+    
+    /* An animation in its delay is paused - and begins over when asked to. */
+    [NSObject cancelPreviousPerformRequestsWithTarget:self selector:@selector(beginAnimation) object:nil];
+    [NSObject cancelPreviousPerformRequestsWithTarget:self selector:@selector(setupAnimations) object:nil];
+    self.animating = NO;
+    
+    [self progressAtTime:0.0];
+    
+    /* The animations are attached without a delegate - and hold their values outside their duration. */
+    CFTimeInterval beginTime = _seekState.origin + self.delay;
+    
+    AMCurvedAnimation *animation = [self createAnimationWithInitialVelocity:nil];
+    animation.duration = self.duration;
+    animation.curve = self.curve;
+    animation.beginTime = beginTime;
+    animation.fillMode = kCAFillModeBoth;
+    animation.removedOnCompletion = NO;
+    [layer addAnimation:animation forKey:ANIMATION_KEY_FOR_KEYPATH(_keyPath)];
+    
+    if ([self rotates]) {
+        AMCurvedAnimation *rotationAnimation = [self createRotationAnimation];
+        rotationAnimation.beginTime = beginTime;
+        rotationAnimation.fillMode = kCAFillModeBoth;
+        rotationAnimation.removedOnCompletion = NO;
+        [layer addAnimation:rotationAnimation forKey:ANIMATION_KEY_FOR_KEYPATH(self.rotationKeyPath)];
+    }
+    
+    _seekAttached = YES;
+    
+}
+
+- (void)endSeeking {
+    
+    if (!_seekState)
+        return;
+    
+    CALayer *layer = self.layer;
+    
+    if (_seekAttached) {
+        [layer removeAnimationForKey:ANIMATION_KEY_FOR_KEYPATH(_keyPath)];
+        if ([self rotates])
+            [layer removeAnimationForKey:ANIMATION_KEY_FOR_KEYPATH(self.rotationKeyPath)];
+        _seekAttached = NO;
+    }
+    
+    /* The last seeking animation of the layer restores its timing. */
+    if (--_seekState.count == 0) {
+        layer.speed = _seekState.speed;
+        layer.timeOffset = _seekState.timeOffset;
+        objc_setAssociatedObject(layer, AMLayerSeekStateKey, nil, OBJC_ASSOCIATION_RETAIN_NONATOMIC);
+    }
+    
+    _seekState = nil;
+    
+}
+
+- (void)setModelValuesAtTime:(NSTimeInterval)time {
+    
+    /* Set the model value without the implicit animation. */
+    [CATransaction begin];
+    [CATransaction setDisableActions:YES];
+    [self.layer setValue:[self valueAtTime:time] forKeyPath:_keyPath];
+    if ([self rotates])
+        [self.layer setValue:[self rotationAtTime:time] forKeyPath:self.rotationKeyPath];
+    [CATransaction commit];
+    
+}
+
+- (id<AMInterpolatable>)valueAtTime:(NSTimeInterval)time {
+    
+    AMAssertMainThread();
+    
+    double progress = [self progressAtTime:time];
+    
+    return [self.interpolator valueAtPosition:[self.curve transform:progress] progress:progress];
+    
+}
+
+- (id<AMInterpolatable>)velocityAtTime:(NSTimeInterval)time {
+    
+    AMAssertMainThread();
+    
+    double progress = [self progressAtTime:time];
+    
+    return [self.interpolator velocityAtProgress:progress slope:[self.curve derivative:progress] duration:self.duration];
+    
+}
+
+#pragma mark - Retargeting
+
+- (BOOL)isPresenting {
+    
+    return (self.isAnimating && !self.isComplete && [self.layer animationForKey:ANIMATION_KEY_FOR_KEYPATH(_keyPath)]);
+    
+}
+
+- (NSTimeInterval)presentationTime {
+    
+    if (_seekState)
+        return _seekTime;
+    
+    return CACurrentMediaTime() - self.beginTime + self.delay;
+    
+}
+
+- (id<AMInterpolatable>)presentationValue {
+    
+    AMAssertMainThread();
+    
+    if (![self isPresenting])
+        return nil;
+    
+    return [self valueAtTime:[self presentationTime]];
+    
+}
+
+- (id<AMInterpolatable>)presentationVelocity {
+    
+    AMAssertMainThread();
+    
+    if (![self isPresenting])
+        return nil;
+    
+    return [self velocityAtTime:[self presentationTime]];
+    
 }
 
 @end
@@ -0,0 +1,133 @@
+//
+//  AMMotionPath.h
+//  Animeteor
+//
+//  Copyright (c) 2013-2015, Kristian Trenskow
+//  All rights reserved.
+//  
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are met:
+//  
+//  1. Redistributions of source code must retain the above copyright notice,
+//  this list of conditions and the following disclaimer.
+//  
+//  2. Redistributions in binary form must reproduce the above copyright notice,
+//  this list of conditions and the following disclaimer in the documentation
+//  and/or other materials provided with the distribution.
+//  
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+//  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+//  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+//  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+//  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+//  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+//  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+//  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+//  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+//  POSSIBILITY OF SUCH DAMAGE.
+//
+
+@import QuartzCore;
+
+/*!
+ The `AMMotionPath` class flattens a path into line segments, and precomputes a table of their arc lengths at creation. Positions along a motion path are fractions of its length - so an animation moves along the path at constant speed, and only the curve of the animation changes the speed.
+ 
+ Looking up a position indexes directly into a uniform table of arc lengths, followed by a short scan - so the cost is constant no matter how many segments the path has. Positions below zero and above one (as produced by curves that overshoot) extrapolate along the first and last segment.
+ */
+@interface AMMotionPath : NSObject
+
+/// ----------------------------
+/// @name Creating a Motion Path
+/// ----------------------------
+
++ (instancetype _Nullable)new UNAVAILABLE_ATTRIBUTE;
+- (instancetype _Nullable)init UNAVAILABLE_ATTRIBUTE;
+
+/*!
+ Returns an initialized motion path with a flatness of 0.1 points.
+ 
+ @param path The path to move along.
+ 
+ @return An initialized motion path.
+ */
+- (instancetype _Nonnull)initWithPath:(CGPathRef _Nonnull)path;
+
+/*!
+ Returns an initialized motion path.
+ 
+ @param path     The path to move along. Subpaths are joined - moving to the beginning of a subpath is a jump.
+ @param flatness The maximum distance between a curve of the path and the line segments replacing it.
+ 
+ @return An initialized motion path.
+ */
+- (instancetype _Nonnull)initWithPath:(CGPathRef _Nonnull)path flatness:(CGFloat)flatness;
+
+/*!
+ Returns an initialized motion path along a polyline.
+ 
+ @param points The points of the polyline.
+ @param count  The number of points.
+ 
+ @return An initialized motion path.
+ */
+- (instancetype _Nonnull)initWithPoints:(const CGPoint * _Nonnull)points count:(NSUInteger)count;
+
+/// -------------------------------------
+/// @name Getting Motion Path Information
+/// -------------------------------------
+
+/*!
+ Returns the length of the path.
+ */
+@property (nonatomic,readonly) double length;
+
+/*!
+ Returns the number of line segments the path was flattened into.
+ */
+@property (nonatomic,readonly) NSUInteger segmentCount;
+
+/*!
+ Returns the point at position zero.
+ */
+@property (nonatomic,readonly) CGPoint startPoint;
+
+/*!
+ Returns the point at position one.
+ */
+@property (nonatomic,readonly) CGPoint endPoint;
+
+/// --------------------------
+/// @name Looking Up Positions
+/// --------------------------
+
+/*!
+ Returns the point at a position.
+ 
+ @param position The fraction of the length of the path.
+ 
+ @return The point at the position.
+ */
+- (CGPoint)pointAtPosition:(double)position;
+
+/*!
+ Returns the unit tangent at a position - the direction of motion.
+ 
+ @param position The fraction of the length of the path.
+ 
+ @return The direction of the segment at the position.
+ */
+- (CGVector)tangentAtPosition:(double)position;
+
+/*!
+ Returns the angle of the tangent at a position - in radians.
+ 
+ @param position The fraction of the length of the path.
+ 
+ @discussion Angles are continuous along the path - they do not wrap around at pi - so rotations animated by them never turn the long way round. Angles blend between the middles of neighbouring segments, so the rotation does not jump at the corners of a flattened curve.
+ 
+ @return The angle of the tangent at the position.
+ */
+- (double)angleAtPosition:(double)position;
+
+@end
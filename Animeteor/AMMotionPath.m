@@ -0,0 +1,400 @@
+//
+//  AMMotionPath.m
+//  Animeteor
+//
+//  Copyright (c) 2013-2015, Kristian Trenskow
+//  All rights reserved.
+//  
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are met:
+//  
+//  1. Redistributions of source code must retain the above copyright notice,
+//  this list of conditions and the following disclaimer.
+//  
+//  2. Redistributions in binary form must reproduce the above copyright notice,
+//  this list of conditions and the following disclaimer in the documentation
+//  and/or other materials provided with the distribution.
+//  
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+//  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+//  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+//  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+//  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+//  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+//  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+//  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+//  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+//  POSSIBILITY OF SUCH DAMAGE.
+//
+
+#import "AMMotionPath.h"
+
+// Flatness of motion paths created without one - in points.
+#define DEFAULT_FLATNESS .1
+// Number of intervals of the uniform arc length table per segment.
+#define INTERVALS_PER_SEGMENT 2
+// Maximum number of line segments replacing a single curve.
+#define MAX_CURVE_SEGMENTS 1024
+
+/* Points collected while flattening a path. A move is marked, so the segment leading to it is a jump of zero length. */
+typedef struct {
+    double *points;
+    BOOL *jumps;
+    NSUInteger count;
+    NSUInteger capacity;
+    double subpathStart[2];
+    BOOL moved;
+    double flatness;
+} AMMotionPathBuilder;
+
+static void AMMotionPathBuilderAppend(AMMotionPathBuilder *builder, double x, double y, BOOL jump) {
+    
+    if (builder->count == builder->capacity) {
+        
+        NSUInteger capacity = MAX(builder->capacity * 2, (NSUInteger)16);
+        double *points = realloc(builder->points, sizeof(double) * 2 * capacity);
+        if (points)
+            builder->points = points;
+        BOOL *jumps = realloc(builder->jumps, sizeof(BOOL) * capacity);
+        if (jumps)
+            builder->jumps = jumps;
+        
+        /* Points that do not fit are dropped - so the path ends early. */
+        if (!points || !jumps)
+            return;
+        
+        builder->capacity = capacity;
+        
+    }
+    
+    builder->points[builder->count * 2] = x;
+    builder->points[builder->count * 2 + 1] = y;
+    builder->jumps[builder->count] = (jump && builder->count > 0);
+    builder->count++;
+    builder->moved = jump;
+    
+}
+
+static void AMMotionPathBuilderAdd(AMMotionPathBuilder *builder, double x, double y, BOOL jump) {
+    
+    /* Consecutive moves replace each other - and repeated points add nothing. */
+    if (builder->count > 0) {
+        double *last = builder->points + (builder->count - 1) * 2;
+        if (jump && builder->moved) {
+            last[0] = x;
+            last[1] = y;
+            return;
+        }
+        if (!jump && last[0] == x && last[1] == y)
+            return;
+    }
+    
+    AMMotionPathBuilderAppend(builder, x, y, jump);
+    
+}
+
+static NSUInteger AMMotionPathBuilderCurveSegments(AMMotionPathBuilder *builder, double secondDifference, double factor) {
+    
+    /* A curve replaced by n chords deviates at most `factor * |second difference| / n^2` from them. */
+    double segments = ceil(sqrt(factor * secondDifference / builder->flatness));
+    
+    return (NSUInteger)MIN(MAX(segments, 1.0), (double)MAX_CURVE_SEGMENTS);
+    
+}
+
+static void AMMotionPathBuilderApply(void *info, const CGPathElement *element) {
+    
+    AMMotionPathBuilder *builder = info;
+    const CGPoint *points = element->points;
+    
+    double x0 = (builder->count > 0 ? builder->points[(builder->count - 1) * 2] : .0);
+    double y0 = (builder->count > 0 ? builder->points[(builder->count - 1) * 2 + 1] : .0);
+    
+    switch (element->type) {
+        case kCGPathElementMoveToPoint:
+            builder->subpathStart[0] = points[0].x;
+            builder->subpathStart[1] = points[0].y;
+            AMMotionPathBuilderAdd(builder, points[0].x, points[0].y, YES);
+            break;
+        case kCGPathElementAddLineToPoint:
+            AMMotionPathBuilderAdd(builder, points[0].x, points[0].y, NO);
+            break;
+        case kCGPathElementAddQuadCurveToPoint: {
+            double dx = x0 - 2.0 * points[0].x + points[1].x;
+            double dy = y0 - 2.0 * points[0].y + points[1].y;
+            NSUInteger segments = AMMotionPathBuilderCurveSegments(builder, sqrt(dx * dx + dy * dy), .25);
+            for (NSUInteger idx = 1 ; idx <= segments ; idx++) {
+                double t = (double)idx / segments;
+                double mt = 1.0 - t;
+                AMMotionPathBuilderAdd(builder,
+                                       mt * mt * x0 + 2.0 * mt * t * points[0].x + t * t * points[1].x,
+                                       mt * mt * y0 + 2.0 * mt * t * points[0].y + t * t * points[1].y,
+                                       NO);
+            }
+            break;
+        }
+        case kCGPathElementAddCurveToPoint: {
+            double dx1 = x0 - 2.0 * points[0].x + points[1].x;
+            double dy1 = y0 - 2.0 * points[0].y + points[1].y;
+            double dx2 = points[0].x - 2.0 * points[1].x + points[2].x;
+            double dy2 = points[0].y - 2.0 * points[1].y + points[2].y;
+            double secondDifference = MAX(sqrt(dx1 * dx1 + dy1 * dy1), sqrt(dx2 * dx2 + dy2 * dy2));
+            NSUInteger segments = AMMotionPathBuilderCurveSegments(builder, secondDifference, .75);
+            for (NSUInteger idx = 1 ; idx <= segments ; idx++) {
+                double t = (double)idx / segments;
+                double mt = 1.0 - t;
+                AMMotionPathBuilderAdd(builder,
+                                       mt * mt * mt * x0 + 3.0 * mt * mt * t * points[0].x + 3.0 * mt * t * t * points[1].x + t * t * t * points[2].x,
+                                       mt * mt * mt * y0 + 3.0 * mt * mt * t * points[0].y + 3.0 * mt * t * t * points[1].y + t * t * t * points[2].y,
+                                       NO);
+            }
+            break;
+        }
+        case kCGPathElementCloseSubpath:
+            AMMotionPathBuilderAdd(builder, builder->subpathStart[0], builder->subpathStart[1], NO);
+            break;
+    }
+    
+}
+
+@interface AMMotionPath () {
+    /* Points as x and y pairs - the arc length at every point - and the angle of every segment. */
+    double *_points;
+    double *_lengths;
+    double *_angles;
+    /* The segment at the beginning of every interval of the uniform table. */
+    NSUInteger *_index;
+    NSUInteger _intervals;
+    /* Tables of a straight line between the ends - used when the tables cannot be allocated. */
+    double _linePoints[4];
+    double _lineLengths[2];
+    double _lineAngles[1];
+    NSUInteger _lineIndex[INTERVALS_PER_SEGMENT];
+}
+
+@end
+
+@implementation AMMotionPath
+
+#pragma mark - Setup / Teardown
+
+- (instancetype)initWithPath:(CGPathRef)path {
+    
+    return [self initWithPath:path flatness:DEFAULT_FLATNESS];
+    
+}
+
+- (instancetype)initWithPath:(CGPathRef)path flatness:(CGFloat)flatness {
+    
+    AMMotionPathBuilder builder;
+    memset(&builder, 0, sizeof(builder));
+    builder.flatness = MAX(flatness, 1e-3);
+    
+    CGPathApply(path, &builder, AMMotionPathBuilderApply);
+    
+    /* A move at the end leads nowhere. */
+    if (builder.moved && builder.count > 1)
+        builder.count--;
+    
+    self = [self initWithBuilder:&builder];
+    
+    free(builder.points);
+    free(builder.jumps);
+    
+    return self;
+    
+}
+
+- (instancetype)initWithPoints:(const CGPoint *)points count:(NSUInteger)count {
+    
+    AMMotionPathBuilder builder;
+    memset(&builder, 0, sizeof(builder));
+    
+    for (NSUInteger idx = 0 ; idx < count ; idx++)
+        AMMotionPathBuilderAdd(&builder, points[idx].x, points[idx].y, idx == 0);
+    
+    self = [self initWithBuilder:&builder];
+    
+    free(builder.points);
+    free(builder.jumps);
+    
+    return self;
+    
+}
+
+- (instancetype)initWithBuilder:(AMMotionPathBuilder *)builder {
+    
+    if ((self = [super init])) {
+        
+        /* Empty paths stay at the origin. */
+        if (builder->count == 0)
+            AMMotionPathBuilderAdd(builder, .0, .0, YES);
+        
+        /* A single point is a segment of zero length. */
+        if (builder->count == 1)
+            AMMotionPathBuilderAppend(builder, builder->points[0], builder->points[1], NO);
+        
+        NSUInteger count = builder->count;
+        const BOOL *jumps = builder->jumps;
+        _segmentCount = (count > 1 ? count - 1 : 1);
+        _intervals = _segmentCount * INTERVALS_PER_SEGMENT;
+        
+        if (count > 1) {
+            _points = malloc(sizeof(double) * 2 * count);
+            _lengths = malloc(sizeof(double) * count);
+            _angles = malloc(sizeof(double) * _segmentCount);
+            _index = malloc(sizeof(NSUInteger) * _intervals);
+        }
+        
+        if (_points && _lengths && _angles && _index)
+            memcpy(_points, builder->points, sizeof(double) * 2 * count);
+        else {
+            
+            free(_points);
+            free(_lengths);
+            free(_angles);
+            free(_index);
+            
+            /* Without memory for the tables the path is a straight line between its ends. */
+            static const BOOL lineJumps[2] = { NO, NO };
+            
+            _points = _linePoints;
+            _lengths = _lineLengths;
+            _angles = _lineAngles;
+            _index = _lineIndex;
+            
+            memset(_points, 0, sizeof(double) * 4);
+            if (count > 0) {
+                memcpy(_points, builder->points, sizeof(double) * 2);
+                memcpy(_points + 2, builder->points + (count - 1) * 2, sizeof(double) * 2);
+            }
+            
+            count = 2;
+            jumps = lineJumps;
+            _segmentCount = 1;
+            _intervals = INTERVALS_PER_SEGMENT;
+            
+        }
+        
+        _lengths[0] = .0;
+        
+        for (NSUInteger idx = 0 ; idx < _segmentCount ; idx++) {
+            
+            double dx = _points[idx * 2 + 2] - _points[idx * 2];
+            double dy = _points[idx * 2 + 3] - _points[idx * 2 + 1];
+            double length = (jumps[idx + 1] ? .0 : sqrt(dx * dx + dy * dy));
+            
+            _lengths[idx + 1] = _lengths[idx] + length;
+            
+            /* Angles are unwrapped against the previous segment - jumps keep the previous angle. */
+            double previous = (idx > 0 ? _angles[idx - 1] : .0);
+            double angle = (length > .0 ? atan2(dy, dx) : previous);
+            
+            _angles[idx] = previous + remainder(angle - previous, 2.0 * M_PI);
+            
+        }
+        
+        _length = _lengths[_segmentCount];
+        _startPoint = CGPointMake(_points[0], _points[1]);
+        _endPoint = CGPointMake(_points[_segmentCount * 2], _points[_segmentCount * 2 + 1]);
+        
+        /* Leading segments of zero length take the angle of the first segment with a length. */
+        NSUInteger first = 0;
+        while (first < _segmentCount && _lengths[first + 1] == _lengths[first])
+            first++;
+        for (NSUInteger idx = 0 ; idx < first && first < _segmentCount ; idx++)
+            _angles[idx] = _angles[first];
+        
+        NSUInteger segment = 0;
+        for (NSUInteger interval = 0 ; interval < _intervals ; interval++) {
+            double length = _length * interval / _intervals;
+            while (segment + 1 < _segmentCount && _lengths[segment + 1] <= length)
+                segment++;
+            _index[interval] = segment;
+        }
+        
+    }
+    
+    return self;
+    
+}
+
+- (void)dealloc {
+    
+    if (_points != _linePoints) {
+        free(_points);
+        free(_lengths);
+        free(_angles);
+        free(_index);
+    }
+    
+}
+
+#pragma mark - Private Methods
+
+- (NSUInteger)segmentAtLength:(double)length {
+    
+    if (length <= .0 || _length <= .0)
+        return 0;
+    
+    NSUInteger interval = MIN((NSUInteger)(length / _length * _intervals), _intervals - 1);
+    NSUInteger segment = _index[interval];
+    
+    while (segment + 1 < _segmentCount && _lengths[segment + 1] <= length)
+        segment++;
+    
+    return segment;
+    
+}
+
+#pragma mark - Looking Up Positions
+
+- (CGPoint)pointAtPosition:(double)position {
+    
+    double length = position * _length;
+    NSUInteger segment = [self segmentAtLength:length];
+    
+    double segmentLength = _lengths[segment + 1] - _lengths[segment];
+    if (segmentLength <= .0)
+        return CGPointMake(_points[segment * 2 + 2], _points[segment * 2 + 3]);
+    
+    /* Positions outside the path extrapolate along the first and last segment. */
+    double f = (length - _lengths[segment]) / segmentLength;
+    const double *p = _points + segment * 2;
+    
+    return CGPointMake(p[0] + (p[2] - p[0]) * f, p[1] + (p[3] - p[1]) * f);
+    
+}
+
+- (CGVector)tangentAtPosition:(double)position {
+    
+    double angle = _angles[[self segmentAtLength:position * _length]];
+    
+    return CGVectorMake(cos(angle), sin(angle));
+    
+}
+
+- (double)angleAtPosition:(double)position {
+    
+    double length = position * _length;
+    NSUInteger segment = [self segmentAtLength:length];
+    
+    /* Blend towards the neighbouring segment on the nearest side. */
+    double middle = (_lengths[segment] + _lengths[segment + 1]) * .5;
+    NSUInteger neighbour = (length < middle ? (segment > 0 ? segment - 1 : segment) : MIN(segment + 1, _segmentCount - 1));
+    
+    if (neighbour == segment)
+        return _angles[segment];
+    
+    double neighbourMiddle = (_lengths[neighbour] + _lengths[neighbour + 1]) * .5;
+    if (neighbourMiddle == middle)
+        return _angles[segment];
+    
+    double f = (length - middle) / (neighbourMiddle - middle);
+    
+    return _angles[segment] + (_angles[neighbour] - _angles[segment]) * f;
+    
+}
+
+@end
@@ -0,0 +1,146 @@
+//
+//  AMNumericBuffer.h
+//  Animeteor
+//
+//  Copyright (c) 2013-2015, Kristian Trenskow
+//  All rights reserved.
+//  
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are met:
+//  
+//  1. Redistributions of source code must retain the above copyright notice,
+//  this list of conditions and the following disclaimer.
+//  
+//  2. Redistributions in binary form must reproduce the above copyright notice,
+//  this list of conditions and the following disclaimer in the documentation
+//  and/or other materials provided with the distribution.
+//  
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+//  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+//  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+//  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+//  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+//  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+//  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+//  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+//  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+//  POSSIBILITY OF SUCH DAMAGE.
+//
+
+@import Foundation;
+
+#import "AMInterpolatable.h"
+
+/*!
+ The types of elements a numeric buffer can hold.
+ */
+typedef NS_ENUM(NSUInteger, AMNumericBufferType) {
+    /*! Elements are `float`. */
+    AMNumericBufferTypeFloat = 0,
+    /*! Elements are `double`. */
+    AMNumericBufferTypeDouble
+};
+
+/*!
+ The `AMNumericBuffer` class holds a packed buffer of floats or doubles - like vertices, gradient stops, equalizer bands or the points of a chart series - that is animated as a single value.
+ 
+ Buffers interpolate element by element in SIMD lanes. `interpolateFromBuffer:toBuffer:atPosition:` writes into the receiver in place - so a buffer allocated once can receive every frame of an animation. Direct animations of buffers do exactly that - and write the same buffer to the object on every frame. Buffers are animated by direct animations only - as Core Animation cannot interpolate them.
+ */
+@interface AMNumericBuffer : NSObject <AMInterpolatable>
+
+/// ----------------------
+/// @name Creating Buffers
+/// ----------------------
+
++ (instancetype _Nullable)new UNAVAILABLE_ATTRIBUTE;
+- (instancetype _Nullable)init UNAVAILABLE_ATTRIBUTE;
+
+/*!
+ Returns an initialized buffer with all elements zero.
+ 
+ @param type  The type of the elements.
+ @param count The number of elements.
+ 
+ @return An initialized buffer.
+ */
+- (instancetype _Nonnull)initWithType:(AMNumericBufferType)type count:(NSUInteger)count;
+
+/*!
+ Returns an initialized buffer with a copy of a number of floats.
+ 
+ @param floats The elements to copy.
+ @param count  The number of elements.
+ 
+ @return An initialized buffer of the float type.
+ */
+- (instancetype _Nonnull)initWithFloats:(const float * _Nonnull)floats count:(NSUInteger)count;
+
+/*!
+ Returns an initialized buffer with a copy of a number of doubles.
+ 
+ @param doubles The elements to copy.
+ @param count   The number of elements.
+ 
+ @return An initialized buffer of the double type.
+ */
+- (instancetype _Nonnull)initWithDoubles:(const double * _Nonnull)doubles count:(NSUInteger)count;
+
+/// --------------------------------
+/// @name Getting Buffer Information
+/// --------------------------------
+
+/*!
+ Returns the type of the elements.
+ */
+@property (nonatomic,readonly) AMNumericBufferType type;
+
+/*!
+ Returns the number of elements.
+ */
+@property (nonatomic,readonly) NSUInteger count;
+
+/*!
+ Returns the size in bytes of an element.
+ */
+@property (nonatomic,readonly) size_t elementSize;
+
+/*!
+ Returns the elements - `count` floats or doubles, as given by `type`.
+ */
+@property (nonatomic,readonly,nonnull) const void *bytes;
+
+/*!
+ Returns the elements for writing.
+ 
+ @discussion The elements are owned by the buffer - and valid for as long as the buffer is.
+ */
+@property (nonatomic,readonly,nonnull) void *mutableBytes;
+
+/*!
+ Returns a Boolean value indicating whether the buffer holds as many elements of the same type as another buffer.
+ 
+ @param buffer The buffer to compare with.
+ 
+ @return `YES` if the buffers are of the same type and count.
+ */
+- (BOOL)isCompatibleWithBuffer:(AMNumericBuffer * _Nonnull)buffer;
+
+/// -------------------
+/// @name Interpolating
+/// -------------------
+
+/*!
+ Writes the interpolation between two buffers into the receiver.
+ 
+ @param fromBuffer The buffer at position zero. May be the receiver.
+ @param toBuffer   The buffer at position one. May be the receiver.
+ @param position   The position - where zero is `fromBuffer` and one is `toBuffer`.
+ 
+ @discussion No memory is allocated.
+ 
+ @return `YES` if the interpolation was written - `NO` if the buffers are not compatible with the receiver.
+ */
+- (BOOL)interpolateFromBuffer:(AMNumericBuffer * _Nonnull)fromBuffer toBuffer:(AMNumericBuffer * _Nonnull)toBuffer atPosition:(double)position;
+
+@end
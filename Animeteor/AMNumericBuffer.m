@@ -0,0 +1,149 @@
+//
+//  AMNumericBuffer.m
+//  Animeteor
+//
+//  Copyright (c) 2013-2015, Kristian Trenskow
+//  All rights reserved.
+//  
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are met:
+//  
+//  1. Redistributions of source code must retain the above copyright notice,
+//  this list of conditions and the following disclaimer.
+//  
+//  2. Redistributions in binary form must reproduce the above copyright notice,
+//  this list of conditions and the following disclaimer in the documentation
+//  and/or other materials provided with the distribution.
+//  
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+//  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+//  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+//  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+//  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+//  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+//  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+//  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+//  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+//  POSSIBILITY OF SUCH DAMAGE.
+//
+
+#import "AMBufferKernels.h"
+
+#import "AMNumericBuffer.h"
+
+@interface AMNumericBuffer () {
+    void *_elements;
+}
+
+@end
+
+@implementation AMNumericBuffer
+
+#pragma mark - Setup / Teardown
+
+- (instancetype)initWithType:(AMNumericBufferType)type count:(NSUInteger)count {
+    
+    if ((self = [super init])) {
+        
+        _type = type;
+        _count = count;
+        _elementSize = (type == AMNumericBufferTypeDouble ? sizeof(double) : sizeof(float));
+        
+        /* Empty buffers still have storage - so the bytes are never NULL. */
+        _elements = calloc(MAX(count, (NSUInteger)1), _elementSize);
+        
+    }
+    
+    return self;
+    
+}
+
+- (instancetype)initWithFloats:(const float *)floats count:(NSUInteger)count {
+    
+    if ((self = [self initWithType:AMNumericBufferTypeFloat count:count]))
+        memcpy(_elements, floats, sizeof(float) * count);
+    
+    return self;
+    
+}
+
+- (instancetype)initWithDoubles:(const double *)doubles count:(NSUInteger)count {
+    
+    if ((self = [self initWithType:AMNumericBufferTypeDouble count:count]))
+        memcpy(_elements, doubles, sizeof(double) * count);
+    
+    return self;
+    
+}
+
+- (void)dealloc {
+    
+    free(_elements);
+    
+}
+
+#pragma mark - Copying
+
+- (id)copyWithZone:(NSZone *)zone {
+    
+    /* The elements are mutable - so copies never share them. */
+    AMNumericBuffer *buffer = [[[self class] allocWithZone:zone] initWithType:self.type count:self.count];
+    
+    memcpy(buffer->_elements, _elements, self.elementSize * self.count);
+    
+    return buffer;
+    
+}
+
+#pragma mark - Properties
+
+- (const void *)bytes {
+    
+    return _elements;
+    
+}
+
+- (void *)mutableBytes {
+    
+    return _elements;
+    
+}
+
+#pragma mark - Interpolating
+
+- (BOOL)isCompatibleWithBuffer:(AMNumericBuffer *)buffer {
+    
+    return (buffer.type == self.type && buffer.count == self.count);
+    
+}
+
+- (BOOL)interpolateFromBuffer:(AMNumericBuffer *)fromBuffer toBuffer:(AMNumericBuffer *)toBuffer atPosition:(double)position {
+    
+    if (![self isCompatibleWithBuffer:fromBuffer] || ![self isCompatibleWithBuffer:toBuffer])
+        return NO;
+    
+    if (self.type == AMNumericBufferTypeDouble)
+        AMBufferMixDoubles(fromBuffer.bytes, toBuffer.bytes, position, _elements, self.count);
+    else
+        AMBufferMixFloats(fromBuffer.bytes, toBuffer.bytes, position, _elements, self.count);
+    
+    return YES;
+    
+}
+
+#pragma mark - Transitioning
+
+- (id<AMInterpolatable>)interpolateWithValue:(id<AMInterpolatable>)value atPosition:(double)position {
+    
+    NSAssert([(id)value isKindOfClass:[AMNumericBuffer class]] && [self isCompatibleWithBuffer:(AMNumericBuffer *)value], @"AMNumericBuffer cannot interpolate to value of class %@ or a buffer of another type or count", NSStringFromClass([(id)value class]));
+    
+    AMNumericBuffer *buffer = [[AMNumericBuffer alloc] initWithType:self.type count:self.count];
+    
+    [buffer interpolateFromBuffer:self toBuffer:(AMNumericBuffer *)value atPosition:position];
+    
+    return buffer;
+    
+}
+
+@end
@@ -0,0 +1,119 @@
+//
+//  AMSpringCurve.h
+//  Animeteor
+//
+//  Copyright (c) 2013-2015, Kristian Trenskow
+//  All rights reserved.
+//  
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are met:
+//  
+//  1. Redistributions of source code must retain the above copyright notice,
+//  this list of conditions and the following disclaimer.
+//  
+//  2. Redistributions in binary form must reproduce the above copyright notice,
+//  this list of conditions and the following disclaimer in the documentation
+//  and/or other materials provided with the distribution.
+//  
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+//  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+//  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+//  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+//  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+//  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+//  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+//  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+//  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+//  POSSIBILITY OF SUCH DAMAGE.
+//
+
+#import "AMCurve.h"
+
+/*!
+ The `AMSpringCurve` class provides curves that follow a damped spring as it is released from the start value towards the end value. Positions are evaluated using the closed form solution of the damped harmonic oscillator - so no simulation is involved.
+ 
+ A spring has no natural end, so the curve is scaled to the settling duration - the time it takes the spring to come within the tolerance of its rest position. Layer and direct animations created with a spring curve and a duration of zero will use the settling duration as their duration.
+ 
+ Parameters that are not greater than zero are raised to a small minimum in release builds, and the settling duration is limited to an hour - so the settling duration is always finite.
+ */
+@interface AMSpringCurve : AMCurve
+
+/// -----------------------------
+/// @name Creating a Spring Curve
+/// -----------------------------
+
+- (instancetype _Nonnull)initWithBlock:(AMCurveBlock _Nonnull)block UNAVAILABLE_ATTRIBUTE;
+
+/*!
+ Returns an initialized spring curve that settles within a tolerance of 0.001.
+ 
+ @param mass            The mass attached to the spring. Must be greater than zero.
+ @param stiffness       The stiffness of the spring. Must be greater than zero.
+ @param damping         The damping of the spring. Must be greater than zero.
+ @param initialVelocity The initial velocity of the spring. A value of one corresponds to the total distance traveled in one second.
+ 
+ @return An initialized spring curve.
+ */
+- (instancetype _Nonnull)initWithMass:(double)mass
+                            stiffness:(double)stiffness
+                              damping:(double)damping
+                      initialVelocity:(double)initialVelocity;
+
+/*!
+ Returns an initialized spring curve.
+ 
+ @param mass            The mass attached to the spring. Must be greater than zero.
+ @param stiffness       The stiffness of the spring. Must be greater than zero.
+ @param damping         The damping of the spring. Must be greater than zero.
+ @param initialVelocity The initial velocity of the spring. A value of one corresponds to the total distance traveled in one second.
+ @param tolerance       The distance from the rest position - where one is the total distance - at which the spring is considered settled.
+ 
+ @return An initialized spring curve.
+ */
+- (instancetype _Nonnull)initWithMass:(double)mass
+                            stiffness:(double)stiffness
+                              damping:(double)damping
+                      initialVelocity:(double)initialVelocity
+                            tolerance:(double)tolerance;
+
+/// --------------------------------------
+/// @name Getting Spring Curve Information
+/// --------------------------------------
+
+/*!
+ Returns the mass attached to the spring.
+ */
+@property (nonatomic,readonly) double mass;
+
+/*!
+ Returns the stiffness of the spring.
+ */
+@property (nonatomic,readonly) double stiffness;
+
+/*!
+ Returns the damping of the spring.
+ */
+@property (nonatomic,readonly) double damping;
+
+/*!
+ Returns the initial velocity of the spring.
+ */
+@property (nonatomic,readonly) double initialVelocity;
+
+/*!
+ Returns the tolerance used to compute the settling duration.
+ */
+@property (nonatomic,readonly) double tolerance;
+
+/*!
+ Returns the damping ratio of the spring. Springs with a ratio below one oscillate around the end value.
+ */
+@property (nonatomic,readonly) double dampingRatio;
+
+/*!
+ Returns the time in seconds it takes the spring to settle within the tolerance of the end value.
+ */
+@property (nonatomic,readonly) NSTimeInterval settlingDuration;
+
+@end
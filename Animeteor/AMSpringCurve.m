@@ -0,0 +1,128 @@
+//
+//  AMSpringCurve.m
+//  Animeteor
+//
+//  Copyright (c) 2013-2015, Kristian Trenskow
+//  All rights reserved.
+//  
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are met:
+//  
+//  1. Redistributions of source code must retain the above copyright notice,
+//  this list of conditions and the following disclaimer.
+//  
+//  2. Redistributions in binary form must reproduce the above copyright notice,
+//  this list of conditions and the following disclaimer in the documentation
+//  and/or other materials provided with the distribution.
+//  
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+//  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+//  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+//  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+//  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+//  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+//  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+//  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+//  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+//  POSSIBILITY OF SUCH DAMAGE.
+//
+
+#import "AMSpringCurve.h"
+
+/* Parameters are kept in range in release builds too - a spring without damping never settles. */
+static const double AMSpringCurveMinimumParameter = 1e-6;
+static const NSTimeInterval AMSpringCurveMaximumSettlingDuration = 3600.0;
+
+@interface AMSpringCurve () {
+    AMSpring _spring;
+}
+
+@end
+
+@implementation AMSpringCurve
+
+#pragma mark - Setup / Tear down
+
+- (instancetype)initWithMass:(double)mass stiffness:(double)stiffness damping:(double)damping initialVelocity:(double)initialVelocity {
+    
+    return [self initWithMass:mass
+                    stiffness:stiffness
+                      damping:damping
+              initialVelocity:initialVelocity
+                    tolerance:0.001];
+    
+}
+
+- (instancetype)initWithMass:(double)mass stiffness:(double)stiffness damping:(double)damping initialVelocity:(double)initialVelocity tolerance:(double)tolerance {
+    
+    NSParameterAssert(mass > 0.0);
+    NSParameterAssert(stiffness > 0.0);
+    NSParameterAssert(damping > 0.0);
+    NSParameterAssert(tolerance > 0.0);
+    
+    /* fmax and fmin also replace NaN. */
+    mass = fmax(mass, AMSpringCurveMinimumParameter);
+    stiffness = fmax(stiffness, AMSpringCurveMinimumParameter);
+    damping = fmax(damping, AMSpringCurveMinimumParameter);
+    tolerance = fmax(tolerance, AMSpringCurveMinimumParameter);
+    initialVelocity = (isfinite(initialVelocity) ? initialVelocity : 0.0);
+    
+    AMSpring spring = AMSpringMake(mass, stiffness, damping, initialVelocity);
+    double settlingDuration = fmin(AMSpringSettlingDuration(&spring, tolerance), AMSpringCurveMaximumSettlingDuration);
+    
+    if ((self = [super initWithBlock:^(double t) {
+        if (t >= 1.0) return 1.0;
+        return 1.0 + AMSpringDisplacement(&spring, MAX(t, 0.0) * settlingDuration);
+    }])) {
+        
+        _spring = spring;
+        _mass = mass;
+        _stiffness = stiffness;
+        _damping = damping;
+        _initialVelocity = initialVelocity;
+        _tolerance = tolerance;
+        _settlingDuration = settlingDuration;
+        
+    }
+    
+    return self;
+    
+}
+
+#pragma mark - Properties
+
+- (double)dampingRatio {
+    
+    return _spring.zeta;
+    
+}
+
+#pragma mark - Calculating Curve
+
+- (double)transform:(double)positionInTime {
+    
+    /* The spring is only within the tolerance at the settling duration - so the end is snapped. */
+    if (positionInTime >= 1.0) return 1.0;
+    
+    return 1.0 + AMSpringDisplacement(&_spring, MAX(positionInTime, 0.0) * _settlingDuration);
+    
+}
+
+- (void)transformPositions:(const double *)positions count:(NSUInteger)count output:(double *)output {
+    
+    for (NSUInteger idx = 0 ; idx < count ; idx++)
+        output[idx] = [self transform:positions[idx]];
+    
+}
+
+- (double)derivative:(double)positionInTime {
+    
+    /* The end is snapped - so the spring is at rest from there on. */
+    if (positionInTime >= 1.0) return .0;
+    
+    return AMSpringVelocity(&_spring, MAX(positionInTime, 0.0) * _settlingDuration) * _settlingDuration;
+    
+}
+
+@end
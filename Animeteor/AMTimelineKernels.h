@@ -0,0 +1,199 @@
+//
+//  AMTimelineKernels.h
+//  Animeteor
+//
+//  Copyright (c) 2013-2015, Kristian Trenskow
+//  All rights reserved.
+//  
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are met:
+//  
+//  1. Redistributions of source code must retain the above copyright notice,
+//  this list of conditions and the following disclaimer.
+//  
+//  2. Redistributions in binary form must reproduce the above copyright notice,
+//  this list of conditions and the following disclaimer in the documentation
+//  and/or other materials provided with the distribution.
+//  
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+//  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+//  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+//  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+//  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+//  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+//  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+//  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+//  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+//  POSSIBILITY OF SUCH DAMAGE.
+//
+
+/*
+ The timeline of an animation group as plain C functions - animations ordered by start time, and the range of them that can change when seeking. This header does not depend on the Objective-C runtime.
+ */
+
+#ifndef AMTimelineKernels_h
+#define AMTimelineKernels_h
+
+#include <math.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+    
+// MARK: - Searching
+    
+/*!
+ Returns the index of the first time not less than `time` in a sorted array.
+ */
+static inline size_t AMTimelineLowerBound(const double *times, size_t count, double time) {
+    size_t low = 0, high = count;
+    while (low < high) {
+        size_t middle = low + (high - low) / 2;
+        if (times[middle] < time) low = middle + 1;
+        else high = middle;
+    }
+    return low;
+}
+    
+/*!
+ Returns the index of the first time greater than `time` in a sorted array.
+ */
+static inline size_t AMTimelineUpperBound(const double *times, size_t count, double time) {
+    size_t low = 0, high = count;
+    while (low < high) {
+        size_t middle = low + (high - low) / 2;
+        if (times[middle] <= time) low = middle + 1;
+        else high = middle;
+    }
+    return low;
+}
+    
+// MARK: - Building
+    
+/*!
+ Writes the indices of `count` animations ordered by their start times to `order`. The sort is stable, so animations starting together keep the order they were added in. `scratch` holds `count` indices.
+ */
+static inline void AMTimelineSort(const double *startTimes, size_t *order, size_t *scratch, size_t count) {
+        
+    bool sorted = true;
+    for (size_t idx = 0 ; idx < count ; idx++) {
+        order[idx] = idx;
+        sorted = sorted && (idx == 0 || startTimes[idx - 1] <= startTimes[idx]);
+    }
+        
+    /* Animations are mostly added in order - which takes a single pass. */
+    if (sorted)
+        return;
+        
+    /* Merge runs of doubling width back and forth between the buffers. */
+    size_t *source = order;
+    size_t *destination = scratch;
+        
+    for (size_t width = 1 ; width < count ; width *= 2) {
+        
+        for (size_t low = 0 ; low < count ; low += 2 * width) {
+            size_t middle = (low + width < count ? low + width : count);
+            size_t high = (low + 2 * width < count ? low + 2 * width : count);
+            size_t left = low, right = middle, idx = low;
+            while (left < middle && right < high)
+                destination[idx++] = (startTimes[source[right]] < startTimes[source[left]] ? source[right++] : source[left++]);
+            while (left < middle)
+                destination[idx++] = source[left++];
+            while (right < high)
+                destination[idx++] = source[right++];
+        }
+        
+        size_t *merged = destination;
+        destination = source;
+        source = merged;
+        
+    }
+        
+    if (source != order)
+        memcpy(order, source, sizeof(size_t) * count);
+        
+}
+    
+/*!
+ The extent of a timeline.
+ */
+typedef struct {
+    /*! The start time of the first animation - or zero for an empty timeline. */
+    double delay;
+    /*! The latest end time of the animations - and at least zero. */
+    double end;
+    /*! The longest duration of the animations - and at least zero. */
+    double maximumDuration;
+} AMTimelineExtent;
+    
+/*!
+ Builds the timeline of `count` animations from their delays and durations in the order they were added. Writes the order of the animations by start time to `order` - see `AMTimelineSort` - and their start and end times in that order to `startTimes` and `endTimes`.
+ */
+static inline AMTimelineExtent AMTimelineBuild(const double *delays, const double *durations, size_t count, size_t *order, size_t *scratch, double *startTimes, double *endTimes) {
+        
+    AMTimelineSort(delays, order, scratch, count);
+        
+    AMTimelineExtent extent = { .0, .0, .0 };
+        
+    for (size_t idx = 0 ; idx < count ; idx++) {
+        startTimes[idx] = delays[order[idx]];
+        endTimes[idx] = startTimes[idx] + durations[order[idx]];
+        extent.maximumDuration = fmax(extent.maximumDuration, durations[order[idx]]);
+        extent.end = fmax(extent.end, endTimes[idx]);
+    }
+        
+    if (count > 0)
+        extent.delay = startTimes[0];
+        
+    return extent;
+        
+}
+    
+// MARK: - Seeking
+    
+/*!
+ The animations of a timeline that can change when seeking - by index in the order of the timeline.
+ */
+typedef struct {
+    /*! The first animation that can change. */
+    size_t first;
+    /*! The first animation not started at the new time - animations from `first` up to it are applied, and the rest up to `last` reset. */
+    size_t started;
+    /*! The index after the last animation that can change. */
+    size_t last;
+    /*! The earliest time seeked over - animations ending before it cannot change. */
+    double low;
+} AMTimelineSeek;
+    
+/*!
+ Returns the animations that can change when seeking a timeline from `lastTime` to `time` - or all animations when `lastTime` is NaN.
+ */
+static inline AMTimelineSeek AMTimelineSeekMake(const double *startTimes, size_t count, double maximumDuration, double lastTime, double time) {
+        
+    /* Only animations active somewhere between the last and the new time can change. */
+    double low = (isnan(lastTime) ? -INFINITY : fmin(lastTime, time));
+    double high = (isnan(lastTime) ? INFINITY : fmax(lastTime, time));
+        
+    /* No animation is longer than the longest one - so affected animations start within that window before `low`. */
+    AMTimelineSeek seek;
+    seek.first = AMTimelineLowerBound(startTimes, count, low - maximumDuration);
+    seek.last = AMTimelineUpperBound(startTimes, count, high);
+        
+    size_t started = AMTimelineUpperBound(startTimes, count, time);
+    started = (started < seek.last ? started : seek.last);
+    seek.started = (started > seek.first ? started : seek.first);
+    seek.low = low;
+        
+    return seek;
+        
+}
+    
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* AMTimelineKernels_h */
@@ -0,0 +1,416 @@
+//
+//  AMTransformKernels.h
+//  Animeteor
+//
+//  Copyright (c) 2013-2015, Kristian Trenskow
+//  All rights reserved.
+//  
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are met:
+//  
+//  1. Redistributions of source code must retain the above copyright notice,
+//  this list of conditions and the following disclaimer.
+//  
+//  2. Redistributions in binary form must reproduce the above copyright notice,
+//  this list of conditions and the following disclaimer in the documentation
+//  and/or other materials provided with the distribution.
+//  
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+//  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+//  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+//  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+//  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+//  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+//  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+//  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+//  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+//  POSSIBILITY OF SUCH DAMAGE.
+//
+
+/*
+ Decomposition and interpolation of 3D transforms as plain C functions - following the algorithm of the CSS Transforms specification. Matrices use the layout of `CATransform3D`, where `m[3][0...2]` is the translation. This header does not depend on the Objective-C runtime.
+ */
+
+#ifndef AMTransformKernels_h
+#define AMTransformKernels_h
+
+#include <math.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+    
+/*!
+ The slerp falls back to a normalized lerp when the quaternions are closer than this (cosine of the angle between them).
+ */
+#define AM_TRANSFORM_NLERP_THRESHOLD 0.9995
+    
+/*!
+ A 4x4 matrix with the same memory layout as a `CATransform3D` of doubles.
+ */
+typedef struct {
+    double m[4][4];
+} AMTransformMatrix;
+    
+/*!
+ A transform decomposed into its components.
+ */
+typedef struct {
+    double translation[3];
+    double scale[3];
+    double skew[3];         // XY, XZ and YZ shear.
+    double perspective[4];
+    double quaternion[4];   // x, y, z, w.
+} AMTransformDecomposition;
+    
+/*!
+ Two decomposed transforms ready for interpolation. Use `AMTransformInterpolationMake` to create one.
+ */
+typedef struct {
+    AMTransformDecomposition from;
+    AMTransformDecomposition to;
+    AMTransformMatrix fromMatrix;
+    AMTransformMatrix toMatrix;
+    int decomposed;         // Zero if either transform could not be decomposed - the matrices are then interpolated element wise.
+    double theta;           // Angle between the quaternions.
+    double sinTheta;
+} AMTransformInterpolation;
+    
+// MARK: - Matrices
+    
+static inline AMTransformMatrix AMTransformMatrixIdentity(void) {
+    AMTransformMatrix matrix = {{{ 1.0, .0, .0, .0 }, { .0, 1.0, .0, .0 }, { .0, .0, 1.0, .0 }, { .0, .0, .0, 1.0 }}};
+    return matrix;
+}
+    
+static inline AMTransformMatrix AMTransformMatrixMultiply(const AMTransformMatrix *a, const AMTransformMatrix *b) {
+    AMTransformMatrix result;
+    for (int i = 0 ; i < 4 ; i++)
+        for (int j = 0 ; j < 4 ; j++)
+            result.m[i][j] = a->m[i][0] * b->m[0][j] + a->m[i][1] * b->m[1][j] + a->m[i][2] * b->m[2][j] + a->m[i][3] * b->m[3][j];
+    return result;
+}
+    
+static inline double AMTransformDeterminant3(double a1, double a2, double a3, double b1, double b2, double b3, double c1, double c2, double c3) {
+    return a1 * (b2 * c3 - b3 * c2) - b1 * (a2 * c3 - a3 * c2) + c1 * (a2 * b3 - a3 * b2);
+}
+    
+static inline double AMTransformMatrixDeterminant(const AMTransformMatrix *matrix) {
+    const double (*m)[4] = matrix->m;
+    return (m[0][0] * AMTransformDeterminant3(m[1][1], m[2][1], m[3][1], m[1][2], m[2][2], m[3][2], m[1][3], m[2][3], m[3][3])
+            - m[0][1] * AMTransformDeterminant3(m[1][0], m[2][0], m[3][0], m[1][2], m[2][2], m[3][2], m[1][3], m[2][3], m[3][3])
+            + m[0][2] * AMTransformDeterminant3(m[1][0], m[2][0], m[3][0], m[1][1], m[2][1], m[3][1], m[1][3], m[2][3], m[3][3])
+            - m[0][3] * AMTransformDeterminant3(m[1][0], m[2][0], m[3][0], m[1][1], m[2][1], m[3][1], m[1][2], m[2][2], m[3][2]));
+}
+    
+/*!
+ Inverts a matrix using the adjugate. Returns zero if the matrix is singular.
+ */
+static inline int AMTransformMatrixInvert(const AMTransformMatrix *matrix, AMTransformMatrix *inverse) {
+        
+    double determinant = AMTransformMatrixDeterminant(matrix);
+    if (fabs(determinant) < 1e-12)
+        return 0;
+        
+    const double (*m)[4] = matrix->m;
+        
+    for (int i = 0 ; i < 4 ; i++)
+        for (int j = 0 ; j < 4 ; j++) {
+            /* Cofactor of m[j][i] - the transpose gives the adjugate. */
+            double minor[9];
+            int n = 0;
+            for (int r = 0 ; r < 4 ; r++) {
+                if (r == j) continue;
+                for (int c = 0 ; c < 4 ; c++) {
+                    if (c == i) continue;
+                    minor[n++] = m[r][c];
+                }
+            }
+            double cofactor = AMTransformDeterminant3(minor[0], minor[3], minor[6], minor[1], minor[4], minor[7], minor[2], minor[5], minor[8]);
+            inverse->m[i][j] = ((i + j) % 2 ? -cofactor : cofactor) / determinant;
+        }
+        
+    return 1;
+        
+}
+    
+// MARK: - Decomposition
+    
+static inline double AMTransformVectorLength(const double v[3]) {
+    return sqrt(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+}
+    
+static inline double AMTransformVectorDot(const double a[3], const double b[3]) {
+    return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+}
+    
+/* Sets a to a * as + b * bs. */
+static inline void AMTransformVectorCombine(double a[3], const double b[3], double as, double bs) {
+    for (int i = 0 ; i < 3 ; i++)
+        a[i] = a[i] * as + b[i] * bs;
+}
+    
+/*!
+ Decomposes a transform into translation, scale, skew, perspective and rotation.
+ 
+ @param matrix        The transform to decompose.
+ @param decomposition On return the components of the transform.
+ 
+ @return Zero if the matrix cannot be decomposed.
+ */
+static inline int AMTransformDecompose(const AMTransformMatrix *matrix, AMTransformDecomposition *decomposition) {
+        
+    if (matrix->m[3][3] == .0)
+        return 0;
+        
+    /* Normalize the matrix. */
+    AMTransformMatrix local;
+    for (int i = 0 ; i < 4 ; i++)
+        for (int j = 0 ; j < 4 ; j++)
+            local.m[i][j] = matrix->m[i][j] / matrix->m[3][3];
+        
+    /* The perspective matrix is used to solve for perspective - but also tests for singularity of the upper 3x3. */
+    AMTransformMatrix perspectiveMatrix = local;
+    for (int i = 0 ; i < 3 ; i++)
+        perspectiveMatrix.m[i][3] = .0;
+    perspectiveMatrix.m[3][3] = 1.0;
+        
+    if (fabs(AMTransformMatrixDeterminant(&perspectiveMatrix)) < 1e-12)
+        return 0;
+        
+    if (local.m[0][3] != .0 || local.m[1][3] != .0 || local.m[2][3] != .0) {
+            
+        double rightHandSide[4] = { local.m[0][3], local.m[1][3], local.m[2][3], local.m[3][3] };
+        AMTransformMatrix inverse;
+            
+        if (!AMTransformMatrixInvert(&perspectiveMatrix, &inverse))
+            return 0;
+            
+        /* Multiplies by the transposed inverse. */
+        for (int i = 0 ; i < 4 ; i++)
+            decomposition->perspective[i] = rightHandSide[0] * inverse.m[i][0] + rightHandSide[1] * inverse.m[i][1] + rightHandSide[2] * inverse.m[i][2] + rightHandSide[3] * inverse.m[i][3];
+            
+    } else {
+        decomposition->perspective[0] = decomposition->perspective[1] = decomposition->perspective[2] = .0;
+        decomposition->perspective[3] = 1.0;
+    }
+        
+    for (int i = 0 ; i < 3 ; i++)
+        decomposition->translation[i] = local.m[3][i];
+        
+    double row[3][3];
+    for (int i = 0 ; i < 3 ; i++)
+        for (int j = 0 ; j < 3 ; j++)
+            row[i][j] = local.m[i][j];
+        
+    double *scale = decomposition->scale;
+    double *skew = decomposition->skew;
+        
+    scale[0] = AMTransformVectorLength(row[0]);
+    AMTransformVectorCombine(row[0], row[0], 1.0 / scale[0], .0);
+        
+    skew[0] = AMTransformVectorDot(row[0], row[1]);
+    AMTransformVectorCombine(row[1], row[0], 1.0, -skew[0]);
+        
+    scale[1] = AMTransformVectorLength(row[1]);
+    AMTransformVectorCombine(row[1], row[1], 1.0 / scale[1], .0);
+    skew[0] /= scale[1];
+        
+    skew[1] = AMTransformVectorDot(row[0], row[2]);
+    AMTransformVectorCombine(row[2], row[0], 1.0, -skew[1]);
+    skew[2] = AMTransformVectorDot(row[1], row[2]);
+    AMTransformVectorCombine(row[2], row[1], 1.0, -skew[2]);
+        
+    scale[2] = AMTransformVectorLength(row[2]);
+    AMTransformVectorCombine(row[2], row[2], 1.0 / scale[2], .0);
+    skew[1] /= scale[2];
+    skew[2] /= scale[2];
+        
+    /* Flip if the coordinate system is mirrored. */
+    double cross[3] = {
+        row[1][1] * row[2][2] - row[1][2] * row[2][1],
+        row[1][2] * row[2][0] - row[1][0] * row[2][2],
+        row[1][0] * row[2][1] - row[1][1] * row[2][0]
+    };
+        
+    if (AMTransformVectorDot(row[0], cross) < .0)
+        for (int i = 0 ; i < 3 ; i++) {
+            scale[i] *= -1.0;
+            AMTransformVectorCombine(row[i], row[i], -1.0, .0);
+        }
+        
+    double *quaternion = decomposition->quaternion;
+        
+    quaternion[0] = .5 * sqrt(fmax(1.0 + row[0][0] - row[1][1] - row[2][2], .0));
+    quaternion[1] = .5 * sqrt(fmax(1.0 - row[0][0] + row[1][1] - row[2][2], .0));
+    quaternion[2] = .5 * sqrt(fmax(1.0 - row[0][0] - row[1][1] + row[2][2], .0));
+    quaternion[3] = .5 * sqrt(fmax(1.0 + row[0][0] + row[1][1] + row[2][2], .0));
+        
+    if (row[2][1] > row[1][2]) quaternion[0] = -quaternion[0];
+    if (row[0][2] > row[2][0]) quaternion[1] = -quaternion[1];
+    if (row[1][0] > row[0][1]) quaternion[2] = -quaternion[2];
+        
+    return 1;
+        
+}
+    
+/*!
+ Recomposes a transform from its components.
+ 
+ @param decomposition The components of the transform.
+ 
+ @return The transform.
+ */
+static inline AMTransformMatrix AMTransformRecompose(const AMTransformDecomposition *decomposition) {
+        
+    AMTransformMatrix matrix = AMTransformMatrixIdentity();
+        
+    for (int i = 0 ; i < 4 ; i++)
+        matrix.m[i][3] = decomposition->perspective[i];
+        
+    for (int i = 0 ; i < 4 ; i++)
+        for (int j = 0 ; j < 3 ; j++)
+            matrix.m[3][i] += decomposition->translation[j] * matrix.m[j][i];
+        
+    double x = decomposition->quaternion[0];
+    double y = decomposition->quaternion[1];
+    double z = decomposition->quaternion[2];
+    double w = decomposition->quaternion[3];
+        
+    AMTransformMatrix rotation = AMTransformMatrixIdentity();
+    rotation.m[0][0] = 1.0 - 2.0 * (y * y + z * z);
+    rotation.m[0][1] = 2.0 * (x * y + z * w);
+    rotation.m[0][2] = 2.0 * (x * z - y * w);
+    rotation.m[1][0] = 2.0 * (x * y - z * w);
+    rotation.m[1][1] = 1.0 - 2.0 * (x * x + z * z);
+    rotation.m[1][2] = 2.0 * (y * z + x * w);
+    rotation.m[2][0] = 2.0 * (x * z + y * w);
+    rotation.m[2][1] = 2.0 * (y * z - x * w);
+    rotation.m[2][2] = 1.0 - 2.0 * (x * x + y * y);
+        
+    matrix = AMTransformMatrixMultiply(&rotation, &matrix);
+        
+    AMTransformMatrix skew = AMTransformMatrixIdentity();
+        
+    if (decomposition->skew[2] != .0) {
+        skew.m[2][1] = decomposition->skew[2];
+        matrix = AMTransformMatrixMultiply(&skew, &matrix);
+        skew.m[2][1] = .0;
+    }
+        
+    if (decomposition->skew[1] != .0) {
+        skew.m[2][0] = decomposition->skew[1];
+        matrix = AMTransformMatrixMultiply(&skew, &matrix);
+        skew.m[2][0] = .0;
+    }
+        
+    if (decomposition->skew[0] != .0) {
+        skew.m[1][0] = decomposition->skew[0];
+        matrix = AMTransformMatrixMultiply(&skew, &matrix);
+    }
+        
+    for (int i = 0 ; i < 3 ; i++)
+        for (int j = 0 ; j < 4 ; j++)
+            matrix.m[i][j] *= decomposition->scale[i];
+        
+    return matrix;
+        
+}
+    
+// MARK: - Interpolation
+    
+/*!
+ Prepares two transforms for interpolation. All decomposition happens here, so evaluating only involves a lerp and a slerp.
+ 
+ @param from          The transform at position zero.
+ @param to            The transform at position one.
+ @param interpolation On return the prepared interpolation.
+ */
+static inline void AMTransformInterpolationMake(const AMTransformMatrix *from, const AMTransformMatrix *to, AMTransformInterpolation *interpolation) {
+        
+    interpolation->fromMatrix = *from;
+    interpolation->toMatrix = *to;
+    interpolation->decomposed = (AMTransformDecompose(from, &interpolation->from) && AMTransformDecompose(to, &interpolation->to));
+    interpolation->theta = interpolation->sinTheta = .0;
+        
+    if (!interpolation->decomposed)
+        return;
+        
+    double *a = interpolation->from.quaternion;
+    double *b = interpolation->to.quaternion;
+    double product = a[0] * b[0] + a[1] * b[1] + a[2] * b[2] + a[3] * b[3];
+        
+    /* Take the shortest path. */
+    if (product < .0) {
+        for (int i = 0 ; i < 4 ; i++)
+            b[i] = -b[i];
+        product = -product;
+    }
+        
+    product = fmin(product, 1.0);
+        
+    if (product < AM_TRANSFORM_NLERP_THRESHOLD) {
+        interpolation->theta = acos(product);
+        interpolation->sinTheta = sin(interpolation->theta);
+    }
+        
+}
+    
+/*!
+ Returns the interpolated transform at a position.
+ 
+ @param interpolation The prepared interpolation.
+ @param position      The position between zero and one.
+ */
+static inline AMTransformMatrix AMTransformInterpolationEvaluate(const AMTransformInterpolation *interpolation, double position) {
+        
+    if (!interpolation->decomposed) {
+        AMTransformMatrix matrix;
+        for (int i = 0 ; i < 4 ; i++)
+            for (int j = 0 ; j < 4 ; j++)
+                matrix.m[i][j] = (interpolation->toMatrix.m[i][j] - interpolation->fromMatrix.m[i][j]) * position + interpolation->fromMatrix.m[i][j];
+        return matrix;
+    }
+        
+    const AMTransformDecomposition *from = &interpolation->from;
+    const AMTransformDecomposition *to = &interpolation->to;
+    AMTransformDecomposition value;
+        
+    for (int i = 0 ; i < 3 ; i++) {
+        value.translation[i] = (to->translation[i] - from->translation[i]) * position + from->translation[i];
+        value.scale[i] = (to->scale[i] - from->scale[i]) * position + from->scale[i];
+        value.skew[i] = (to->skew[i] - from->skew[i]) * position + from->skew[i];
+    }
+        
+    for (int i = 0 ; i < 4 ; i++)
+        value.perspective[i] = (to->perspective[i] - from->perspective[i]) * position + from->perspective[i];
+        
+    double fromWeight = 1.0 - position;
+    double toWeight = position;
+        
+    if (interpolation->sinTheta != .0) {
+        fromWeight = sin((1.0 - position) * interpolation->theta) / interpolation->sinTheta;
+        toWeight = sin(position * interpolation->theta) / interpolation->sinTheta;
+    }
+        
+    double length = .0;
+    for (int i = 0 ; i < 4 ; i++) {
+        value.quaternion[i] = from->quaternion[i] * fromWeight + to->quaternion[i] * toWeight;
+        length += value.quaternion[i] * value.quaternion[i];
+    }
+        
+    /* Normalizing makes the lerp an nlerp - and corrects rounding errors of the slerp. */
+    length = sqrt(length);
+    for (int i = 0 ; i < 4 ; i++)
+        value.quaternion[i] /= length;
+        
+    return AMTransformRecompose(&value);
+        
+}
+    
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* AMTransformKernels_h */
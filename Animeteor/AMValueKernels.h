@@ -0,0 +1,100 @@
+//
+//  AMValueKernels.h
+//  Animeteor
+//
+//  Copyright (c) 2013-2015, Kristian Trenskow
+//  All rights reserved.
+//  
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are met:
+//  
+//  1. Redistributions of source code must retain the above copyright notice,
+//  this list of conditions and the following disclaimer.
+//  
+//  2. Redistributions in binary form must reproduce the above copyright notice,
+//  this list of conditions and the following disclaimer in the documentation
+//  and/or other materials provided with the distribution.
+//  
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+//  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+//  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+//  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+//  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+//  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+//  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+//  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+//  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+//  POSSIBILITY OF SUCH DAMAGE.
+//
+
+/*
+ Interpolation of numbers and structs of CGFloats - points, sizes, vectors and rects - as plain C functions. Values are arrays of doubles, one per component, interpolated component by component. This header does not depend on the Objective-C runtime.
+ */
+
+#ifndef AMValueKernels_h
+#define AMValueKernels_h
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+    
+// MARK: - Interpolation
+    
+/*!
+ Writes `delta * position + from` of every component to `value`.
+ */
+static inline void AMValueLerp(const double *from, const double *delta, double position, double *value, size_t components) {
+        
+    for (size_t idx = 0 ; idx < components ; idx++)
+        value[idx] = delta[idx] * position + from[idx];
+        
+}
+    
+// MARK: - Velocity
+    
+/*!
+ Returns the weight of a carried initial velocity at a progress - `p(1 - p)^2`, which is zero at both ends and has a slope of one at the start and zero at the end.
+ */
+static inline double AMValueCarry(double progress) {
+    return progress * (1.0 - progress) * (1.0 - progress);
+}
+    
+/*!
+ Returns the slope of `AMValueCarry` at a progress.
+ */
+static inline double AMValueCarrySlope(double progress) {
+    return (1.0 - progress) * (1.0 - 3.0 * progress);
+}
+    
+/*!
+ Writes the interpolated value of every component to `value` - with `carry` carried by `AMValueCarry` of the progress.
+ */
+static inline void AMValueLerpCarrying(const double *from, const double *delta, const double *carry, double position, double progress, double *value, size_t components) {
+        
+    double weight = AMValueCarry(progress);
+        
+    for (size_t idx = 0 ; idx < components ; idx++)
+        value[idx] = delta[idx] * position + from[idx] + carry[idx] * weight;
+        
+}
+    
+/*!
+ Writes the velocity of every component to `velocity` - where `slope` is the slope of the curve at the progress, and `carry` may be `NULL`.
+ */
+static inline void AMValueVelocity(const double *delta, const double *carry, double slope, double progress, double duration, double *velocity, size_t components) {
+        
+    double carrySlope = (carry ? AMValueCarrySlope(progress) : .0);
+        
+    for (size_t idx = 0 ; idx < components ; idx++)
+        velocity[idx] = (delta[idx] * slope + (carry ? carry[idx] * carrySlope : .0)) / duration;
+        
+}
+    
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* AMValueKernels_h */
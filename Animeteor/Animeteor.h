@@ -39,14 +39,33 @@ FOUNDATION_EXPORT const unsigned char AnimeteorVersionString[];
 // In this header, you should import all the public headers of your framework using statements like #import <Animeteor/PublicHeader.h>
 
 #import "AMInterpolatable.h"
+#import "AMInterpolator.h"
+#import "AMTransformKernels.h"
+#import "AMColorKernels.h"
+#import "AMMotionPath.h"
+#import "AMBufferKernels.h"
+#import "AMNumericBuffer.h"
+#import "AMValueKernels.h"
 
 #import "NSNumber+AnimeteorAdditions.h"
 #import "NSValue+AnimeteorAdditions.h"
+#import "UIColor+AnimeteorAdditions.h"
 
 #import "AMCurve.h"
+#import "AMBakedCurve.h"
+#import "AMBezierCurve.h"
+#import "AMSpringCurve.h"
+#import "AMKeyframeCache.h"
+#import "AMKeyframeArchive.h"
 
 #import "AMAnimation.h"
+#import "AMFrameTicker.h"
+#import "AMAnimationRegistry.h"
 
 #import "AMAnimationGroup.h"
+#import "AMTimelineKernels.h"
 #import "AMLayerAnimation.h"
 #import "AMDirectAnimation.h"
+#import "AMAnimationBatch.h"
+#import "AMAnimationPool.h"
+#import "AMInstrumentation.h"
@@ -0,0 +1,305 @@
+//
+//  AMBenchmarkReferences.h
+//  Animeteor
+//
+//  Copyright (c) 2013-2015, Kristian Trenskow
+//  All rights reserved.
+//  
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are met:
+//  
+//  1. Redistributions of source code must retain the above copyright notice,
+//  this list of conditions and the following disclaimer.
+//  
+//  2. Redistributions in binary form must reproduce the above copyright notice,
+//  this list of conditions and the following disclaimer in the documentation
+//  and/or other materials provided with the distribution.
+//  
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+//  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+//  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+//  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+//  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+//  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+//  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+//  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+//  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+//  POSSIBILITY OF SUCH DAMAGE.
+//
+
+/*
+ Straightforward reference implementations the kernels are checked against. They favor being obviously correct over being fast - the curves are the formulas the build-in curves were originally written as.
+ */
+
+#ifndef AMBenchmarkReferences_h
+#define AMBenchmarkReferences_h
+
+#include <math.h>
+
+#include "AMCurveKernels.h"
+#include "AMTransformKernels.h"
+
+// MARK: - Curves
+
+static double AMReferenceLinear(double t) {
+    return t;
+}
+
+static double AMReferenceEaseInQuad(double t) {
+    return pow(t, 2.0);
+}
+
+static double AMReferenceEaseOutQuad(double t) {
+    return -1.0 * t * (t - 2.0);
+}
+
+static double AMReferenceEaseInOutQuad(double t) {
+    t /= .5;
+    if (t < 1.0) return .5 * pow(t, 2.0);
+    t -= 1.0;
+    return -.5 * (t * (t - 2.0) - 1.0);
+}
+
+static double AMReferenceEaseInCubic(double t) {
+    return pow(t, 3.0);
+}
+
+static double AMReferenceEaseOutCubic(double t) {
+    t -= 1.0;
+    return pow(t, 3.0) + 1.0;
+}
+
+static double AMReferenceEaseInOutCubic(double t) {
+    if (t < .5) return AMReferenceEaseInCubic(t * 2.0) / 2.0;
+    return AMReferenceEaseOutCubic((t - .5) * 2.0) / 2.0 + .5;
+}
+
+static double AMReferenceEaseInQuart(double t) {
+    return pow(t, 4.0);
+}
+
+static double AMReferenceEaseOutQuart(double t) {
+    t -= 1.0;
+    return -1.0 * (pow(t, 4.0) - 1.0);
+}
+
+static double AMReferenceEaseInOutQuart(double t) {
+    t /= .5;
+    if (t < 1.0) return .5 * pow(t, 4.0);
+    t -= 2.0;
+    return -.5 * (pow(t, 4.0) - 2.0);
+}
+
+static double AMReferenceEaseInQuint(double t) {
+    return pow(t, 5.0);
+}
+
+static double AMReferenceEaseOutQuint(double t) {
+    t -= 1.0;
+    return pow(t, 5.0) + 1.0;
+}
+
+static double AMReferenceEaseInOutQuint(double t) {
+    t /= .5;
+    if (t < 1.0) return .5 * pow(t, 5.0);
+    t -= 2.0;
+    return .5 * (pow(t, 5.0) + 2.0);
+}
+
+static double AMReferenceEaseInSine(double t) {
+    return -1.0 * cos(t * AM_CURVE_PI_2) + 1.0;
+}
+
+static double AMReferenceEaseOutSine(double t) {
+    return sin(t * AM_CURVE_PI_2);
+}
+
+static double AMReferenceEaseInOutSine(double t) {
+    return -.5 * cos(AM_CURVE_PI * t) + .5;
+}
+
+static double AMReferenceEaseInExpo(double t) {
+    return (t == 0.0 ? 0.0 : pow(2.0, 10.0 * (t - 1.0)));
+}
+
+static double AMReferenceEaseOutExpo(double t) {
+    return -pow(2.0, -10.0 * t) + 1.0;
+}
+
+static double AMReferenceEaseInOutExpo(double t) {
+    if (t == 0.0) return 0.0;
+    if (t == 1.0) return 1.0;
+    t /= .5;
+    if (t < 1.0) return .5 * pow(2.0, 10.0 * (t - 1.0));
+    t -= 1.0;
+    return .5 * (-pow(2.0, -10.0 * t) + 2.0);
+}
+
+static double AMReferenceEaseInCirc(double t) {
+    return -1.0 * (sqrt(1.0 - pow(t, 2.0)) - 1.0);
+}
+
+static double AMReferenceEaseOutCirc(double t) {
+    return sqrt(1.0 - pow(t - 1.0, 2.0));
+}
+
+static double AMReferenceEaseInOutCirc(double t) {
+    t /= .5;
+    if (t < 1.0) return -.5 * (sqrt(1.0 - pow(t, 2.0)) - 1.0);
+    return .5 * (sqrt(1.0 - pow(t - 2.0, 2.0)) + 1.0);
+}
+
+static double AMReferenceEaseInElastic(double t) {
+    if (t == 0.0) return 0.0;
+    if (t == 1.0) return 1.0;
+    double p = .3;
+    double s = p / (2.0 * AM_CURVE_PI) * asin(1.0);
+    t -= 1.0;
+    return -(pow(2.0, 10.0 * t) * sin((t - s) * (2.0 * AM_CURVE_PI) / p));
+}
+
+static double AMReferenceEaseOutElastic(double t) {
+    if (t == 0.0) return 0.0;
+    if (t == 1.0) return 1.0;
+    double p = .3;
+    double s = p / (2.0 * AM_CURVE_PI) * asin(1.0);
+    return pow(2.0, -10.0 * t) * sin((t - s) * (2.0 * AM_CURVE_PI) / p) + 1.0;
+}
+
+static double AMReferenceEaseInOutElastic(double t) {
+    if (t == 0.0) return 0.0;
+    t /= .5;
+    if (t == 2.0) return 1.0;
+    double p = .3 * 1.5;
+    double s = p / (2.0 * AM_CURVE_PI) * asin(1.0);
+    t -= 1.0;
+    if (t < 0.0) return -.5 * (pow(2.0, 10.0 * t) * sin((t - s) * (2.0 * AM_CURVE_PI) / p));
+    return pow(2.0, -10.0 * t) * sin((t - s) * (2.0 * AM_CURVE_PI) / p) * .5 + 1.0;
+}
+
+static double AMReferenceEaseInBack(double t) {
+    return t * t * (2.70158 * t - 1.70158);
+}
+
+static double AMReferenceEaseOutBack(double t) {
+    double s = 1.70158f;
+    t -= 1.0;
+    return t * t * ((s + 1.0) * t + s) + 1.0;
+}
+
+static double AMReferenceEaseInOutBack(double t) {
+    double s = 1.70158f * 1.525f;
+    t /= .5;
+    if (t < 1.0) return .5 * (t * t * ((s + 1.0) * t - s));
+    t -= 2.0;
+    return .5 * (t * t * ((s + 1.0) * t + s) + 2.0);
+}
+
+static double AMReferenceEaseOutBounce(double t) {
+    if (t < 1.0 / 2.75) return 7.5625 * t * t;
+    if (t < 2.0 / 2.75) { t -= 1.5 / 2.75; return 7.5625 * t * t + .75; }
+    if (t < 2.5 / 2.75) { t -= 2.25 / 2.75; return 7.5625 * t * t + .9375; }
+    t -= 2.625 / 2.75;
+    return 7.5625 * t * t + .984375;
+}
+
+static double AMReferenceEaseInBounce(double t) {
+    return 1.0 - AMReferenceEaseOutBounce(1.0 - t);
+}
+
+static double AMReferenceEaseInOutBounce(double t) {
+    if (t < .5) return AMReferenceEaseInBounce(t * 2.0) * .5;
+    return AMReferenceEaseOutBounce(t * 2.0 - 1.0) * .5 + .5;
+}
+
+/* Indexed by `AMCurveFunction`. */
+static double (* const AMReferenceCurves[AMCurveFunctionCount])(double) = {
+    NULL,
+    AMReferenceLinear,
+    AMReferenceEaseInQuad, AMReferenceEaseOutQuad, AMReferenceEaseInOutQuad,
+    AMReferenceEaseInCubic, AMReferenceEaseOutCubic, AMReferenceEaseInOutCubic,
+    AMReferenceEaseInQuart, AMReferenceEaseOutQuart, AMReferenceEaseInOutQuart,
+    AMReferenceEaseInQuint, AMReferenceEaseOutQuint, AMReferenceEaseInOutQuint,
+    AMReferenceEaseInSine, AMReferenceEaseOutSine, AMReferenceEaseInOutSine,
+    AMReferenceEaseInExpo, AMReferenceEaseOutExpo, AMReferenceEaseInOutExpo,
+    AMReferenceEaseInCirc, AMReferenceEaseOutCirc, AMReferenceEaseInOutCirc,
+    AMReferenceEaseInElastic, AMReferenceEaseOutElastic, AMReferenceEaseInOutElastic,
+    AMReferenceEaseInBack, AMReferenceEaseOutBack, AMReferenceEaseInOutBack,
+    AMReferenceEaseInBounce, AMReferenceEaseOutBounce, AMReferenceEaseInOutBounce
+};
+
+static const char * const AMReferenceCurveNames[AMCurveFunctionCount] = {
+    "custom",
+    "linear",
+    "easeInQuad", "easeOutQuad", "easeInOutQuad",
+    "easeInCubic", "easeOutCubic", "easeInOutCubic",
+    "easeInQuart", "easeOutQuart", "easeInOutQuart",
+    "easeInQuint", "easeOutQuint", "easeInOutQuint",
+    "easeInSine", "easeOutSine", "easeInOutSine",
+    "easeInExpo", "easeOutExpo", "easeInOutExpo",
+    "easeInCirc", "easeOutCirc", "easeInOutCirc",
+    "easeInElastic", "easeOutElastic", "easeInOutElastic",
+    "easeInBack", "easeOutBack", "easeInOutBack",
+    "easeInBounce", "easeOutBounce", "easeInOutBounce"
+};
+
+// MARK: - Cubic Bezier
+
+/* Solves x(t) by bisection alone - slow, but it always converges. */
+static double AMReferenceCubicBezier(double x1, double y1, double x2, double y2, double x) {
+    double low = 0.0, high = 1.0, t = x;
+    for (int iteration = 0 ; iteration < 100 ; iteration++) {
+        t = (low + high) / 2.0;
+        double u = 1.0 - t;
+        double bx = 3.0 * u * u * t * x1 + 3.0 * u * t * t * x2 + t * t * t;
+        if (bx < x) low = t;
+        else high = t;
+    }
+    double u = 1.0 - t;
+    return 3.0 * u * u * t * y1 + 3.0 * u * t * t * y2 + t * t * t;
+}
+
+// MARK: - Spring
+
+/* Integrates mx'' + cx' + kx = 0 from x = -1 using fourth order Runge-Kutta. */
+static double AMReferenceSpring(double mass, double stiffness, double damping, double initialVelocity, double time, double step) {
+    double x = -1.0, v = initialVelocity;
+    for (double elapsed = 0.0 ; elapsed < time ; elapsed += step) {
+        double h = fmin(step, time - elapsed);
+        double ax1 = v, av1 = (-stiffness * x - damping * v) / mass;
+        double x2 = x + ax1 * h / 2.0, v2 = v + av1 * h / 2.0;
+        double ax2 = v2, av2 = (-stiffness * x2 - damping * v2) / mass;
+        double x3 = x + ax2 * h / 2.0, v3 = v + av2 * h / 2.0;
+        double ax3 = v3, av3 = (-stiffness * x3 - damping * v3) / mass;
+        double x4 = x + ax3 * h, v4 = v + av3 * h;
+        double ax4 = v4, av4 = (-stiffness * x4 - damping * v4) / mass;
+        x += h / 6.0 * (ax1 + 2.0 * ax2 + 2.0 * ax3 + ax4);
+        v += h / 6.0 * (av1 + 2.0 * av2 + 2.0 * av3 + av4);
+    }
+    return x;
+}
+
+// MARK: - Transforms
+
+/* The matrix of CATransform3DMakeRotation - row vectors, translation in the last row. */
+static AMTransformMatrix AMReferenceRotation(double angle, double x, double y, double z) {
+    double length = sqrt(x * x + y * y + z * z);
+    x /= length; y /= length; z /= length;
+    double c = cos(angle), s = sin(angle), t = 1.0 - c;
+    AMTransformMatrix matrix = AMTransformMatrixIdentity();
+    matrix.m[0][0] = t * x * x + c; matrix.m[0][1] = t * x * y + s * z; matrix.m[0][2] = t * x * z - s * y;
+    matrix.m[1][0] = t * x * y - s * z; matrix.m[1][1] = t * y * y + c; matrix.m[1][2] = t * y * z + s * x;
+    matrix.m[2][0] = t * x * z + s * y; matrix.m[2][1] = t * y * z - s * x; matrix.m[2][2] = t * z * z + c;
+    return matrix;
+}
+
+static double AMReferenceMatrixDistance(const AMTransformMatrix *a, const AMTransformMatrix *b) {
+    double distance = 0.0;
+    for (int row = 0 ; row < 4 ; row++)
+        for (int column = 0 ; column < 4 ; column++)
+            distance = fmax(distance, fabs(a->m[row][column] - b->m[row][column]));
+    return distance;
+}
+
+#endif /* AMBenchmarkReferences_h */
@@ -0,0 +1,1145 @@
+//
+//  AMBenchmarks.c
+//  Animeteor
+//
+//  Copyright (c) 2013-2015, Kristian Trenskow
+//  All rights reserved.
+//  
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are met:
+//  
+//  1. Redistributions of source code must retain the above copyright notice,
+//  this list of conditions and the following disclaimer.
+//  
+//  2. Redistributions in binary form must reproduce the above copyright notice,
+//  this list of conditions and the following disclaimer in the documentation
+//  and/or other materials provided with the distribution.
+//  
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+//  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+//  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+//  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+//  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+//  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+//  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+//  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+//  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+//  POSSIBILITY OF SUCH DAMAGE.
+//
+
+/*
+ Headless benchmarks of the curve, value, transform, color, buffer and timeline kernels that the animation classes are built on. Every result is the fastest of a number of runs, reported in nanoseconds per item, and compared against a baseline of an earlier run. Every kernel is also checked against a reference implementation.
+ 
+ Usage: benchmarks [-b baseline.json] [-r regression] [-a]
+ 
+    -b  Compare against a baseline - the output of an earlier run.
+    -r  Fail when a result is slower than the baseline by more than this fraction - like 0.1.
+    -a  Only check accuracy.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "AMCurveKernels.h"
+#include "AMTransformKernels.h"
+#include "AMColorKernels.h"
+#include "AMBufferKernels.h"
+#include "AMValueKernels.h"
+#include "AMTimelineKernels.h"
+
+#include "AMBenchmarkReferences.h"
+
+#define AM_BENCHMARK_RUNS 9
+#define AM_BENCHMARK_RUN_DURATION 2e6
+#define AM_BENCHMARK_SAMPLES 4096
+#define AM_BENCHMARK_MAX_RESULTS 256
+#define AM_BENCHMARK_NAME_LENGTH 64
+
+typedef struct {
+    char name[AM_BENCHMARK_NAME_LENGTH];
+    const char *per;
+    double nanoseconds;
+    double baseline;
+} AMBenchmarkResult;
+
+typedef struct {
+    char name[AM_BENCHMARK_NAME_LENGTH];
+    double error;
+    double tolerance;
+} AMBenchmarkAccuracy;
+
+typedef struct {
+    AMCurveFunction function;
+    AMCubicBezier bezier;
+    AMSpring spring;
+    double (*custom)(double);
+#if defined(__BLOCKS__)
+    double (^block)(double);
+#endif
+    double fromValue[4];
+    double deltaValue[4];
+    double carryValue[4];
+    size_t components;
+    AMTransformMatrix from;
+    AMTransformMatrix to;
+    AMTransformInterpolation interpolation;
+    AMColorSpace colorSpace;
+    double fromColor[4];
+    double deltaColor[4];
+    const void *fromBuffer;
+    const void *deltaBuffer;
+    void *outputBuffer;
+    const double *delays;
+    const double *durations;
+    size_t *order;
+    double *startTimes;
+    double *endTimes;
+    double maximumDuration;
+    double duration;
+    const double *positions;
+    double *output;
+    size_t count;
+} AMBenchmarkContext;
+
+typedef void (*AMBenchmarkBody)(AMBenchmarkContext *context);
+
+static AMBenchmarkResult results[AM_BENCHMARK_MAX_RESULTS];
+static size_t resultCount;
+
+static AMBenchmarkAccuracy accuracies[AM_BENCHMARK_MAX_RESULTS];
+static size_t accuracyCount;
+
+/* Results are accumulated here so the compiler cannot drop the work. */
+static volatile double sink;
+
+// MARK: - Measuring
+
+static double AMBenchmarkNow(void) {
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return (double)time.tv_sec * 1e9 + (double)time.tv_nsec;
+}
+
+static void AMBenchmarkMeasure(const char *name, const char *per, size_t items, AMBenchmarkBody body, AMBenchmarkContext *context) {
+    
+    /* Repeat the body until a run is long enough to time reliably - which also warms up caches and branch predictors. */
+    size_t iterations = 1;
+    for (;;) {
+        double start = AMBenchmarkNow();
+        for (size_t iteration = 0 ; iteration < iterations ; iteration++)
+            body(context);
+        if (AMBenchmarkNow() - start >= AM_BENCHMARK_RUN_DURATION)
+            break;
+        iterations *= 2;
+    }
+    
+    double fastest = INFINITY;
+    for (int run = 0 ; run < AM_BENCHMARK_RUNS ; run++) {
+        double start = AMBenchmarkNow();
+        for (size_t iteration = 0 ; iteration < iterations ; iteration++)
+            body(context);
+        fastest = fmin(fastest, AMBenchmarkNow() - start);
+    }
+    
+    AMBenchmarkResult *result = &results[resultCount++];
+    snprintf(result->name, sizeof(result->name), "%s", name);
+    result->per = per;
+    result->nanoseconds = fastest / (double)(items * iterations);
+    result->baseline = NAN;
+    
+}
+
+static void AMBenchmarkCheck(const char *name, double error, double tolerance) {
+    
+    AMBenchmarkAccuracy *accuracy = &accuracies[accuracyCount++];
+    snprintf(accuracy->name, sizeof(accuracy->name), "%s", name);
+    accuracy->error = error;
+    accuracy->tolerance = tolerance;
+    
+}
+
+// MARK: - Curves
+
+static void AMBenchmarkCurveScalar(AMBenchmarkContext *context) {
+    /* Dispatched per sample - like direct animations do. */
+    double sum = 0.0;
+    for (size_t idx = 0 ; idx < context->count ; idx++)
+        sum += AMCurveFunctionTransform(context->function, context->positions[idx]);
+    sink += sum;
+}
+
+static void AMBenchmarkCurveBatch(AMBenchmarkContext *context) {
+    AMCurveFunctionTransformBatch(context->function, context->positions, context->output, context->count);
+    sink += context->output[context->count / 2];
+}
+
+static void AMBenchmarkCurveBezier(AMBenchmarkContext *context) {
+    double sum = 0.0;
+    for (size_t idx = 0 ; idx < context->count ; idx++)
+        sum += AMCubicBezierTransform(&context->bezier, context->positions[idx]);
+    sink += sum;
+}
+
+static void AMBenchmarkCurveSpring(AMBenchmarkContext *context) {
+    double sum = 0.0;
+    for (size_t idx = 0 ; idx < context->count ; idx++)
+        sum += AMSpringDisplacement(&context->spring, context->positions[idx]);
+    sink += sum;
+}
+
+static void AMBenchmarkCurveCustom(AMBenchmarkContext *context) {
+    /* Block curves are called indirectly for every sample - a function pointer is the nearest C equivalent. */
+    double (* volatile custom)(double) = context->custom;
+    double sum = 0.0;
+    for (size_t idx = 0 ; idx < context->count ; idx++)
+        sum += custom(context->positions[idx]);
+    sink += sum;
+}
+
+#if defined(__BLOCKS__)
+static void AMBenchmarkCurveBlock(AMBenchmarkContext *context) {
+    /* Block curves call their block for every sample. */
+    double (^block)(double) = context->block;
+    double sum = 0.0;
+    for (size_t idx = 0 ; idx < context->count ; idx++)
+        sum += block(context->positions[idx]);
+    sink += sum;
+}
+#endif
+
+static void AMBenchmarkCurves(AMBenchmarkContext *context) {
+    
+    char name[AM_BENCHMARK_NAME_LENGTH];
+    
+    for (int function = AMCurveFunctionLinear ; function < AMCurveFunctionCount ; function++) {
+        
+        context->function = (AMCurveFunction)function;
+        
+        snprintf(name, sizeof(name), "curve.%s.scalar", AMReferenceCurveNames[function]);
+        AMBenchmarkMeasure(name, "sample", context->count, AMBenchmarkCurveScalar, context);
+        
+        snprintf(name, sizeof(name), "curve.%s.batch", AMReferenceCurveNames[function]);
+        AMBenchmarkMeasure(name, "sample", context->count, AMBenchmarkCurveBatch, context);
+        
+    }
+    
+    context->bezier = AMCubicBezierMake(.25, .1, .25, 1.0);
+    AMBenchmarkMeasure("curve.bezier.scalar", "sample", context->count, AMBenchmarkCurveBezier, context);
+    
+    context->spring = AMSpringMake(1.0, 100.0, 10.0, 0.0);
+    AMBenchmarkMeasure("curve.spring.scalar", "sample", context->count, AMBenchmarkCurveSpring, context);
+    
+    context->custom = AMReferenceEaseInOutCubic;
+    AMBenchmarkMeasure("curve.custom.scalar", "sample", context->count, AMBenchmarkCurveCustom, context);
+    
+#if defined(__BLOCKS__)
+    context->block = ^(double t) { return AMReferenceEaseInOutCubic(t); };
+    AMBenchmarkMeasure("curve.block.scalar", "sample", context->count, AMBenchmarkCurveBlock, context);
+#endif
+    
+}
+
+static void AMBenchmarkCurvesAccuracy(void) {
+    
+    char name[AM_BENCHMARK_NAME_LENGTH];
+    
+    size_t count = 10001;
+    double *positions = malloc(sizeof(double) * count);
+    double *output = malloc(sizeof(double) * count);
+    
+    for (size_t idx = 0 ; idx < count ; idx++)
+        positions[idx] = (double)idx / (count - 1);
+    
+    for (int function = AMCurveFunctionLinear ; function < AMCurveFunctionCount ; function++) {
+        
+        AMCurveFunctionTransformBatch((AMCurveFunction)function, positions, output, count);
+        
+        double error = 0.0;
+        for (size_t idx = 0 ; idx < count ; idx++) {
+            double reference = AMReferenceCurves[function](positions[idx]);
+            error = fmax(error, fabs(AMCurveFunctionTransform((AMCurveFunction)function, positions[idx]) - reference));
+            error = fmax(error, fabs(output[idx] - reference));
+        }
+        
+        snprintf(name, sizeof(name), "curve.%s", AMReferenceCurveNames[function]);
+        AMBenchmarkCheck(name, error, 1e-9);
+        
+    }
+    
+    static const double controlPoints[][4] = {
+        { .25, .1, .25, 1.0 },
+        { .42, 0.0, 1.0, 1.0 },
+        { 0.0, 0.0, .58, 1.0 },
+        { .68, -.55, .265, 1.55 }
+    };
+    
+    double error = 0.0;
+    for (size_t curve = 0 ; curve < sizeof(controlPoints) / sizeof(controlPoints[0]) ; curve++) {
+        const double *points = controlPoints[curve];
+        AMCubicBezier bezier = AMCubicBezierMake(points[0], points[1], points[2], points[3]);
+        for (size_t idx = 0 ; idx < count ; idx += 10)
+            error = fmax(error, fabs(AMCubicBezierTransform(&bezier, positions[idx]) - AMReferenceCubicBezier(points[0], points[1], points[2], points[3], positions[idx])));
+    }
+    AMBenchmarkCheck("curve.bezier", error, 1e-6);
+    
+    /* Under, critically and over damped. */
+    static const double springs[][4] = {
+        { 1.0, 100.0, 10.0, 0.0 },
+        { 1.0, 100.0, 20.0, 0.0 },
+        { 1.0, 100.0, 40.0, 0.0 },
+        { 2.0, 50.0, 20.0, -3.0 }
+    };
+    
+    error = 0.0;
+    for (size_t idx = 0 ; idx < sizeof(springs) / sizeof(springs[0]) ; idx++) {
+        const double *parameters = springs[idx];
+        AMSpring spring = AMSpringMake(parameters[0], parameters[1], parameters[2], parameters[3]);
+        for (double time = 0.0 ; time <= 2.0 ; time += .05)
+            error = fmax(error, fabs(AMSpringDisplacement(&spring, time) - AMReferenceSpring(parameters[0], parameters[1], parameters[2], parameters[3], time, 1e-4)));
+    }
+    AMBenchmarkCheck("curve.spring", error, 1e-6);
+    
+    free(positions);
+    free(output);
+    
+}
+
+/* Analytic derivatives are checked against central differences of the references - relative to the slope where it is steep. */
+static void AMBenchmarkDerivativesAccuracy(void) {
+    
+    char name[AM_BENCHMARK_NAME_LENGTH];
+    
+    const double step = 1e-6;
+    
+    for (int function = AMCurveFunctionLinear ; function < AMCurveFunctionCount ; function++) {
+        
+        double error = 0.0;
+        for (size_t idx = 1 ; idx < 1000 ; idx++) {
+            double t = idx / 1000.0;
+            double reference = (AMReferenceCurves[function](t + step) - AMReferenceCurves[function](t - step)) / (2.0 * step);
+            double derivative = AMCurveFunctionDerivative((AMCurveFunction)function, t);
+            /* Vertical tangents (the circular curves) are infinite - and steep in the reference. */
+            if (isinf(derivative) && fabs(reference) > 1e2) continue;
+            error = fmax(error, fabs(derivative - reference) / fmax(1.0, fabs(reference)));
+        }
+        
+        snprintf(name, sizeof(name), "derivative.%s", AMReferenceCurveNames[function]);
+        AMBenchmarkCheck(name, error, 1e-4);
+        
+    }
+    
+    AMCubicBezier bezier = AMCubicBezierMake(.68, -.55, .265, 1.55);
+    
+    double error = 0.0;
+    for (size_t idx = 1 ; idx < 1000 ; idx++) {
+        double t = idx / 1000.0;
+        double reference = (AMCubicBezierTransform(&bezier, t + step) - AMCubicBezierTransform(&bezier, t - step)) / (2.0 * step);
+        error = fmax(error, fabs(AMCubicBezierDerivative(&bezier, t) - reference) / fmax(1.0, fabs(reference)));
+    }
+    AMBenchmarkCheck("derivative.bezier", error, 1e-4);
+    
+    error = 0.0;
+    for (double damping = 10.0 ; damping <= 40.0 ; damping += 10.0) {
+        AMSpring spring = AMSpringMake(1.0, 100.0, damping, -3.0);
+        for (double time = .01 ; time <= 2.0 ; time += .05) {
+            double reference = (AMSpringDisplacement(&spring, time + step) - AMSpringDisplacement(&spring, time - step)) / (2.0 * step);
+            error = fmax(error, fabs(AMSpringVelocity(&spring, time) - reference));
+        }
+    }
+    AMBenchmarkCheck("derivative.spring", error, 1e-4);
+    
+}
+
+// MARK: - Interpolation
+
+static void AMBenchmarkTransformMake(AMBenchmarkContext *context) {
+    double sum = 0.0;
+    for (size_t idx = 0 ; idx < context->count ; idx++) {
+        AMTransformInterpolationMake(&context->from, &context->to, &context->interpolation);
+        sum += context->interpolation.theta;
+    }
+    sink += sum;
+}
+
+static void AMBenchmarkTransformEvaluate(AMBenchmarkContext *context) {
+    double sum = 0.0;
+    for (size_t idx = 0 ; idx < context->count ; idx++)
+        sum += AMTransformInterpolationEvaluate(&context->interpolation, context->positions[idx]).m[0][0];
+    sink += sum;
+}
+
+static void AMBenchmarkValueLerp(AMBenchmarkContext *context) {
+    double sum = 0.0;
+    for (size_t idx = 0 ; idx < context->count ; idx++) {
+        double value[4];
+        AMValueLerp(context->fromValue, context->deltaValue, context->positions[idx], value, context->components);
+        sum += value[0];
+    }
+    sink += sum;
+}
+
+static void AMBenchmarkValueLerpCarrying(AMBenchmarkContext *context) {
+    double sum = 0.0;
+    for (size_t idx = 0 ; idx < context->count ; idx++) {
+        double value[4];
+        AMValueLerpCarrying(context->fromValue, context->deltaValue, context->carryValue, context->positions[idx], context->positions[idx], value, context->components);
+        sum += value[0];
+    }
+    sink += sum;
+}
+
+static void AMBenchmarkInterpolation(AMBenchmarkContext *context) {
+    
+    /* Numbers and structs as the interpolator unboxes them. Colors and buffers are measured with their kernels. */
+    static const struct { const char *name; size_t components; } types[] = {
+        { "number", 1 },
+        { "point", 2 },
+        { "size", 2 },
+        { "vector", 2 },
+        { "rect", 4 }
+    };
+    
+    const double from[4] = { 10.0, -20.0, 100.0, 50.0 };
+    const double to[4] = { 250.0, 40.0, 320.0, 480.0 };
+    
+    for (int component = 0 ; component < 4 ; component++) {
+        context->fromValue[component] = from[component];
+        context->deltaValue[component] = to[component] - from[component];
+        context->carryValue[component] = 30.0 - 10.0 * component;
+    }
+    
+    char name[AM_BENCHMARK_NAME_LENGTH];
+    
+    for (size_t idx = 0 ; idx < sizeof(types) / sizeof(types[0]) ; idx++) {
+        
+        context->components = types[idx].components;
+        
+        snprintf(name, sizeof(name), "interpolation.%s", types[idx].name);
+        AMBenchmarkMeasure(name, "sample", context->count, AMBenchmarkValueLerp, context);
+        
+        snprintf(name, sizeof(name), "interpolation.%s.carried", types[idx].name);
+        AMBenchmarkMeasure(name, "sample", context->count, AMBenchmarkValueLerpCarrying, context);
+        
+    }
+    
+    AMTransformMatrix scale = AMTransformMatrixIdentity();
+    scale.m[0][0] = 2.0;
+    scale.m[1][1] = .5;
+    
+    AMTransformMatrix rotation = AMReferenceRotation(1.2, 1.0, 1.0, 0.0);
+    rotation.m[3][0] = 50.0;
+    
+    context->from = AMTransformMatrixIdentity();
+    context->to = AMTransformMatrixMultiply(&scale, &rotation);
+    
+    AMBenchmarkMeasure("interpolation.transform3D.make", "pair", context->count / 16, AMBenchmarkTransformMake, &(AMBenchmarkContext){ .from = context->from, .to = context->to, .count = context->count / 16 });
+    
+    AMTransformInterpolationMake(&context->from, &context->to, &context->interpolation);
+    AMBenchmarkMeasure("interpolation.transform3D.evaluate", "sample", context->count, AMBenchmarkTransformEvaluate, context);
+    
+}
+
+static void AMBenchmarkInterpolationAccuracy(void) {
+    
+    srand(1);
+    
+    /* Round trip of scaled, skewed, rotated, translated and projected matrices. */
+    double error = 0.0;
+    for (int idx = 0 ; idx < 1000 ; idx++) {
+        
+        AMTransformMatrix scale = AMTransformMatrixIdentity();
+        for (int axis = 0 ; axis < 3 ; axis++)
+            scale.m[axis][axis] = .2 + 2.8 * rand() / (double)RAND_MAX;
+        
+        AMTransformMatrix skew = AMTransformMatrixIdentity();
+        skew.m[1][0] = rand() / (double)RAND_MAX - .5;
+        
+        AMTransformMatrix rotation = AMReferenceRotation(6.0 * rand() / (double)RAND_MAX - 3.0, rand() / (double)RAND_MAX - .5, rand() / (double)RAND_MAX - .5, 1.0);
+        rotation.m[3][0] = 200.0 * rand() / (double)RAND_MAX - 100.0;
+        rotation.m[3][1] = 200.0 * rand() / (double)RAND_MAX - 100.0;
+        
+        AMTransformMatrix perspective = AMTransformMatrixIdentity();
+        perspective.m[2][3] = -1.0 / 500.0;
+        
+        AMTransformMatrix matrix = AMTransformMatrixMultiply(&scale, &skew);
+        matrix = AMTransformMatrixMultiply(&matrix, &rotation);
+        matrix = AMTransformMatrixMultiply(&matrix, &perspective);
+        
+        AMTransformDecomposition decomposition;
+        if (!AMTransformDecompose(&matrix, &decomposition)) {
+            error = INFINITY;
+            break;
+        }
+        
+        AMTransformMatrix recomposed = AMTransformRecompose(&decomposition);
+        error = fmax(error, AMReferenceMatrixDistance(&matrix, &recomposed));
+        
+    }
+    AMBenchmarkCheck("interpolation.transform3D.roundtrip", error, 1e-8);
+    
+    /* Halfway between rotations about z is the rotation by half the angle - also through the shortest path. */
+    AMTransformMatrix from = AMTransformMatrixIdentity();
+    AMTransformMatrix to = AMReferenceRotation(1.2, 0.0, 0.0, 1.0);
+    to.m[3][0] = 50.0;
+    AMTransformMatrix halfway = AMReferenceRotation(.6, 0.0, 0.0, 1.0);
+    halfway.m[3][0] = 25.0;
+    
+    AMTransformInterpolation interpolation;
+    AMTransformInterpolationMake(&from, &to, &interpolation);
+    AMTransformMatrix evaluated = AMTransformInterpolationEvaluate(&interpolation, .5);
+    error = AMReferenceMatrixDistance(&evaluated, &halfway);
+    
+    evaluated = AMTransformInterpolationEvaluate(&interpolation, 1.0);
+    error = fmax(error, AMReferenceMatrixDistance(&evaluated, &to));
+    
+    from = AMReferenceRotation(-170.0 * AM_CURVE_PI / 180.0, 0.0, 0.0, 1.0);
+    to = AMReferenceRotation(170.0 * AM_CURVE_PI / 180.0, 0.0, 0.0, 1.0);
+    halfway = AMReferenceRotation(AM_CURVE_PI, 0.0, 0.0, 1.0);
+    AMTransformInterpolationMake(&from, &to, &interpolation);
+    evaluated = AMTransformInterpolationEvaluate(&interpolation, .5);
+    error = fmax(error, AMReferenceMatrixDistance(&evaluated, &halfway));
+    
+    AMBenchmarkCheck("interpolation.transform3D.slerp", error, 1e-9);
+    
+    /* Values are mixed from the endpoints - and a carried velocity vanishes at both ends. */
+    const double fromValue[4] = { 10.0, -20.0, 100.0, 50.0 };
+    const double toValue[4] = { 250.0, 40.0, 320.0, 480.0 };
+    const double carry[4] = { 30.0, -5.0, 12.0, 0.0 };
+    double delta[4];
+    for (int component = 0 ; component < 4 ; component++)
+        delta[component] = toValue[component] - fromValue[component];
+    
+    error = 0.0;
+    for (int idx = 0 ; idx <= 100 ; idx++) {
+        double position = idx / 100.0;
+        double value[4];
+        AMValueLerp(fromValue, delta, position, value, 4);
+        for (int component = 0 ; component < 4 ; component++)
+            error = fmax(error, fabs(value[component] - (fromValue[component] * (1.0 - position) + toValue[component] * position)));
+    }
+    
+    for (double progress = 0.0 ; progress <= 1.0 ; progress += 1.0) {
+        double value[4];
+        AMValueLerpCarrying(fromValue, delta, carry, progress, progress, value, 4);
+        for (int component = 0 ; component < 4 ; component++)
+            error = fmax(error, fabs(value[component] - (progress == 0.0 ? fromValue : toValue)[component]));
+    }
+    AMBenchmarkCheck("interpolation.values", error, 1e-12);
+    
+    /* The slope of the carry matches its difference quotient - one at the start and zero at the end. */
+    error = fmax(fabs(AMValueCarrySlope(0.0) - 1.0), fabs(AMValueCarrySlope(1.0)));
+    for (int idx = 1 ; idx < 100 ; idx++) {
+        double progress = idx / 100.0;
+        double quotient = (AMValueCarry(progress + 1e-6) - AMValueCarry(progress - 1e-6)) / 2e-6;
+        error = fmax(error, fabs(AMValueCarrySlope(progress) - quotient));
+    }
+    AMBenchmarkCheck("interpolation.carry", error, 1e-6);
+    
+}
+
+// MARK: - Colors
+
+static void AMBenchmarkColorInterpolate(AMBenchmarkContext *context) {
+    double sum = 0.0;
+    for (size_t idx = 0 ; idx < context->count ; idx++) {
+        double rgba[4];
+        AMColorInterpolate(context->colorSpace, context->fromColor, context->deltaColor, context->positions[idx], rgba);
+        sum += rgba[0];
+    }
+    sink += sum;
+}
+
+static void AMBenchmarkColors(AMBenchmarkContext *context) {
+    
+    static const struct { const char *name; AMColorSpace space; } spaces[] = {
+        { "sRGB", AMColorSpaceSRGB },
+        { "linearRGB", AMColorSpaceLinearRGB },
+        { "OKLab", AMColorSpaceOKLab }
+    };
+    
+    const double from[4] = { 1.0, .2, .1, 1.0 };
+    const double to[4] = { .1, .3, .9, .5 };
+    
+    for (size_t idx = 0 ; idx < sizeof(spaces) / sizeof(spaces[0]) ; idx++) {
+        
+        double toColor[4];
+        context->colorSpace = spaces[idx].space;
+        AMColorFromSRGB(context->colorSpace, from, context->fromColor);
+        AMColorFromSRGB(context->colorSpace, to, toColor);
+        for (int component = 0 ; component < 4 ; component++)
+            context->deltaColor[component] = toColor[component] - context->fromColor[component];
+        
+        char name[AM_BENCHMARK_NAME_LENGTH];
+        snprintf(name, sizeof(name), "color.%s.interpolate", spaces[idx].name);
+        AMBenchmarkMeasure(name, "sample", context->count, AMBenchmarkColorInterpolate, context);
+        
+    }
+    
+}
+
+static void AMBenchmarkColorsAccuracy(void) {
+    
+    /* Published OKLab coordinates of the sRGB primaries and white. */
+    static const double references[][2][3] = {
+        {{ 1.0, 1.0, 1.0 }, { 1.0, 0.0, 0.0 }},
+        {{ 1.0, 0.0, 0.0 }, { .627955, .224863, .125846 }},
+        {{ 0.0, 1.0, 0.0 }, { .866440, -.233888, .179498 }},
+        {{ 0.0, 0.0, 1.0 }, { .452014, -.032457, -.311528 }}
+    };
+    
+    double error = 0.0;
+    for (size_t idx = 0 ; idx < sizeof(references) / sizeof(references[0]) ; idx++) {
+        double rgba[4] = { references[idx][0][0], references[idx][0][1], references[idx][0][2], 1.0 };
+        double lab[4];
+        AMColorFromSRGB(AMColorSpaceOKLab, rgba, lab);
+        for (int component = 0 ; component < 3 ; component++)
+            error = fmax(error, fabs(lab[component] - references[idx][1][component]));
+    }
+    AMBenchmarkCheck("color.OKLab.reference", error, 1e-5);
+    
+    /* Round trips through every space - including extended sRGB outside zero and one. */
+    srand(1);
+    error = 0.0;
+    for (int idx = 0 ; idx < 1000 ; idx++) {
+        double rgba[4];
+        for (int component = 0 ; component < 4 ; component++)
+            rgba[component] = 1.4 * rand() / (double)RAND_MAX - .2;
+        for (AMColorSpace space = AMColorSpaceSRGB ; space <= AMColorSpaceOKLab ; space++) {
+            double color[4];
+            double roundtrip[4];
+            AMColorFromSRGB(space, rgba, color);
+            AMColorToSRGB(space, color, roundtrip);
+            for (int component = 0 ; component < 4 ; component++)
+                error = fmax(error, fabs(roundtrip[component] - rgba[component]));
+        }
+    }
+    AMBenchmarkCheck("color.roundtrip", error, 1e-5);
+    
+    /* The ends of an interpolation are the endpoints. */
+    const double from[4] = { 1.0, .2, .1, 1.0 };
+    const double to[4] = { .1, .3, .9, .5 };
+    error = 0.0;
+    for (AMColorSpace space = AMColorSpaceSRGB ; space <= AMColorSpaceOKLab ; space++) {
+        double fromColor[4];
+        double toColor[4];
+        double delta[4];
+        double start[4];
+        double end[4];
+        AMColorFromSRGB(space, from, fromColor);
+        AMColorFromSRGB(space, to, toColor);
+        for (int component = 0 ; component < 4 ; component++)
+            delta[component] = toColor[component] - fromColor[component];
+        AMColorInterpolate(space, fromColor, delta, 0.0, start);
+        AMColorInterpolate(space, fromColor, delta, 1.0, end);
+        for (int component = 0 ; component < 4 ; component++)
+            error = fmax(error, fmax(fabs(start[component] - from[component]), fabs(end[component] - to[component])));
+    }
+    AMBenchmarkCheck("color.endpoints", error, 1e-5);
+    
+}
+
+// MARK: - Buffers
+
+static void AMBenchmarkBufferLerpFloats(AMBenchmarkContext *context) {
+    AMBufferLerpFloats(context->fromBuffer, context->deltaBuffer, context->positions[context->count / 3], context->outputBuffer, context->count);
+    sink += ((float *)context->outputBuffer)[context->count / 2];
+}
+
+static void AMBenchmarkBufferLerpDoubles(AMBenchmarkContext *context) {
+    AMBufferLerpDoubles(context->fromBuffer, context->deltaBuffer, context->positions[context->count / 3], context->outputBuffer, context->count);
+    sink += ((double *)context->outputBuffer)[context->count / 2];
+}
+
+static void AMBenchmarkBufferDiffersDoubles(AMBenchmarkContext *context) {
+    /* No element differs by this much - so the whole buffer is compared. */
+    sink += AMBufferDiffersDoubles(context->fromBuffer, context->deltaBuffer, 100.0, context->count);
+}
+
+static void AMBenchmarkBuffers(AMBenchmarkContext *context) {
+    
+    /* A chart series of one element per sample - interpolated as a whole on every frame. */
+    float *floats = malloc(sizeof(float) * 3 * context->count);
+    double *doubles = malloc(sizeof(double) * 3 * context->count);
+    
+    for (size_t idx = 0 ; idx < context->count ; idx++) {
+        floats[idx] = (float)(doubles[idx] = sin((double)idx));
+        floats[context->count + idx] = (float)(doubles[context->count + idx] = cos((double)idx * 3.0) * 5.0);
+    }
+    
+    AMBenchmarkContext floatContext = { .positions = context->positions, .fromBuffer = floats, .deltaBuffer = floats + context->count, .outputBuffer = floats + 2 * context->count, .count = context->count };
+    AMBenchmarkMeasure("buffer.float.lerp", "element", context->count, AMBenchmarkBufferLerpFloats, &floatContext);
+    
+    AMBenchmarkContext doubleContext = { .positions = context->positions, .fromBuffer = doubles, .deltaBuffer = doubles + context->count, .outputBuffer = doubles + 2 * context->count, .count = context->count };
+    AMBenchmarkMeasure("buffer.double.lerp", "element", context->count, AMBenchmarkBufferLerpDoubles, &doubleContext);
+    AMBenchmarkMeasure("buffer.double.differs", "element", context->count, AMBenchmarkBufferDiffersDoubles, &doubleContext);
+    
+    free(floats);
+    free(doubles);
+    
+}
+
+static void AMBenchmarkBuffersAccuracy(void) {
+    
+    enum { capacity = 64 };
+    
+    float a[capacity + 1], b[capacity + 1], delta[capacity + 1], output[capacity + 1];
+    double A[capacity + 1], B[capacity + 1], Delta[capacity + 1], Output[capacity + 1];
+    
+    double lerpError = 0.0;
+    double mixError = 0.0;
+    double differsError = 0.0;
+    
+    /* Every count up to a few lanes - so partial lanes are covered - with an element past the end that must stay untouched. */
+    for (size_t count = 0 ; count < capacity ; count++) {
+        
+        for (size_t idx = 0 ; idx < count ; idx++) {
+            a[idx] = (float)(A[idx] = sin((double)idx));
+            b[idx] = (float)(B[idx] = cos((double)idx * 3.0) * 5.0);
+        }
+        
+        output[count] = delta[count] = Output[count] = Delta[count] = 42.0;
+        
+        AMBufferSubtractFloats(a, b, delta, count);
+        AMBufferSubtractDoubles(A, B, Delta, count);
+        
+        for (double position = -.25 ; position <= 1.25 ; position += .25) {
+            
+            AMBufferLerpFloats(a, delta, position, output, count);
+            AMBufferLerpDoubles(A, Delta, position, Output, count);
+            
+            for (size_t idx = 0 ; idx < count ; idx++) {
+                lerpError = fmax(lerpError, fabs(output[idx] - ((double)a[idx] + ((double)b[idx] - a[idx]) * position)));
+                lerpError = fmax(lerpError, fabs(Output[idx] - (A[idx] + (B[idx] - A[idx]) * position)));
+            }
+            
+            AMBufferMixDoubles(A, B, position, Output, count);
+            
+            for (size_t idx = 0 ; idx < count ; idx++)
+                mixError = fmax(mixError, fabs(Output[idx] - (A[idx] + (B[idx] - A[idx]) * position)));
+            
+        }
+        
+        /* Thresholds just below and above the largest difference. */
+        double difference = 0.0;
+        for (size_t idx = 0 ; idx < count ; idx++)
+            difference = fmax(difference, fabs(A[idx] - B[idx]));
+        
+        if (count > 0 && (!AMBufferDiffersDoubles(A, B, difference * .999, count) || !AMBufferDiffersFloats(a, b, difference * .999, count)))
+            differsError = fmax(differsError, difference);
+        if (AMBufferDiffersDoubles(A, B, difference * 1.001, count) || AMBufferDiffersFloats(a, b, difference * 1.001, count))
+            differsError = fmax(differsError, difference);
+        
+        if (output[count] != 42.0f || delta[count] != 42.0f || Output[count] != 42.0 || Delta[count] != 42.0)
+            lerpError = INFINITY;
+        
+    }
+    
+    AMBenchmarkCheck("buffer.lerp", lerpError, 1e-5);
+    AMBenchmarkCheck("buffer.mix", mixError, 1e-12);
+    AMBenchmarkCheck("buffer.differs", differsError, 0.0);
+    
+}
+
+// MARK: - Keyframes
+
+/* Samples and reduces keyframes the way curved animations do - at 60 keyframes per second with a tolerance of 0.001. */
+static size_t AMBenchmarkGenerateKeyframes(AMCurveFunction function, double duration, double *times, double *positions, bool *keep) {
+    
+    size_t frames = (size_t)fmax(ceil(duration * 60.0), 1.0);
+    size_t count = frames + 1;
+    
+    for (size_t idx = 0 ; idx < count ; idx++)
+        times[idx] = (double)idx / frames;
+    
+    AMCurveFunctionTransformBatch(function, times, positions, count);
+    AMCurveReduceSamples(times, positions, count, .001, keep);
+    
+    return count;
+    
+}
+
+/* Compacts the kept keyframes and samples their values - points, like a position animation. */
+static size_t AMBenchmarkSampleKeyframes(const AMBenchmarkContext *context, const double *times, const double *positions, const bool *keep, size_t count, double *keyTimes, double *values) {
+    
+    size_t kept = 0;
+    
+    for (size_t idx = 0 ; idx < count ; idx++) {
+        if (!keep[idx]) continue;
+        keyTimes[kept] = times[idx];
+        AMValueLerp(context->fromValue, context->deltaValue, positions[idx], values + kept * 2, 2);
+        kept++;
+    }
+    
+    return kept;
+    
+}
+
+static void AMBenchmarkKeyframesBody(AMBenchmarkContext *context) {
+    
+    /* Times, positions, key times and values of two components share one buffer, followed by the keep flags. */
+    size_t samples = context->count;
+    double *times = context->output;
+    double *positions = times + samples;
+    double *keyTimes = positions + samples;
+    double *values = keyTimes + samples;
+    bool *keep = (bool *)(values + 2 * samples);
+    
+    size_t kept = 0;
+    for (int idx = 0 ; idx < 16 ; idx++) {
+        size_t count = AMBenchmarkGenerateKeyframes(context->function, context->duration, times, positions, keep);
+        kept += AMBenchmarkSampleKeyframes(context, times, positions, keep, count, keyTimes, values);
+    }
+    sink += kept + values[0];
+    
+}
+
+static void AMBenchmarkKeyframes(void) {
+    
+    static const double durations[] = { .25, 1.0, 5.0, 30.0 };
+    static const AMCurveFunction functions[] = { AMCurveFunctionEaseInOutCubic, AMCurveFunctionEaseOutBounce };
+    
+    char name[AM_BENCHMARK_NAME_LENGTH];
+    
+    for (size_t function = 0 ; function < sizeof(functions) / sizeof(functions[0]) ; function++)
+        for (size_t duration = 0 ; duration < sizeof(durations) / sizeof(durations[0]) ; duration++) {
+        
+            size_t count = (size_t)ceil(durations[duration] * 60.0) + 1;
+            double *buffer = malloc(sizeof(double) * 5 * count + sizeof(bool) * count);
+        
+            AMBenchmarkContext context = { .function = functions[function], .duration = durations[duration], .output = buffer, .count = count, .fromValue = { 10.0, -20.0 }, .deltaValue = { 240.0, 60.0 } };
+        
+            snprintf(name, sizeof(name), "keyframes.%s.%gs", AMReferenceCurveNames[functions[function]], durations[duration]);
+            AMBenchmarkMeasure(name, "animation", 16, AMBenchmarkKeyframesBody, &context);
+        
+            free(buffer);
+        
+        }
+    
+}
+
+static void AMBenchmarkKeyframesAccuracy(void) {
+    
+    /* The kept keyframes must reproduce every sample within the tolerance. */
+    double error = 0.0;
+    
+    for (int function = AMCurveFunctionLinear ; function < AMCurveFunctionCount ; function++) {
+        
+        size_t count = 5 * 60 + 1;
+        double times[5 * 60 + 1];
+        double positions[5 * 60 + 1];
+        bool keep[5 * 60 + 1];
+        
+        AMBenchmarkGenerateKeyframes((AMCurveFunction)function, 5.0, times, positions, keep);
+        
+        size_t previous = 0;
+        for (size_t idx = 1 ; idx < count ; idx++) {
+            if (!keep[idx]) continue;
+            double slope = (positions[idx] - positions[previous]) / (times[idx] - times[previous]);
+            for (size_t sample = previous + 1 ; sample < idx ; sample++)
+                error = fmax(error, fabs(positions[sample] - (positions[previous] + slope * (times[sample] - times[previous]))));
+            previous = idx;
+        }
+        
+    }
+    
+    AMBenchmarkCheck("keyframes.reduction", error, .001);
+    
+    /* Colors outside of sRGB are reduced on their sRGB components - so a linear curve keeps the midpoints its color space bends through. */
+    const double from[4] = { 1.0, 0.0, 0.0, 1.0 };
+    const double to[4] = { 0.0, 0.0, 1.0, 1.0 };
+    error = 0.0;
+    
+    for (AMColorSpace space = AMColorSpaceLinearRGB ; space <= AMColorSpaceOKLab ; space++) {
+        
+        size_t count = 60 + 1;
+        double times[60 + 1];
+        double positions[60 + 1];
+        double rgba[4 * (60 + 1)];
+        bool keep[60 + 1];
+        double fromColor[4];
+        double toColor[4];
+        double delta[4];
+        
+        AMColorFromSRGB(space, from, fromColor);
+        AMColorFromSRGB(space, to, toColor);
+        for (int component = 0 ; component < 4 ; component++)
+            delta[component] = toColor[component] - fromColor[component];
+        
+        for (size_t idx = 0 ; idx < count ; idx++) {
+            times[idx] = (double)idx / (count - 1);
+            positions[idx] = AMLinear(times[idx]);
+            AMColorInterpolate(space, fromColor, delta, positions[idx], rgba + idx * 4);
+        }
+        
+        AMCurveReduceComponentSamples(times, rgba, 4, count, .001, keep);
+        
+        size_t previous = 0;
+        for (size_t idx = 1 ; idx < count ; idx++) {
+            if (!keep[idx]) continue;
+            for (size_t sample = previous + 1 ; sample < idx ; sample++)
+                for (int component = 0 ; component < 4 ; component++) {
+                    double slope = (rgba[idx * 4 + component] - rgba[previous * 4 + component]) / (times[idx] - times[previous]);
+                    error = fmax(error, fabs(rgba[sample * 4 + component] - (rgba[previous * 4 + component] + slope * (times[sample] - times[previous]))));
+                }
+            previous = idx;
+        }
+        
+    }
+    
+    AMBenchmarkCheck("keyframes.color.midpoints", error, .001);
+    
+}
+
+// MARK: - Groups
+
+/* Children of a group with delays in a shuffled or sorted order - a staggered sequence with overlapping durations. */
+static void AMBenchmarkGenerateTimeline(size_t count, bool sorted, double *delays, double *durations) {
+    
+    srand(1);
+    
+    for (size_t idx = 0 ; idx < count ; idx++) {
+        delays[idx] = .05 * (double)(idx / 2);
+        durations[idx] = .2 + rand() / (double)RAND_MAX;
+    }
+    
+    if (sorted)
+        return;
+    
+    for (size_t idx = count ; idx > 1 ; idx--) {
+        size_t other = (size_t)rand() % idx;
+        double delay = delays[idx - 1];
+        delays[idx - 1] = delays[other];
+        delays[other] = delay;
+    }
+    
+}
+
+static void AMBenchmarkGroupBuild(AMBenchmarkContext *context) {
+    AMTimelineExtent extent = AMTimelineBuild(context->delays, context->durations, context->count, context->order, context->order + context->count, context->startTimes, context->endTimes);
+    sink += extent.end;
+}
+
+static void AMBenchmarkGroupSeek(AMBenchmarkContext *context) {
+    /* Scrubbing forward through the timeline - one seek per frame. */
+    size_t changed = 0;
+    double last = NAN;
+    for (size_t idx = 0 ; idx < 64 ; idx++) {
+        double time = context->duration * (double)idx / 63.0;
+        AMTimelineSeek seek = AMTimelineSeekMake(context->startTimes, context->count, context->maximumDuration, last, time);
+        for (size_t child = seek.first ; child < seek.last ; child++)
+            changed += (context->endTimes[child] >= seek.low);
+        last = time;
+    }
+    sink += changed;
+}
+
+static void AMBenchmarkGroups(void) {
+    
+    static const size_t counts[] = { 16, 256, 4096 };
+    
+    char name[AM_BENCHMARK_NAME_LENGTH];
+    
+    for (size_t idx = 0 ; idx < sizeof(counts) / sizeof(counts[0]) ; idx++) {
+        
+        size_t count = counts[idx];
+        double *times = malloc(sizeof(double) * 4 * count);
+        size_t *order = malloc(sizeof(size_t) * 2 * count);
+        
+        AMBenchmarkContext context = { .delays = times, .durations = times + count, .startTimes = times + 2 * count, .endTimes = times + 3 * count, .order = order, .count = count };
+        
+        for (int sorted = 0 ; sorted <= 1 ; sorted++) {
+            AMBenchmarkGenerateTimeline(count, sorted, times, times + count);
+            snprintf(name, sizeof(name), "group.build.%zu%s", count, (sorted ? ".sorted" : ""));
+            AMBenchmarkMeasure(name, "child", count, AMBenchmarkGroupBuild, &context);
+        }
+        
+        AMTimelineExtent extent = AMTimelineBuild(context.delays, context.durations, count, order, order + count, context.startTimes, context.endTimes);
+        context.duration = extent.end;
+        context.maximumDuration = extent.maximumDuration;
+        
+        snprintf(name, sizeof(name), "group.seek.%zu", count);
+        AMBenchmarkMeasure(name, "seek", 64, AMBenchmarkGroupSeek, &context);
+        
+        free(times);
+        free(order);
+        
+    }
+    
+}
+
+static void AMBenchmarkGroupsAccuracy(void) {
+    
+    size_t count = 1000;
+    double times[4 * 1000];
+    size_t order[2 * 1000];
+    double *delays = times, *durations = times + count, *startTimes = times + 2 * count, *endTimes = times + 3 * count;
+    
+    AMBenchmarkGenerateTimeline(count, false, delays, durations);
+    AMTimelineExtent extent = AMTimelineBuild(delays, durations, count, order, order + count, startTimes, endTimes);
+    
+    /* Children are ordered by start time - and those starting together in the order they were added. */
+    double error = 0.0;
+    for (size_t idx = 1 ; idx < count ; idx++)
+        if (startTimes[idx - 1] > startTimes[idx] || (startTimes[idx - 1] == startTimes[idx] && order[idx - 1] > order[idx]))
+            error++;
+    AMBenchmarkCheck("group.sort", error, 0.0);
+    
+    /* A seek covers every child active between the times - and splits them at the new time. */
+    srand(2);
+    error = 0.0;
+    double last = NAN;
+    for (int seek = 0 ; seek < 1000 ; seek++) {
+        
+        double time = (extent.end + 1.0) * rand() / (double)RAND_MAX - .5;
+        AMTimelineSeek range = AMTimelineSeekMake(startTimes, count, extent.maximumDuration, last, time);
+        double low = (isnan(last) ? -INFINITY : fmin(last, time));
+        double high = (isnan(last) ? INFINITY : fmax(last, time));
+        
+        for (size_t idx = 0 ; idx < count ; idx++) {
+            bool active = (endTimes[idx] >= low && startTimes[idx] <= high);
+            bool covered = (idx >= range.first && idx < range.last);
+            bool started = (startTimes[idx] <= time);
+            if ((active && !covered) || (covered && started != (idx < range.started)))
+                error++;
+        }
+        
+        last = time;
+        
+    }
+    AMBenchmarkCheck("group.seek", error, 0.0);
+    
+}
+
+// MARK: - Baseline
+
+static void AMBenchmarkLoadBaseline(const char *path) {
+    
+    FILE *file = fopen(path, "r");
+    if (!file) {
+        fprintf(stderr, "Could not open baseline %s.\n", path);
+        return;
+    }
+    
+    /* Baselines are earlier output - one result per line. */
+    char line[512];
+    while (fgets(line, sizeof(line), file)) {
+        
+        char name[AM_BENCHMARK_NAME_LENGTH];
+        double nanoseconds;
+        const char *field = strstr(line, "\"ns\": ");
+        
+        if (sscanf(line, " {\"name\": \"%63[^\"]\"", name) != 1 || !field || sscanf(field, "\"ns\": %lf", &nanoseconds) != 1)
+            continue;
+        
+        for (size_t idx = 0 ; idx < resultCount ; idx++)
+            if (strcmp(results[idx].name, name) == 0)
+                results[idx].baseline = nanoseconds;
+        
+    }
+    
+    fclose(file);
+    
+}
+
+// MARK: - Reporting
+
+static int AMBenchmarkReport(double regression) {
+    
+    int passed = 1;
+    
+    printf("{\n  \"results\": [\n");
+    for (size_t idx = 0 ; idx < resultCount ; idx++) {
+        const AMBenchmarkResult *result = &results[idx];
+        printf("    {\"name\": \"%s\", \"per\": \"%s\", \"ns\": %.3f", result->name, result->per, result->nanoseconds);
+        if (!isnan(result->baseline)) {
+            double change = result->nanoseconds / result->baseline - 1.0;
+            printf(", \"baseline\": %.3f, \"change\": %.3f", result->baseline, change);
+            if (regression > 0.0 && change > regression) {
+                fprintf(stderr, "%s regressed by %.1f%%.\n", result->name, change * 100.0);
+                passed = 0;
+            }
+        }
+        printf("}%s\n", (idx + 1 < resultCount ? "," : ""));
+    }
+    
+    printf("  ],\n  \"accuracy\": [\n");
+    for (size_t idx = 0 ; idx < accuracyCount ; idx++) {
+        const AMBenchmarkAccuracy *accuracy = &accuracies[idx];
+        int accurate = (accuracy->error <= accuracy->tolerance);
+        if (!accurate) {
+            fprintf(stderr, "%s is off by %g - more than %g.\n", accuracy->name, accuracy->error, accuracy->tolerance);
+            passed = 0;
+        }
+        printf("    {\"name\": \"%s\", \"error\": %.3g, \"tolerance\": %.3g, \"passed\": %s}%s\n", accuracy->name, accuracy->error, accuracy->tolerance, (accurate ? "true" : "false"), (idx + 1 < accuracyCount ? "," : ""));
+    }
+    
+    printf("  ],\n  \"passed\": %s\n}\n", (passed ? "true" : "false"));
+    
+    return passed;
+    
+}
+
+int main(int argc, char *argv[]) {
+    
+    const char *baseline = NULL;
+    double regression = 0.0;
+    int accuracyOnly = 0;
+    
+    int option;
+    while ((option = getopt(argc, argv, "b:r:a")) != -1) {
+        switch (option) {
+            case 'b':
+                baseline = optarg;
+                break;
+            case 'r':
+                regression = atof(optarg);
+                break;
+            case 'a':
+                accuracyOnly = 1;
+                break;
+            default:
+                fprintf(stderr, "Usage: %s [-b baseline.json] [-r regression] [-a]\n", argv[0]);
+                return 2;
+        }
+    }
+    
+    AMBenchmarkCurvesAccuracy();
+    AMBenchmarkDerivativesAccuracy();
+    AMBenchmarkInterpolationAccuracy();
+    AMBenchmarkColorsAccuracy();
+    AMBenchmarkBuffersAccuracy();
+    AMBenchmarkKeyframesAccuracy();
+    AMBenchmarkGroupsAccuracy();
+    
+    if (!accuracyOnly) {
+        
+        double *positions = malloc(sizeof(double) * AM_BENCHMARK_SAMPLES);
+        double *output = malloc(sizeof(double) * AM_BENCHMARK_SAMPLES);
+        
+        for (size_t idx = 0 ; idx < AM_BENCHMARK_SAMPLES ; idx++)
+            positions[idx] = (double)idx / (AM_BENCHMARK_SAMPLES - 1);
+        
+        AMBenchmarkContext context = { .positions = positions, .output = output, .count = AM_BENCHMARK_SAMPLES };
+        
+        AMBenchmarkCurves(&context);
+        AMBenchmarkInterpolation(&context);
+        AMBenchmarkColors(&context);
+        AMBenchmarkBuffers(&context);
+        AMBenchmarkKeyframes();
+        AMBenchmarkGroups();
+        
+        free(positions);
+        free(output);
+        
+        if (baseline)
+            AMBenchmarkLoadBaseline(baseline);
+        
+    }
+    
+    return (AMBenchmarkReport(regression) ? 0 : 1);
+    
+}